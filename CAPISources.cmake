@@ -30,3 +30,10 @@ set(THREADS_PREFER_PTHREAD_FLAG TRUE)
 find_package(Threads REQUIRED)
 
 file(GLOB C_API_SOURCES ${SRC_DIR}/*.cpp)
+
+if (UNIX)
+  # the vectorized kernels must perform the same arithmetic as the scalar
+  # kernels, don't allow the compiler to fuse their multiplies and adds
+  set_source_files_properties(${SRC_DIR}/SimdKernels.cpp
+    ${SRC_DIR}/ReductionKernels.cpp PROPERTIES COMPILE_FLAGS -ffp-contract=off)
+endif (UNIX)
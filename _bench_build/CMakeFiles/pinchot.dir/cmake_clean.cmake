@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libpinchot.pdb"
+  "libpinchot.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pinchot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
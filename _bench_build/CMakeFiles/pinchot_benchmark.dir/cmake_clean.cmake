@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pinchot_benchmark.dir/benchmark/src/pinchot_benchmark.cpp.o"
+  "CMakeFiles/pinchot_benchmark.dir/benchmark/src/pinchot_benchmark.cpp.o.d"
+  "pinchot_benchmark"
+  "pinchot_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pinchot_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
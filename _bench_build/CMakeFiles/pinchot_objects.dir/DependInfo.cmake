@@ -0,0 +1,55 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/AlignmentParams.cpp" "CMakeFiles/pinchot_objects.dir/src/AlignmentParams.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/AlignmentParams.cpp.o.d"
+  "/root/repo/src/BroadcastConnectMessage.cpp" "CMakeFiles/pinchot_objects.dir/src/BroadcastConnectMessage.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/BroadcastConnectMessage.cpp.o.d"
+  "/root/repo/src/ClockModel.cpp" "CMakeFiles/pinchot_objects.dir/src/ClockModel.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ClockModel.cpp.o.d"
+  "/root/repo/src/CrossSection.cpp" "CMakeFiles/pinchot_objects.dir/src/CrossSection.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/CrossSection.cpp.o.d"
+  "/root/repo/src/DataFormats.cpp" "CMakeFiles/pinchot_objects.dir/src/DataFormats.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/DataFormats.cpp.o.d"
+  "/root/repo/src/DataPacket.cpp" "CMakeFiles/pinchot_objects.dir/src/DataPacket.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/DataPacket.cpp.o.d"
+  "/root/repo/src/DisconnectMessage.cpp" "CMakeFiles/pinchot_objects.dir/src/DisconnectMessage.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/DisconnectMessage.cpp.o.d"
+  "/root/repo/src/EncoderKinematics.cpp" "CMakeFiles/pinchot_objects.dir/src/EncoderKinematics.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/EncoderKinematics.cpp.o.d"
+  "/root/repo/src/LatestProfile.cpp" "CMakeFiles/pinchot_objects.dir/src/LatestProfile.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/LatestProfile.cpp.o.d"
+  "/root/repo/src/LineFitting.cpp" "CMakeFiles/pinchot_objects.dir/src/LineFitting.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/LineFitting.cpp.o.d"
+  "/root/repo/src/MappingTable.cpp" "CMakeFiles/pinchot_objects.dir/src/MappingTable.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/MappingTable.cpp.o.d"
+  "/root/repo/src/MissingColumns.cpp" "CMakeFiles/pinchot_objects.dir/src/MissingColumns.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/MissingColumns.cpp.o.d"
+  "/root/repo/src/NetworkInterface.cpp" "CMakeFiles/pinchot_objects.dir/src/NetworkInterface.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/NetworkInterface.cpp.o.d"
+  "/root/repo/src/PresenceDetector.cpp" "CMakeFiles/pinchot_objects.dir/src/PresenceDetector.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/PresenceDetector.cpp.o.d"
+  "/root/repo/src/Profile.cpp" "CMakeFiles/pinchot_objects.dir/src/Profile.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/Profile.cpp.o.d"
+  "/root/repo/src/ProfileHistory.cpp" "CMakeFiles/pinchot_objects.dir/src/ProfileHistory.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ProfileHistory.cpp.o.d"
+  "/root/repo/src/ProfileResampler.cpp" "CMakeFiles/pinchot_objects.dir/src/ProfileResampler.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ProfileResampler.cpp.o.d"
+  "/root/repo/src/ProfileStitcher.cpp" "CMakeFiles/pinchot_objects.dir/src/ProfileStitcher.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ProfileStitcher.cpp.o.d"
+  "/root/repo/src/ReductionKernels.cpp" "CMakeFiles/pinchot_objects.dir/src/ReductionKernels.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ReductionKernels.cpp.o.d"
+  "/root/repo/src/ScanHead.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanHead.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanHead.cpp.o.d"
+  "/root/repo/src/ScanHeadConfiguration.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanHeadConfiguration.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanHeadConfiguration.cpp.o.d"
+  "/root/repo/src/ScanHeadReceiver.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanHeadReceiver.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanHeadReceiver.cpp.o.d"
+  "/root/repo/src/ScanHeadSender.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanHeadSender.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanHeadSender.cpp.o.d"
+  "/root/repo/src/ScanHeadShared.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanHeadShared.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanHeadShared.cpp.o.d"
+  "/root/repo/src/ScanManager.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanManager.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanManager.cpp.o.d"
+  "/root/repo/src/ScanRequestMessage.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanRequestMessage.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanRequestMessage.cpp.o.d"
+  "/root/repo/src/ScanWindow.cpp" "CMakeFiles/pinchot_objects.dir/src/ScanWindow.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ScanWindow.cpp.o.d"
+  "/root/repo/src/SetWindowMessage.cpp" "CMakeFiles/pinchot_objects.dir/src/SetWindowMessage.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/SetWindowMessage.cpp.o.d"
+  "/root/repo/src/SimdKernels.cpp" "CMakeFiles/pinchot_objects.dir/src/SimdKernels.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/SimdKernels.cpp.o.d"
+  "/root/repo/src/StatusMessage.cpp" "CMakeFiles/pinchot_objects.dir/src/StatusMessage.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/StatusMessage.cpp.o.d"
+  "/root/repo/src/SystemEvents.cpp" "CMakeFiles/pinchot_objects.dir/src/SystemEvents.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/SystemEvents.cpp.o.d"
+  "/root/repo/src/TemporalFilter.cpp" "CMakeFiles/pinchot_objects.dir/src/TemporalFilter.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/TemporalFilter.cpp.o.d"
+  "/root/repo/src/ValidityHeatmap.cpp" "CMakeFiles/pinchot_objects.dir/src/ValidityHeatmap.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/ValidityHeatmap.cpp.o.d"
+  "/root/repo/src/VersionCompatibilityException.cpp" "CMakeFiles/pinchot_objects.dir/src/VersionCompatibilityException.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/VersionCompatibilityException.cpp.o.d"
+  "/root/repo/src/VersionParser.cpp" "CMakeFiles/pinchot_objects.dir/src/VersionParser.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/VersionParser.cpp.o.d"
+  "/root/repo/src/WindowOptimizer.cpp" "CMakeFiles/pinchot_objects.dir/src/WindowOptimizer.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/WindowOptimizer.cpp.o.d"
+  "/root/repo/src/joescan_pinchot.cpp" "CMakeFiles/pinchot_objects.dir/src/joescan_pinchot.cpp.o" "gcc" "CMakeFiles/pinchot_objects.dir/src/joescan_pinchot.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,81 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pinchot_objects.dir/src/AlignmentParams.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/AlignmentParams.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/BroadcastConnectMessage.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/BroadcastConnectMessage.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ClockModel.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ClockModel.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/CrossSection.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/CrossSection.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/DataFormats.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/DataFormats.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/DataPacket.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/DataPacket.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/DisconnectMessage.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/DisconnectMessage.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/EncoderKinematics.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/EncoderKinematics.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/LatestProfile.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/LatestProfile.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/LineFitting.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/LineFitting.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/MappingTable.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/MappingTable.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/MissingColumns.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/MissingColumns.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/NetworkInterface.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/NetworkInterface.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/PresenceDetector.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/PresenceDetector.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/Profile.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/Profile.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileHistory.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileHistory.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileResampler.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileResampler.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileStitcher.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ProfileStitcher.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ReductionKernels.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ReductionKernels.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHead.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHead.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadConfiguration.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadConfiguration.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadReceiver.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadReceiver.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadSender.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadSender.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadShared.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanHeadShared.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanManager.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanManager.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanRequestMessage.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanRequestMessage.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ScanWindow.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ScanWindow.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/SetWindowMessage.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/SetWindowMessage.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/SimdKernels.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/SimdKernels.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/StatusMessage.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/StatusMessage.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/SystemEvents.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/SystemEvents.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/TemporalFilter.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/TemporalFilter.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/ValidityHeatmap.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/ValidityHeatmap.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/VersionCompatibilityException.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/VersionCompatibilityException.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/VersionParser.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/VersionParser.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/WindowOptimizer.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/WindowOptimizer.cpp.o.d"
+  "CMakeFiles/pinchot_objects.dir/src/joescan_pinchot.cpp.o"
+  "CMakeFiles/pinchot_objects.dir/src/joescan_pinchot.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pinchot_objects.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,407 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+/**
+ * @file pinchot_benchmark.cpp
+ * @brief Benchmark of the profile decode and copy-out paths of the API.
+ *
+ * No scan head is required to run this application. Instead, it synthesizes
+ * the datagrams a JS-50 sends while scanning a log and feeds them through the
+ * API in three ways:
+ *
+ * - `decode`: Datagrams are parsed and decoded into profiles in process,
+ *   once with every SIMD kernel variant supported by the CPU.
+ * - `copy-out`: Decoded profiles are copied out into `jsProfile` and
+ *   `jsRawProfile` structs the same way `jsScanHeadGetProfiles` and
+ *   `jsScanHeadGetRawProfiles` do.
+ * - `end-to-end`: Datagrams are sent over the loopback interface to a live
+ *   scan head receiver, the resulting profiles are read back and copied out.
+ *
+ * Besides comparing builds, this is the training workload used when building
+ * the API with profile guided optimization; see `scripts/pgo-benchmark.py`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataPacket.hpp"
+#include "NetworkInterface.hpp"
+#include "Profile.hpp"
+#include "ProfileStitcher.hpp"
+#include "ScanHeadReceiver.hpp"
+#include "ScanHeadShared.hpp"
+#include "SimdKernels.hpp"
+#include "SystemEvents.hpp"
+#include "joescan_pinchot.h"
+
+using namespace joescan;
+
+// A JS-50 splits a full resolution X/Y & brightness profile over six
+// datagrams in order to fit each within a single ethernet frame.
+static const uint32_t kNumParts = 6;
+static const uint32_t kNumColumns = JS_PROFILE_DATA_LEN;
+static const uint32_t kHeaderSize = 36;
+// Radius of the simulated log in 1/1000 inches.
+static const double kLogRadius = 6000.0;
+
+static bool csv = false;
+
+static void write16(uint8_t *dst, uint16_t v)
+{
+  dst[0] = static_cast<uint8_t>(v >> 8);
+  dst[1] = static_cast<uint8_t>(v);
+}
+
+static void write32(uint8_t *dst, uint32_t v)
+{
+  write16(dst, static_cast<uint16_t>(v >> 16));
+  write16(dst + 2, static_cast<uint16_t>(v));
+}
+
+static void write64(uint8_t *dst, uint64_t v)
+{
+  write32(dst, static_cast<uint32_t>(v >> 32));
+  write32(dst + 4, static_cast<uint32_t>(v));
+}
+
+/**
+ * @brief Synthesizes the datagrams of a single X/Y & brightness profile of a
+ * log passing through the scan zone, laid out the same way the scan server
+ * lays them out.
+ *
+ * @param timestamp The camera timestamp of the profile.
+ * @param encoder The encoder value of the profile.
+ * @return The datagrams making up the profile.
+ */
+static std::vector<Datagram> build_profile(uint64_t timestamp, int64_t encoder)
+{
+  std::vector<Datagram> datagrams;
+  const DataType contents = DataType::Brightness | DataType::XYData;
+  // vary the position of the log between profiles so the data isn't constant
+  const double center = 500.0 * std::sin(static_cast<double>(timestamp) * 1e-7);
+
+  for (uint32_t part = 0; part < kNumParts; part++) {
+    uint32_t num_vals = kNumColumns / kNumParts;
+    if ((kNumColumns % kNumParts) > part) {
+      num_vals++;
+    }
+
+    const uint32_t payload = num_vals * (GetSizeFor(DataType::Brightness) +
+                                         GetSizeFor(DataType::XYData));
+    // header, steps for both data types, a single encoder, then the data
+    Datagram d(kHeaderSize + 2 * 2 + 8 + payload, 0);
+    uint8_t *p = d.data();
+
+    write16(&p[0], kDataMagic);
+    write16(&p[2], 100);
+    p[4] = 0;
+    p[5] = JS_CAMERA_0;
+    p[6] = JS_LASER_0;
+    write64(&p[8], timestamp);
+    write16(&p[16], 100);
+    write16(&p[18], contents);
+    write16(&p[20], static_cast<uint16_t>(payload));
+    p[22] = 1;
+    write32(&p[24], part);
+    write32(&p[28], kNumParts);
+    write16(&p[32], 0);
+    write16(&p[34], kNumColumns - 1);
+    // steps, ordered by data type bit
+    write16(&p[36], 1);
+    write16(&p[38], 1);
+    write64(&p[40], static_cast<uint64_t>(encoder));
+
+    uint8_t *brightness = &p[48];
+    uint8_t *xy = &p[48 + num_vals];
+    for (uint32_t j = 0; j < num_vals; j++) {
+      const uint32_t col = j * kNumParts + part;
+      const double x = (static_cast<double>(col) - kNumColumns / 2.0) * 10.0;
+      const double dx = x - center;
+      int16_t x_raw = JS_PROFILE_DATA_INVALID_XY;
+      int16_t y_raw = JS_PROFILE_DATA_INVALID_XY;
+      uint8_t b = JS_PROFILE_DATA_INVALID_BRIGHTNESS;
+
+      // leave occasional holes in the surface like bark or knots would
+      if ((std::fabs(dx) < kLogRadius) && (0 != (col + timestamp) % 37)) {
+        x_raw = static_cast<int16_t>(x);
+        y_raw = static_cast<int16_t>(
+          std::sqrt(kLogRadius * kLogRadius - dx * dx) - kLogRadius / 2.0);
+        b = static_cast<uint8_t>(40 + (col * 7 + timestamp) % 200);
+      }
+
+      brightness[j] = b;
+      write16(&xy[j * 4], static_cast<uint16_t>(x_raw));
+      write16(&xy[j * 4 + 2], static_cast<uint16_t>(y_raw));
+    }
+
+    datagrams.push_back(d);
+  }
+
+  return datagrams;
+}
+
+/**
+ * @brief Decodes the datagrams of a profile the same way the scan head
+ * receiver does, using the given kernels.
+ */
+static std::shared_ptr<Profile> decode_profile(std::vector<Datagram> &datagrams,
+                                               const SimdKernels &kernels,
+                                               const AlignmentParams &alignment)
+{
+  const CameraToMillCoefficients c = alignment.GetCameraToMillCoefficients();
+  std::shared_ptr<Profile> profile = nullptr;
+
+  for (auto &d : datagrams) {
+    DataPacket packet(d.data(), static_cast<uint32_t>(d.size()), 0);
+    uint32_t len = 0;
+    uint8_t *raw_bytes = packet.GetRawBytes(&len);
+    const uint32_t total_packets = packet.GetNumParts();
+    const uint32_t current_packet = packet.GetPartNum();
+
+    if (nullptr == profile) {
+      profile = std::make_shared<Profile>(packet.GetContents());
+      profile->SetScanHead(packet.GetScanHeadId());
+      profile->SetCamera(packet.GetCamera());
+      profile->SetLaser(packet.GetLaser());
+      profile->SetTimestamp(packet.GetTimeStamp());
+      profile->SetEncoderValues(packet.GetEncoderValues());
+    }
+
+    FragmentLayout layout = packet.GetFragmentLayout(DataType::Brightness);
+    uint32_t idx = packet.GetStartColumn() + current_packet * layout.step;
+    uint32_t stride = total_packets * layout.step;
+    profile->AddValidBrightness(kernels.decode_brightness(
+      &raw_bytes[layout.offset], layout.num_vals, profile->GetDataPointer(),
+      idx, stride, profile->GetDataLength()));
+
+    layout = packet.GetFragmentLayout(DataType::XYData);
+    idx = packet.GetStartColumn() + current_packet * layout.step;
+    stride = total_packets * layout.step;
+    profile->AddValidGeometry(kernels.decode_xy(
+      &raw_bytes[layout.offset], layout.num_vals, c, profile->GetDataPointer(),
+      nullptr, nullptr, idx, stride, profile->GetDataLength(),
+      profile->GetSummaryPointer()));
+  }
+
+  profile->SetUDPPacketInfo(kNumParts, kNumParts);
+
+  return profile;
+}
+
+static void report(const std::string &test, const std::string &variant,
+                   double ns_per_profile)
+{
+  if (csv) {
+    std::cout << test << "," << variant << "," << std::fixed
+              << std::setprecision(1) << ns_per_profile << std::endl;
+  } else {
+    std::cout << std::left << std::setw(12) << test << std::setw(10)
+              << variant << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << ns_per_profile << " ns/profile" << std::endl;
+  }
+}
+
+static double elapsed_ns(std::chrono::steady_clock::time_point t0)
+{
+  auto t1 = std::chrono::steady_clock::now();
+  return static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t num_profiles = 20000;
+  bool skip_network = false;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if ("--csv" == arg) {
+      csv = true;
+    } else if ("--no-network" == arg) {
+      skip_network = true;
+    } else if (("--profiles" == arg) && ((i + 1) < argc)) {
+      num_profiles = strtoul(argv[++i], nullptr, 0);
+    } else {
+      std::cout << "Usage: " << argv[0]
+                << " [--profiles N] [--no-network] [--csv]" << std::endl;
+      return 1;
+    }
+  }
+
+  if (0 == num_profiles) {
+    num_profiles = 1;
+  }
+
+  // A modest amount of unique profiles, cycled through, keeps the working set
+  // similar to live scanning without timing the synthesis itself.
+  const uint32_t kUniqueProfiles = 64;
+  std::vector<std::vector<Datagram>> profiles;
+  for (uint32_t n = 0; n < kUniqueProfiles; n++) {
+    profiles.push_back(build_profile(1000000ULL * (n + 1), n * 100));
+  }
+
+  const AlignmentParams alignment(1.5, 12.0, -3.0, false);
+  const SimdKernels &selected = GetSimdKernels();
+  int64_t checksum = 0;
+  int r = 0;
+
+  if (!csv) {
+    std::cout << "selected SIMD variant: " << selected.name << std::endl;
+  }
+
+  // decode, for every variant the CPU supports
+  std::shared_ptr<Profile> reference = nullptr;
+  const jsSimdVariant variants[] = {JS_SIMD_VARIANT_SCALAR,
+                                    JS_SIMD_VARIANT_SSE42, JS_SIMD_VARIANT_AVX2,
+                                    JS_SIMD_VARIANT_AVX512};
+  for (auto v : variants) {
+    const SimdKernels *kernels = GetSimdKernels(v);
+    if (nullptr == kernels) {
+      continue;
+    }
+
+    // all variants must produce identical output, check before timing
+    auto p = decode_profile(profiles[0], *kernels, alignment);
+    if (nullptr == reference) {
+      reference = p;
+    } else if (0 != memcmp(p->GetDataPointer(), reference->GetDataPointer(),
+                           sizeof(jsProfileData) * p->GetDataLength())) {
+      std::cout << "ERROR: " << kernels->name << " output differs from "
+                << "scalar output" << std::endl;
+      r = 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < num_profiles; n++) {
+      p = decode_profile(profiles[n % kUniqueProfiles], *kernels, alignment);
+      checksum += p->GetNumberValidGeometry();
+    }
+    report("decode", kernels->name, elapsed_ns(t0) / num_profiles);
+  }
+
+  // copy-out, using the selected variant as the API does
+  {
+    std::vector<std::shared_ptr<Profile>> decoded;
+    for (uint32_t n = 0; n < kUniqueProfiles; n++) {
+      decoded.push_back(decode_profile(profiles[n], selected, alignment));
+    }
+
+    std::unique_ptr<jsProfile> out(new jsProfile);
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < num_profiles; n++) {
+      const Profile &p = *decoded[n % kUniqueProfiles];
+      out->data_len = selected.copy_valid(
+        p.GetDataPointer(), p.GetDataLength(), 1, out->data);
+      checksum += out->data[out->data_len / 2].y;
+    }
+    report("copy-out", selected.name, elapsed_ns(t0) / num_profiles);
+
+    std::unique_ptr<jsRawProfile> raw(new jsRawProfile);
+    t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < num_profiles; n++) {
+      const Profile &p = *decoded[n % kUniqueProfiles];
+      memcpy(raw->data, p.GetDataPointer(),
+             sizeof(jsProfileData) * p.GetDataLength());
+      checksum += raw->data[n % JS_RAW_PROFILE_DATA_LEN].x;
+    }
+    report("copy-raw", "memcpy", elapsed_ns(t0) / num_profiles);
+  }
+
+  // end-to-end, through a live receiver over the loopback interface
+  if (!skip_network) {
+    NetworkInterface::InitSystem();
+
+    ProfileStitcher stitcher;
+    SystemEvents events;
+    ScanHeadShared shared("0", 0, stitcher, events);
+    ScanHeadConfiguration config;
+    config.SetAlignment(JS_CAMERA_0, alignment);
+    shared.SetConfig(config);
+
+    ScanHeadReceiver receiver(shared);
+    receiver.Start();
+
+    net_iface iface = NetworkInterface::InitSendSocket(INADDR_ANY, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(receiver.GetPort()));
+
+    // send in small batches so the socket buffer never overflows
+    const uint32_t kBatchSize = 16;
+    std::unique_ptr<jsProfile> out(new jsProfile);
+    uint32_t received = 0;
+    uint64_t timestamp = 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < num_profiles; n += kBatchSize) {
+      const uint32_t batch = std::min(kBatchSize, num_profiles - n);
+      for (uint32_t m = 0; m < batch; m++) {
+        auto &datagrams = profiles[(n + m) % kUniqueProfiles];
+        // every profile needs a unique timestamp for the receiver to tell
+        // them apart
+        timestamp++;
+        for (auto &d : datagrams) {
+          write64(&d[8], timestamp);
+          sendto(iface.sockfd, reinterpret_cast<const char *>(d.data()),
+                 static_cast<int>(d.size()), 0,
+                 reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        }
+      }
+
+      uint32_t pending = batch;
+      auto last = std::chrono::steady_clock::now();
+      while (0 < pending) {
+        auto popped = shared.PopProfiles(pending);
+        if (popped.empty()) {
+          // give up on a batch if datagrams were dropped
+          if (std::chrono::milliseconds(100) <
+              (std::chrono::steady_clock::now() - last)) {
+            break;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+
+        last = std::chrono::steady_clock::now();
+        for (auto &p : popped) {
+          out->data_len = selected.copy_valid(
+            p->GetDataPointer(), p->GetDataLength(), 1, out->data);
+          checksum += out->data_len;
+        }
+        pending -= static_cast<uint32_t>(popped.size());
+        received += static_cast<uint32_t>(popped.size());
+      }
+    }
+    double ns = elapsed_ns(t0);
+
+    receiver.Shutdown();
+    NetworkInterface::CloseSocket(iface.sockfd);
+
+    report("end-to-end", selected.name, ns / num_profiles);
+    if (!csv) {
+      std::cout << "received " << received << " of " << num_profiles
+                << " profiles" << std::endl;
+    }
+  }
+
+  if (!csv) {
+    std::cout << "checksum " << checksum << std::endl;
+  }
+
+  return r;
+}
@@ -30,8 +30,9 @@ static uint64_t received_profiles = 0;
 
 /**
  * @brief This function is a small utility function used to explore profile
- * data. In this case, it will iterate over the valid profile data and
- * find the highest measurement in the Y axis.
+ * data. In this case, it will find the highest measurement in the Y axis.
+ * Rather than iterating over every point of every profile, it makes use of the
+ * summary that the API computes for each profile as it is received.
  *
  * @param profiles Array of profiles from a single scan head.
  * @param num_profiles Total number of profiles contained in array.
@@ -44,12 +45,11 @@ jsProfileData find_scan_profile_highest_point(jsProfile *profiles,
   jsProfileData p = {0, 0, 0};
 
   for (unsigned int i = 0; i < num_profiles; i++) {
-    for (unsigned int j = 0; j < profiles[i].data_len; j++) {
-      if (profiles[i].data[j].y > p.y) {
-        p.brightness = profiles[i].data[j].brightness;
-        p.x = profiles[i].data[j].x;
-        p.y = profiles[i].data[j].y;
-      }
+    const jsProfileSummary &summary = profiles[i].summary;
+    if ((0 < summary.num_valid) && (summary.highest_y > p.y)) {
+      p.brightness = summary.highest_brightness;
+      p.x = summary.highest_x;
+      p.y = summary.highest_y;
     }
   }
 
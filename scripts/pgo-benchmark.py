@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+
+# Builds the API twice, once as a plain release build and once with link time
+# optimization and profile guided optimization, then compares the two using
+# the decode & copy-out benchmark.
+#
+# The profile guided build is done in three steps within the same build
+# directory, as the recorded profile data is keyed to the object files:
+#   1. Build an instrumented library & benchmark (PINCHOT_PGO=GENERATE).
+#   2. Run the benchmark to train, recording the profile data.
+#   3. Rebuild using the recorded profile data (PINCHOT_PGO=USE).
+#
+# EX: ./pgo-benchmark.py --build-dir ../build-pgo
+
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+
+
+def run_command(cmd, capture=False):
+    print('>', ' '.join(cmd), flush=True)
+    if capture:
+        return subprocess.check_output(cmd).decode("utf-8")
+    subprocess.check_call(cmd)
+    return ""
+
+
+def configure(build_dir, options):
+    cmd = ["cmake", "-S", ROOT_DIR, "-B", build_dir,
+           "-DPINCHOT_BUILD_BENCHMARK=ON"]
+    cmd += ["-D{}={}".format(k, v) for k, v in options.items()]
+    run_command(cmd)
+
+
+def build(build_dir, jobs, clean=False):
+    cmd = ["cmake", "--build", build_dir, "--config", "Release",
+           "-j", str(jobs)]
+    if clean:
+        cmd.append("--clean-first")
+    run_command(cmd)
+
+
+def find_benchmark(build_dir):
+    for path in [os.path.join(build_dir, "pinchot_benchmark"),
+                 os.path.join(build_dir, "Release", "pinchot_benchmark.exe")]:
+        if os.path.exists(path):
+            return path
+    raise RuntimeError("benchmark not found in {}".format(build_dir))
+
+
+def benchmark(build_dir, profiles, runs):
+    """Runs the benchmark, keeping the best result of each test."""
+    exe = find_benchmark(build_dir)
+    results = {}
+    for _ in range(runs):
+        out = run_command([exe, "--csv", "--profiles", str(profiles)], True)
+        for line in out.splitlines():
+            test, variant, ns = line.split(',')
+            key = (test, variant)
+            results[key] = min(results.get(key, float(ns)), float(ns))
+    return results
+
+
+def merge_clang_profiles(pgo_dir):
+    raw = glob.glob(os.path.join(pgo_dir, "*.profraw"))
+    if not raw:
+        return
+    output = os.path.join(pgo_dir, "pinchot.profdata")
+    run_command(["llvm-profdata", "merge", "-output=" + output] + raw)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--build-dir", default=os.path.join(ROOT_DIR,
+                                                            "build-pgo"),
+                        help="directory to hold both builds")
+    parser.add_argument("--profiles", type=int, default=20000,
+                        help="number of profiles per benchmark test")
+    parser.add_argument("--runs", type=int, default=3,
+                        help="benchmark runs per build, best result is kept")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="parallel build jobs")
+    parser.add_argument("--no-lto", action="store_true",
+                        help="only apply profile guided optimization")
+    args = parser.parse_args()
+
+    build_dir = os.path.abspath(args.build_dir)
+    baseline_dir = os.path.join(build_dir, "baseline")
+    optimized_dir = os.path.join(build_dir, "optimized")
+    pgo_dir = os.path.join(optimized_dir, "pgo")
+    lto = "OFF" if args.no_lto else "ON"
+
+    configure(baseline_dir, {"PINCHOT_LTO": "OFF", "PINCHOT_PGO": ""})
+    build(baseline_dir, args.jobs)
+    baseline = benchmark(baseline_dir, args.profiles, args.runs)
+
+    shutil.rmtree(pgo_dir, ignore_errors=True)
+    os.makedirs(pgo_dir)
+    configure(optimized_dir, {"PINCHOT_LTO": lto, "PINCHOT_PGO": "GENERATE",
+                              "PINCHOT_PGO_DIR": pgo_dir})
+    build(optimized_dir, args.jobs, clean=True)
+    # training run, the results of the instrumented build are meaningless
+    benchmark(optimized_dir, args.profiles, 1)
+    merge_clang_profiles(pgo_dir)
+
+    configure(optimized_dir, {"PINCHOT_LTO": lto, "PINCHOT_PGO": "USE",
+                              "PINCHOT_PGO_DIR": pgo_dir})
+    build(optimized_dir, args.jobs, clean=True)
+    optimized = benchmark(optimized_dir, args.profiles, args.runs)
+
+    print()
+    print("{:<12}{:<10}{:>14}{:>14}{:>10}".format(
+        "test", "variant", "baseline ns", "lto+pgo ns", "speedup"))
+    for key in baseline:
+        if key not in optimized:
+            continue
+        b = baseline[key]
+        o = optimized[key]
+        print("{:<12}{:<10}{:>14.1f}{:>14.1f}{:>9.2f}x".format(
+            key[0], key[1], b, o, b / o if o else 0.0))
+
+    print()
+    print("optimized library: {}".format(optimized_dir))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
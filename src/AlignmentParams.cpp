@@ -50,6 +50,20 @@ bool AlignmentParams::GetFlipX() const
   return flip_x;
 }
 
+CameraToMillCoefficients AlignmentParams::GetCameraToMillCoefficients() const
+{
+  CameraToMillCoefficients c;
+
+  c.cos_yaw = cos_yaw;
+  c.cos_roll = cos_roll;
+  c.sin_roll = sin_roll;
+  c.shift_x_1000 = shift_x_1000;
+  c.shift_y_1000 = shift_y_1000;
+  c.float_scale = 0.0;
+
+  return c;
+}
+
 void AlignmentParams::SetRoll(double roll)
 {
   this->roll = roll;
@@ -12,6 +12,20 @@
 
 namespace joescan {
 
+/**
+ * @brief The coefficients used by `AlignmentParams::CameraToMill`, exposed so
+ * that vectorized kernels can perform the identical sequence of operations.
+ */
+struct CameraToMillCoefficients {
+  double cos_yaw;
+  double cos_roll;
+  double sin_roll;
+  double shift_x_1000;
+  double shift_y_1000;
+  // converts mill coordinates to the float output units, `0` for none
+  double float_scale;
+};
+
 class AlignmentParams {
  public:
   /**
@@ -56,6 +70,14 @@ class AlignmentParams {
    */
   bool GetFlipX() const;
 
+  /**
+   * Obtain the coefficients used to convert from camera coordinates to mill
+   * coordinates.
+   *
+   * @return The camera to mill coefficients.
+   */
+  CameraToMillCoefficients GetCameraToMillCoefficients() const;
+
   /**
    * For XY profile data, this will rotate the points around the mill
    * coordinate system origin.
@@ -7,10 +7,31 @@
 
 #include "BroadcastConnectMessage.hpp"
 #include "Enums.hpp"
-#include "TcpSerializationHelpers.hpp"
+#include "MessageSchema.hpp"
 
 using namespace joescan;
 
+#define FIELD(m)                                                              \
+  SCHEMA_FIELD(BroadcastConnectMessage::BroadcastConnectMessagePacket, m)
+#define WIRE_FIELD(m, w)                                                      \
+  SCHEMA_WIRE_FIELD(BroadcastConnectMessage::BroadcastConnectMessagePacket,  \
+                    m, w)
+
+struct BroadcastConnectMessage::Layout {
+  // the connection type is sent ahead of the serial number
+  typedef MessageSchema<FIELD(ip), FIELD(port), FIELD(session_id),
+                        FIELD(scan_head_id), WIRE_FIELD(conn_type, uint8_t),
+                        FIELD(serial_number)>
+    Body;
+
+  static_assert(InfoHeaderSchema::kSize + Body::kSize ==
+                  kBroadcastConnectMessageSize,
+                "Connect message layout changed");
+};
+
+#undef FIELD
+#undef WIRE_FIELD
+
 BroadcastConnectMessage::BroadcastConnectMessage()
 {
   packet.header.magic = kCommandMagic;
@@ -36,53 +57,29 @@ BroadcastConnectMessage::BroadcastConnectMessage(uint32_t ip, uint16_t port,
 BroadcastConnectMessage BroadcastConnectMessage::Deserialize(
   std::vector<uint8_t> &data)
 {
-  int i = 0;
-  uint8_t conn_type;
   BroadcastConnectMessage message;
 
-  i += ExtractFromNetworkBuffer(message.packet.header.magic, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.header.size, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.header.type, &data[i]);
-  ValidateHeader(message.packet.header);
-
-  i += ExtractFromNetworkBuffer(message.packet.ip, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.port, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.session_id, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.scan_head_id, &data[i]);
-  i += ExtractFromNetworkBuffer(conn_type, &data[i]);
-  i += ExtractFromNetworkBuffer(message.packet.serial_number, &data[i]);
-  message.packet.conn_type = ConnectionType::_from_integral(conn_type);
-
-  if (i != kBroadcastConnectMessageSize) {
+  if (data.size() < kBroadcastConnectMessageSize) {
     throw std::runtime_error("Failed to deserialize the connect packet");
   }
 
+  const uint8_t *p = InfoHeaderSchema::Read(message.packet.header, data.data());
+  ValidateHeader(message.packet.header);
+  Layout::Body::Read(message.packet, p);
+
   return message;
 }
 
 std::vector<uint8_t> BroadcastConnectMessage::Serialize() const
 {
-  uint8_t conn_type;
-  std::vector<uint8_t> message;
-  message.reserve(packet.header.size);
-
-  ValidateHeader(packet.header);
-  SerializeIntegralToBytes(message, &packet.header.magic);
-  SerializeIntegralToBytes(message, &packet.header.size);
-  SerializeIntegralToBytes(message, &packet.header.type);
-
-  SerializeIntegralToBytes(message, &packet.ip);
-  uint16_t port = (packet.port == 0) ? kScanServerPort : packet.port;
-  SerializeIntegralToBytes(message, &port);
-  SerializeIntegralToBytes(message, &packet.session_id);
-  SerializeIntegralToBytes(message, &packet.scan_head_id);
-  conn_type = packet.conn_type._to_integral();
-  SerializeIntegralToBytes(message, &conn_type);
-  SerializeIntegralToBytes(message, &packet.serial_number);
-
-  if (message.size() != kBroadcastConnectMessageSize) {
-    throw std::runtime_error("Failed to serialize the connect packet");
-  }
+  std::vector<uint8_t> message(kBroadcastConnectMessageSize);
+  BroadcastConnectMessagePacket pkt = packet;
+
+  ValidateHeader(pkt.header);
+  pkt.port = (pkt.port == 0) ? kScanServerPort : pkt.port;
+
+  uint8_t *p = InfoHeaderSchema::Write(pkt.header, message.data());
+  Layout::Body::Write(pkt, p);
 
   return message;
 }
@@ -46,6 +46,9 @@ class BroadcastConnectMessage {
   };
 #pragma pack(pop)
 
+  // the field layout of the message, defined with the serialization
+  struct Layout;
+
   static const int kBroadcastConnectMessageSize =
     sizeof(BroadcastConnectMessagePacket);
 
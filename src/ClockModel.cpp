@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "ClockModel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace joescan;
+
+// drift assumed before there are enough windows to estimate it, the tolerance
+// of a typical crystal oscillator
+static const double kMaxDrift = 100.0e-6;
+
+uint64_t joescan::GetHostTimeNs()
+{
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+int64_t ClockModel::Line::Offset(uint64_t timestamp_ns) const
+{
+  double x = static_cast<double>(static_cast<int64_t>(timestamp_ns -
+                                                      reference_ns));
+  return offset_ns + std::llround(intercept + slope * x);
+}
+
+void ClockModel::RunningStats::Clear()
+{
+  count = 0;
+  mean = 0.0;
+  m2 = 0.0;
+  min = 0.0;
+  max = 0.0;
+}
+
+void ClockModel::RunningStats::Add(double value)
+{
+  // Welford's method, stable over any number of values
+  double delta = value - mean;
+  count++;
+  mean += delta / count;
+  m2 += delta * (value - mean);
+  min = (1 == count) ? value : std::min(min, value);
+  max = (1 == count) ? value : std::max(max, value);
+}
+
+double ClockModel::RunningStats::StandardDeviation() const
+{
+  return (1 < count) ? std::sqrt(m2 / (count - 1)) : 0.0;
+}
+
+ClockModel::ClockModel() : windows(kMaxWindows)
+{
+  Clear();
+}
+
+void ClockModel::Reset()
+{
+  std::lock_guard<std::mutex> lk(lock);
+  Clear();
+}
+
+void ClockModel::AddStatus(uint64_t timestamp_ns, uint64_t host_ns)
+{
+  std::lock_guard<std::mutex> lk(lock);
+  AddSample(SAMPLE_STATUS, timestamp_ns, host_ns);
+}
+
+void ClockModel::AddProfile(jsCamera camera, uint64_t timestamp_ns,
+                            uint64_t host_ns)
+{
+  std::lock_guard<std::mutex> lk(lock);
+  AddSample(SAMPLE_PROFILE, timestamp_ns, host_ns);
+
+  if (!windows.empty()) {
+    int64_t offset = static_cast<int64_t>(host_ns - timestamp_ns);
+    int64_t latency = offset - line.Offset(timestamp_ns);
+    arrival_latency.Add(static_cast<double>(latency));
+  }
+
+  if ((0 <= camera) && (JS_CAMERA_MAX > camera)) {
+    uint64_t last = last_timestamp_ns[camera];
+    if ((0 != last) && (timestamp_ns > last)) {
+      interval.Add(static_cast<double>(timestamp_ns - last));
+    }
+    last_timestamp_ns[camera] = timestamp_ns;
+  }
+}
+
+bool ClockModel::Convert(uint64_t timestamp_ns, uint64_t *host_ns,
+                         uint64_t *error_ns) const
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  if (windows.empty()) {
+    return false;
+  }
+
+  *host_ns = timestamp_ns + line.Offset(timestamp_ns);
+  *error_ns = ErrorBound(timestamp_ns);
+
+  return true;
+}
+
+void ClockModel::GetClock(jsScanHeadClock *clock) const
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  if (windows.empty()) {
+    clock->timestamp_ns = 0;
+    clock->host_time_ns = 0;
+    clock->error_ns = 0;
+    clock->drift_ppm = 0.0;
+  } else {
+    uint64_t timestamp_ns = windows.back().timestamp_ns;
+    clock->timestamp_ns = timestamp_ns;
+    clock->host_time_ns = timestamp_ns + line.Offset(timestamp_ns);
+    clock->error_ns = ErrorBound(timestamp_ns);
+    clock->drift_ppm = line.slope * 1.0e6;
+  }
+
+  clock->num_samples = num_samples;
+  clock->profile_latency_ns = static_cast<uint64_t>(profile_latency_ns);
+  clock->arrival_latency_mean_ns = arrival_latency.mean;
+  clock->arrival_latency_stddev_ns = arrival_latency.StandardDeviation();
+  clock->arrival_latency_max_ns = arrival_latency.max;
+  clock->num_intervals = interval.count;
+  clock->interval_mean_ns = interval.mean;
+  clock->interval_stddev_ns = interval.StandardDeviation();
+  clock->interval_min_ns = interval.min;
+  clock->interval_max_ns = interval.max;
+}
+
+void ClockModel::AddSample(SampleType type, uint64_t timestamp_ns,
+                           uint64_t host_ns)
+{
+  uint64_t index = timestamp_ns / kWindowNs;
+  int64_t offset = static_cast<int64_t>(host_ns - timestamp_ns);
+
+  if (!windows.empty() && (index + kMaxWindows < windows.back().index)) {
+    // scan head time went back further than the windows kept, its clock was
+    // reset and none of the samples apply anymore
+    Clear();
+  }
+
+  if (!windows.empty() && (index < windows.back().index)) {
+    // late arrival from a window already closed
+    return;
+  }
+
+  num_samples++;
+
+  if (windows.empty() || (index != windows.back().index) ||
+      (type != windows.back().type)) {
+    bool is_first_profile_window = (SAMPLE_PROFILE == type) &&
+                                   !windows.empty() &&
+                                   (SAMPLE_STATUS == windows.back().type);
+
+    if (is_first_profile_window) {
+      status_line = line;
+      latency_error_ns = ErrorBound(timestamp_ns);
+    }
+    is_measuring_latency = is_first_profile_window;
+
+    Window window;
+    window.index = index;
+    window.type = type;
+    window.timestamp_ns = timestamp_ns;
+    window.offset_ns = offset;
+    windows.push_back(window);
+  } else if (offset < windows.back().offset_ns) {
+    windows.back().timestamp_ns = timestamp_ns;
+    windows.back().offset_ns = offset;
+  } else {
+    return;
+  }
+
+  if (is_measuring_latency) {
+    const Window &window = windows.back();
+    int64_t expected = status_line.Offset(window.timestamp_ns);
+    int64_t latency = window.offset_ns - expected;
+    profile_latency_ns = std::max(latency, static_cast<int64_t>(0));
+  }
+
+  Fit();
+}
+
+void ClockModel::Clear()
+{
+  windows.clear();
+  num_samples = 0;
+  line.reference_ns = 0;
+  line.offset_ns = 0;
+  line.slope = 0.0;
+  line.intercept = 0.0;
+  slope_error = kMaxDrift;
+  max_residual = 0.0;
+  status_line = line;
+  profile_latency_ns = 0;
+  latency_error_ns = 0;
+  is_measuring_latency = false;
+  std::fill(last_timestamp_ns, last_timestamp_ns + JS_CAMERA_MAX, 0);
+  arrival_latency.Clear();
+  interval.Clear();
+}
+
+int64_t ClockModel::WindowOffset(const Window &window) const
+{
+  if (SAMPLE_PROFILE == window.type) {
+    return window.offset_ns - profile_latency_ns;
+  }
+
+  return window.offset_ns;
+}
+
+void ClockModel::Fit()
+{
+  const Window &reference = windows.back();
+  uint32_t n = static_cast<uint32_t>(windows.size());
+  double sum_x = 0.0;
+  double sum_y = 0.0;
+  double sum_xx = 0.0;
+  double sum_xy = 0.0;
+
+  line.reference_ns = reference.timestamp_ns;
+  line.offset_ns = WindowOffset(reference);
+  line.slope = 0.0;
+  line.intercept = 0.0;
+  slope_error = kMaxDrift;
+  max_residual = 0.0;
+
+  if (1 == n) {
+    return;
+  }
+
+  for (auto const &window : windows) {
+    double x = static_cast<double>(
+      static_cast<int64_t>(window.timestamp_ns - line.reference_ns));
+    double y = static_cast<double>(WindowOffset(window) - line.offset_ns);
+    sum_x += x;
+    sum_y += y;
+  }
+
+  double mean_x = sum_x / n;
+  double mean_y = sum_y / n;
+
+  for (auto const &window : windows) {
+    double x = static_cast<double>(
+      static_cast<int64_t>(window.timestamp_ns - line.reference_ns));
+    double y = static_cast<double>(WindowOffset(window) - line.offset_ns);
+    sum_xx += (x - mean_x) * (x - mean_x);
+    sum_xy += (x - mean_x) * (y - mean_y);
+  }
+
+  if (0.0 >= sum_xx) {
+    return;
+  }
+
+  line.slope = sum_xy / sum_xx;
+  line.intercept = mean_y - line.slope * mean_x;
+
+  double sum_rr = 0.0;
+  for (auto const &window : windows) {
+    double x = static_cast<double>(
+      static_cast<int64_t>(window.timestamp_ns - line.reference_ns));
+    double y = static_cast<double>(WindowOffset(window) - line.offset_ns);
+    double r = y - (line.intercept + line.slope * x);
+    sum_rr += r * r;
+    max_residual = std::max(max_residual, std::fabs(r));
+  }
+
+  if (2 < n) {
+    // three standard errors of the slope, but never less certain than a
+    // crystal's tolerance
+    double sigma = std::sqrt(sum_rr / (n - 2));
+    slope_error = std::min(3.0 * sigma / std::sqrt(sum_xx), kMaxDrift);
+  }
+}
+
+uint64_t ClockModel::ErrorBound(uint64_t timestamp_ns) const
+{
+  double x = static_cast<double>(
+    static_cast<int64_t>(timestamp_ns - line.reference_ns));
+  double bound = max_residual + slope_error * std::fabs(x);
+
+  // profile windows are only as accurate as the status line their latency
+  // was measured against
+  for (auto const &window : windows) {
+    if (SAMPLE_PROFILE == window.type) {
+      bound += static_cast<double>(latency_error_ns);
+      break;
+    }
+  }
+
+  return static_cast<uint64_t>(std::ceil(bound));
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_CLOCK_MODEL_H
+#define JOESCAN_CLOCK_MODEL_H
+
+#include <cstdint>
+#include <mutex>
+
+#include "boost/circular_buffer.hpp"
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * Obtains the time of the host's monotonic clock.
+ *
+ * @return The host time in nanoseconds.
+ */
+uint64_t GetHostTimeNs();
+
+/**
+ * @brief Estimates the mapping of a scan head's clock to the host's monotonic
+ * clock from the arrival times of messages timestamped by the scan head.
+ *
+ * Arrival time minus scan head time is the clock offset plus a transport
+ * delay that is never negative, so the least difference seen within each
+ * window of scan head time lies closest to the true offset. A least squares
+ * line through the recent window minima gives the offset and the drift; its
+ * residuals bound the error of the mapping.
+ *
+ * Status messages are timestamped when sent while profiles are timestamped
+ * when exposed, so profiles arrive later by the time the scan head takes to
+ * process them. This delay is measured when profiles start arriving after
+ * status messages and is removed from the profile windows, keeping the line
+ * continuous as the scan head starts and stops scanning.
+ */
+class ClockModel {
+ public:
+  ClockModel();
+
+  /**
+   * Discards all samples, to be called when the scan head's clock may have
+   * been reset, such as when connecting.
+   */
+  void Reset();
+
+  /**
+   * Adds the arrival of a status message.
+   *
+   * @param timestamp_ns The global time reported by the status message.
+   * @param host_ns The host time the message arrived.
+   */
+  void AddStatus(uint64_t timestamp_ns, uint64_t host_ns);
+
+  /**
+   * Adds the arrival of the first packet of a profile.
+   *
+   * @param camera The camera that took the profile.
+   * @param timestamp_ns The timestamp of the profile.
+   * @param host_ns The host time the packet arrived.
+   */
+  void AddProfile(jsCamera camera, uint64_t timestamp_ns, uint64_t host_ns);
+
+  /**
+   * Converts a scan head time to host time.
+   *
+   * @param timestamp_ns The scan head time to convert.
+   * @param host_ns Updated with the host time.
+   * @param error_ns Updated with the bound of the error of the host time.
+   * @return Boolean `true` on success, `false` if there are no samples.
+   */
+  bool Convert(uint64_t timestamp_ns, uint64_t *host_ns,
+               uint64_t *error_ns) const;
+
+  /**
+   * Fills in the current estimate and the profile statistics.
+   *
+   * @param clock The structure to fill in.
+   */
+  void GetClock(jsScanHeadClock *clock) const;
+
+ private:
+  enum SampleType {
+    SAMPLE_STATUS,
+    SAMPLE_PROFILE,
+  };
+
+  struct Window {
+    uint64_t index;
+    SampleType type;
+    uint64_t timestamp_ns;
+    int64_t offset_ns;
+  };
+
+  // host time minus scan head time as a line of scan head time, relative to
+  // a reference point to keep the arithmetic precise
+  struct Line {
+    uint64_t reference_ns;
+    int64_t offset_ns;
+    double slope;
+    double intercept;
+
+    int64_t Offset(uint64_t timestamp_ns) const;
+  };
+
+  struct RunningStats {
+    uint64_t count;
+    double mean;
+    double m2;
+    double min;
+    double max;
+
+    void Clear();
+    void Add(double value);
+    double StandardDeviation() const;
+  };
+
+  // width of the windows in scan head time and the number of windows kept,
+  // long enough to average out network delays, short enough to follow the
+  // drift as the temperature of the scan head changes
+  static const uint64_t kWindowNs = 1000000000;
+  static const int kMaxWindows = 16;
+
+  void AddSample(SampleType type, uint64_t timestamp_ns, uint64_t host_ns);
+  void Clear();
+  int64_t WindowOffset(const Window &window) const;
+  void Fit();
+  uint64_t ErrorBound(uint64_t timestamp_ns) const;
+
+  mutable std::mutex lock;
+  boost::circular_buffer<Window> windows;
+  uint64_t num_samples;
+  Line line;
+  double slope_error;
+  double max_residual;
+
+  // delay of profiles relative to status messages, measured against the line
+  // fit to the status windows while the first profile window is filled
+  Line status_line;
+  int64_t profile_latency_ns;
+  uint64_t latency_error_ns;
+  bool is_measuring_latency;
+
+  uint64_t last_timestamp_ns[JS_CAMERA_MAX];
+  RunningStats arrival_latency;
+  RunningStats interval;
+};
+} // namespace joescan
+
+#endif // JOESCAN_CLOCK_MODEL_H
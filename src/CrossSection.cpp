@@ -0,0 +1,423 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "CrossSection.hpp"
+
+using namespace joescan;
+
+static const double kPi = 3.14159265358979323846;
+
+static inline int64_t Cross(const Point2D<int64_t> &o,
+                            const Point2D<int64_t> &a,
+                            const Point2D<int64_t> &b)
+{
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+static inline int64_t DistanceSquared(const Point2D<int64_t> &a,
+                                      const Point2D<int64_t> &b)
+{
+  return (b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y);
+}
+
+/**
+ * Converts a direction to an angle in degrees from the X axis, within
+ * [0, 180) as a diameter has no sense of direction.
+ */
+static double AngleDegrees(double dx, double dy)
+{
+  double angle = std::atan2(dy, dx) * 180.0 / kPi;
+
+  if (0.0 > angle) {
+    angle += 180.0;
+  }
+
+  return (180.0 <= angle) ? angle - 180.0 : angle;
+}
+
+/**
+ * Finds the real roots of `x^3 + a x^2 + b x + c`.
+ */
+static int SolveCubic(double a, double b, double c, double roots[3])
+{
+  double q = (a * a - 3.0 * b) / 9.0;
+  double r = (2.0 * a * a * a - 9.0 * a * b + 27.0 * c) / 54.0;
+  double q3 = q * q * q;
+
+  if (r * r < q3) {
+    double theta = std::acos(r / std::sqrt(q3));
+    double m = -2.0 * std::sqrt(q);
+    roots[0] = m * std::cos(theta / 3.0) - a / 3.0;
+    roots[1] = m * std::cos((theta + 2.0 * kPi) / 3.0) - a / 3.0;
+    roots[2] = m * std::cos((theta - 2.0 * kPi) / 3.0) - a / 3.0;
+    return 3;
+  }
+
+  double e = -std::cbrt(std::fabs(r) + std::sqrt(r * r - q3));
+  e = (0.0 > r) ? -e : e;
+  roots[0] = (e + ((0.0 == e) ? 0.0 : q / e)) - a / 3.0;
+  return 1;
+}
+
+/**
+ * Inverts a 3x3 matrix, returning `false` if it is singular.
+ */
+static bool Invert3(const double m[3][3], double inv[3][3])
+{
+  double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+  double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+  double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+  double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+
+  if ((0.0 == det) || !std::isfinite(det)) {
+    return false;
+  }
+
+  inv[0][0] = c00 / det;
+  inv[1][0] = c01 / det;
+  inv[2][0] = c02 / det;
+  inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det;
+  inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+  inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det;
+  inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+  inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det;
+  inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+
+  return true;
+}
+
+/**
+ * Finds an eigenvector of a 3x3 matrix given its eigenvalue, as the cross
+ * product of two rows of `m - lambda * I` with the greatest magnitude.
+ */
+static void Eigenvector3(const double m[3][3], double lambda, double vec[3])
+{
+  double a[3][3];
+  double best = -1.0;
+
+  // left as the zero vector if every cross product is NaN
+  vec[0] = 0.0;
+  vec[1] = 0.0;
+  vec[2] = 0.0;
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      a[i][j] = m[i][j] - ((i == j) ? lambda : 0.0);
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    const double *r0 = a[i];
+    const double *r1 = a[(i + 1) % 3];
+    double c[3] = {r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2],
+                   r0[0] * r1[1] - r0[1] * r1[0]};
+    double norm = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    if (norm > best) {
+      best = norm;
+      vec[0] = c[0];
+      vec[1] = c[1];
+      vec[2] = c[2];
+    }
+  }
+}
+
+CrossSection::CrossSection(const ReductionKernels &kernels) : kernels(kernels)
+{
+}
+
+void CrossSection::Compute(std::vector<Point2D<int64_t>> &points,
+                           jsCrossSection *section)
+{
+  double nan = std::numeric_limits<double>::quiet_NaN();
+
+  section->num_points = static_cast<uint32_t>(points.size());
+  section->num_hull_points = 0;
+  section->area = nan;
+  section->perimeter = nan;
+  section->min_diameter = nan;
+  section->min_diameter_angle = nan;
+  section->max_diameter = nan;
+  section->max_diameter_angle = nan;
+  section->ellipse_x = nan;
+  section->ellipse_y = nan;
+  section->ellipse_major = nan;
+  section->ellipse_minor = nan;
+  section->ellipse_angle = nan;
+
+  // the hull requires the points sorted by X then Y; runs of equal X are
+  // short, so this stays linear
+  for (size_t i = 0; i < points.size();) {
+    size_t j = i + 1;
+    while ((j < points.size()) && (points[j].x == points[i].x)) {
+      j++;
+    }
+
+    if (1 < (j - i)) {
+      std::sort(points.begin() + i, points.begin() + j,
+                [](const Point2D<int64_t> &a, const Point2D<int64_t> &b) {
+                  return a.y < b.y;
+                });
+    }
+    i = j;
+  }
+
+  ConvexHull(points);
+  section->num_hull_points = static_cast<uint32_t>(hull.size());
+
+  if (3 <= hull.size()) {
+    int64_t area2 = 0;
+    double perimeter = 0.0;
+    for (size_t n = 0; n < hull.size(); n++) {
+      const Point2D<int64_t> &a = hull[n];
+      const Point2D<int64_t> &b = hull[(n + 1) % hull.size()];
+      area2 += a.x * b.y - a.y * b.x;
+      perimeter += std::sqrt(static_cast<double>(DistanceSquared(a, b)));
+    }
+
+    section->area = 0.5 * static_cast<double>(area2);
+    section->perimeter = perimeter;
+    Calipers(section);
+  }
+
+  FitEllipse(points, section);
+}
+
+void CrossSection::ConvexHull(std::vector<Point2D<int64_t>> &points)
+{
+  size_t n = points.size();
+  size_t k = 0;
+
+  if (3 > n) {
+    hull = points;
+    return;
+  }
+
+  hull.resize(2 * n);
+
+  // Andrew's monotone chain, lower hull then upper hull, counter clockwise
+  for (size_t i = 0; i < n; i++) {
+    while ((2 <= k) && (0 >= Cross(hull[k - 2], hull[k - 1], points[i]))) {
+      k--;
+    }
+    hull[k++] = points[i];
+  }
+
+  for (size_t i = n - 1, t = k + 1; 0 < i; i--) {
+    while ((t <= k) && (0 >= Cross(hull[k - 2], hull[k - 1], points[i - 1]))) {
+      k--;
+    }
+    hull[k++] = points[i - 1];
+  }
+
+  // the last point is the first point repeated
+  hull.resize((1 < k) ? k - 1 : k);
+}
+
+void CrossSection::Calipers(jsCrossSection *section) const
+{
+  size_t m = hull.size();
+  size_t j = 1;
+  double min_width = std::numeric_limits<double>::max();
+  int64_t max_d2 = -1;
+
+  for (size_t i = 0; i < m; i++) {
+    const Point2D<int64_t> &a = hull[i];
+    const Point2D<int64_t> &b = hull[(i + 1) % m];
+
+    // advance to the vertex farthest from the edge, the area of the
+    // triangle it forms with the edge is unimodal around the hull
+    while (Cross(a, b, hull[(j + 1) % m]) > Cross(a, b, hull[j])) {
+      j = (j + 1) % m;
+    }
+
+    double dx = static_cast<double>(b.x - a.x);
+    double dy = static_cast<double>(b.y - a.y);
+    double width = static_cast<double>(Cross(a, b, hull[j])) /
+                   std::sqrt(dx * dx + dy * dy);
+    if (width < min_width) {
+      min_width = width;
+      // measured along the normal of the edge
+      section->min_diameter_angle = AngleDegrees(-dy, dx);
+    }
+
+    const Point2D<int64_t> *ends[2] = {&a, &b};
+    for (int e = 0; e < 2; e++) {
+      int64_t d2 = DistanceSquared(*ends[e], hull[j]);
+      if (d2 > max_d2) {
+        max_d2 = d2;
+        section->max_diameter_angle =
+          AngleDegrees(static_cast<double>(hull[j].x - ends[e]->x),
+                       static_cast<double>(hull[j].y - ends[e]->y));
+      }
+    }
+  }
+
+  section->min_diameter = min_width;
+  section->max_diameter = std::sqrt(static_cast<double>(max_d2));
+}
+
+void CrossSection::FitEllipse(const std::vector<Point2D<int64_t>> &points,
+                              jsCrossSection *section)
+{
+  uint32_t n = static_cast<uint32_t>(points.size());
+  if (5 > n) {
+    return;
+  }
+
+  // center and scale the points so the moments stay well conditioned
+  double cx = 0.0;
+  double cy = 0.0;
+  for (auto const &p : points) {
+    cx += static_cast<double>(p.x);
+    cy += static_cast<double>(p.y);
+  }
+  cx /= n;
+  cy /= n;
+
+  double spread = 0.0;
+  for (auto const &p : points) {
+    double dx = p.x - cx;
+    double dy = p.y - cy;
+    spread += dx * dx + dy * dy;
+  }
+
+  double scale = std::sqrt(spread / (2.0 * n));
+  if (0.0 == scale) {
+    return;
+  }
+
+  u.resize(n);
+  v.resize(n);
+  for (uint32_t i = 0; i < n; i++) {
+    u[i] = (points[i].x - cx) / scale;
+    v[i] = (points[i].y - cy) / scale;
+  }
+
+  double s[14] = {0.0};
+  kernels.sum_conic_moments(u.data(), v.data(), n, s);
+
+  // Direct least squares fit of an ellipse, split into the quadratic and
+  // linear parts of the conic (Halir & Flusser); `s1`, `s2` & `s3` are the
+  // blocks of the scatter matrix of [u^2, uv, v^2] and [u, v, 1].
+  double s1[3][3] = {{s[9], s[10], s[11]},
+                     {s[10], s[11], s[12]},
+                     {s[11], s[12], s[13]}};
+  double s2[3][3] = {{s[5], s[6], s[2]},
+                     {s[6], s[7], s[3]},
+                     {s[7], s[8], s[4]}};
+  double s3[3][3] = {{s[2], s[3], s[0]},
+                     {s[3], s[4], s[1]},
+                     {s[0], s[1], static_cast<double>(n)}};
+  double s3_inv[3][3];
+  if (!Invert3(s3, s3_inv)) {
+    return;
+  }
+
+  // linear part as a function of the quadratic part, t = -inv(s3) * s2'
+  double t[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      t[i][j] = 0.0;
+      for (int k = 0; k < 3; k++) {
+        t[i][j] -= s3_inv[i][k] * s2[j][k];
+      }
+    }
+  }
+
+  // reduced scatter matrix, premultiplied by the inverse of the constraint
+  // matrix for 4ac - b^2 = 1
+  double r[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      r[i][j] = s1[i][j];
+      for (int k = 0; k < 3; k++) {
+        r[i][j] += s2[i][k] * t[k][j];
+      }
+    }
+  }
+
+  double m[3][3];
+  for (int j = 0; j < 3; j++) {
+    m[0][j] = r[2][j] / 2.0;
+    m[1][j] = -r[1][j];
+    m[2][j] = r[0][j] / 2.0;
+  }
+
+  double trace = m[0][0] + m[1][1] + m[2][2];
+  double minors = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) +
+                  (m[0][0] * m[2][2] - m[0][2] * m[2][0]) +
+                  (m[1][1] * m[2][2] - m[1][2] * m[2][1]);
+  double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+               m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  double roots[3];
+  int num_roots = SolveCubic(-trace, minors, -det, roots);
+
+  // the ellipse is given by the eigenvector satisfying the constraint
+  double a1[3] = {0.0, 0.0, 0.0};
+  double best = 0.0;
+  for (int i = 0; i < num_roots; i++) {
+    double vec[3] = {0.0, 0.0, 0.0};
+    Eigenvector3(m, roots[i], vec);
+    double norm =
+      std::sqrt(vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]);
+    if (0.0 == norm) {
+      continue;
+    }
+
+    double cond = (4.0 * vec[0] * vec[2] - vec[1] * vec[1]) / (norm * norm);
+    if (cond > best) {
+      best = cond;
+      for (int k = 0; k < 3; k++) {
+        a1[k] = vec[k] / norm;
+      }
+    }
+  }
+
+  if (0.0 == best) {
+    return;
+  }
+
+  double a = a1[0];
+  double b = a1[1];
+  double c = a1[2];
+  double d = t[0][0] * a + t[0][1] * b + t[0][2] * c;
+  double e = t[1][0] * a + t[1][1] * b + t[1][2] * c;
+  double f = t[2][0] * a + t[2][1] * b + t[2][2] * c;
+
+  double den = b * b - 4.0 * a * c;
+  double u0 = (2.0 * c * d - b * e) / den;
+  double v0 = (2.0 * a * e - b * d) / den;
+  double f0 = a * u0 * u0 + b * u0 * v0 + c * v0 * v0 + d * u0 + e * v0 + f;
+  if (0.0 < f0) {
+    a = -a;
+    b = -b;
+    c = -c;
+    f0 = -f0;
+  }
+
+  double mean = 0.5 * (a + c);
+  double radius = std::sqrt(0.25 * (a - c) * (a - c) + 0.25 * b * b);
+  double l_max = mean + radius;
+  double l_min = mean - radius;
+  if ((0.0 <= f0) || (0.0 >= l_min)) {
+    return;
+  }
+
+  section->ellipse_x = cx + scale * u0;
+  section->ellipse_y = cy + scale * v0;
+  section->ellipse_major = 2.0 * scale * std::sqrt(-f0 / l_min);
+  section->ellipse_minor = 2.0 * scale * std::sqrt(-f0 / l_max);
+  // the minor axis lies along the direction of the greatest eigenvalue of
+  // the quadratic form, the major axis is perpendicular to it
+  double theta = 0.5 * std::atan2(b, a - c);
+  section->ellipse_angle = AngleDegrees(-std::sin(theta), std::cos(theta));
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_CROSS_SECTION_H
+#define JOESCAN_CROSS_SECTION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.hpp"
+#include "ReductionKernels.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Computes the geometry of cross-sections. Holds the scratch memory
+ * used along the way so that it can be reused from one cross-section to the
+ * next.
+ */
+class CrossSection {
+ public:
+  /**
+   * Initializes the cross-section engine.
+   *
+   * @param kernels The reduction kernels to use.
+   */
+  CrossSection(const ReductionKernels &kernels);
+
+  /**
+   * Computes the geometry of a cross-section.
+   *
+   * @param points The points of the cross-section, sorted by X. Points with
+   * the same X are sorted by Y in place.
+   * @param section Updated with the geometry of the cross-section.
+   */
+  void Compute(std::vector<Point2D<int64_t>> &points, jsCrossSection *section);
+
+ private:
+  void ConvexHull(std::vector<Point2D<int64_t>> &points);
+  void Calipers(jsCrossSection *section) const;
+  void FitEllipse(const std::vector<Point2D<int64_t>> &points,
+                  jsCrossSection *section);
+
+  const ReductionKernels &kernels;
+  std::vector<Point2D<int64_t>> hull;
+  std::vector<double> u;
+  std::vector<double> v;
+};
+} // namespace joescan
+
+#endif // JOESCAN_CROSS_SECTION_H
@@ -7,7 +7,7 @@
 
 #include "DisconnectMessage.hpp"
 #include "Enums.hpp"
-#include "TcpSerializationHelpers.hpp"
+#include "MessageSchema.hpp"
 
 using namespace joescan;
 
@@ -20,17 +20,12 @@ DisconnectMessage::DisconnectMessage()
 
 std::vector<uint8_t> DisconnectMessage::Serialize() const
 {
-  std::vector<uint8_t> message;
-  message.reserve(packet.header.size);
+  static_assert(InfoHeaderSchema::kSize == kDisconnectMessageSize,
+                "Disconnect message layout changed");
+  std::vector<uint8_t> message(kDisconnectMessageSize);
 
   ValidateHeader(packet.header);
-  SerializeIntegralToBytes(message, &packet.header.magic);
-  SerializeIntegralToBytes(message, &packet.header.size);
-  SerializeIntegralToBytes(message, &packet.header.type);
-
-  if (message.size() != kDisconnectMessageSize) {
-    throw std::runtime_error("Failed to serial disconnect message");
-  }
+  InfoHeaderSchema::Write(packet.header, message.data());
 
   return message;
 }
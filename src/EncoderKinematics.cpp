@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "EncoderKinematics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace joescan;
+
+EncoderKinematics::EncoderKinematics()
+  : is_enabled(false),
+    time_constant_s(0.0),
+    counter_mask(UINT64_MAX)
+{
+  Reset();
+}
+
+void EncoderKinematics::Enable(const jsEncoderKinematicsConfig &config)
+{
+  time_constant_s = config.time_constant_s;
+  counter_mask = (64 <= config.counter_bits)
+                   ? UINT64_MAX
+                   : (static_cast<uint64_t>(1) << config.counter_bits) - 1;
+  Reset();
+  is_enabled = true;
+}
+
+void EncoderKinematics::Disable()
+{
+  is_enabled = false;
+}
+
+bool EncoderKinematics::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void EncoderKinematics::Reset()
+{
+  num_updates = 0;
+  last_timestamp_ns = 0;
+  std::fill(last_value, last_value + JS_ENCODER_MAX, 0);
+  std::fill(position, position + JS_ENCODER_MAX, 0);
+  std::fill(velocity, velocity + JS_ENCODER_MAX, 0.0);
+  std::fill(acceleration, acceleration + JS_ENCODER_MAX, 0.0);
+}
+
+void EncoderKinematics::Update(uint64_t timestamp_ns,
+                               const std::vector<int64_t> &encoders,
+                               jsEncoderKinematics *kinematics)
+{
+  uint32_t n = std::min(static_cast<uint32_t>(encoders.size()),
+                        static_cast<uint32_t>(JS_ENCODER_MAX));
+
+  if (0 == num_updates) {
+    for (uint32_t i = 0; i < n; i++) {
+      position[i] = encoders[i];
+      last_value[i] = encoders[i];
+    }
+    last_timestamp_ns = timestamp_ns;
+    num_updates++;
+  } else if (timestamp_ns > last_timestamp_ns) {
+    double dt = static_cast<double>(timestamp_ns - last_timestamp_ns) * 1.0e-9;
+    // gain of the low pass filters for this interval; a longer interval,
+    // such as after a lost profile, moves the output further toward the input
+    double k = (0.0 < time_constant_s) ? 1.0 - std::exp(-dt / time_constant_s)
+                                       : 1.0;
+
+    for (uint32_t i = 0; i < n; i++) {
+      int64_t delta = Delta(encoders[i], last_value[i]);
+      double v = static_cast<double>(delta) / dt;
+
+      position[i] += delta;
+      last_value[i] = encoders[i];
+
+      if (1 == num_updates) {
+        // first measured velocity, nothing to filter against yet
+        velocity[i] = v;
+        acceleration[i] = 0.0;
+      } else {
+        double filtered = velocity[i] + k * (v - velocity[i]);
+        double a = (filtered - velocity[i]) / dt;
+        velocity[i] = filtered;
+        acceleration[i] += k * (a - acceleration[i]);
+      }
+    }
+    last_timestamp_ns = timestamp_ns;
+    num_updates = std::min(num_updates + 1, static_cast<uint32_t>(2));
+  }
+
+  std::fill(kinematics->position, kinematics->position + JS_ENCODER_MAX, 0);
+  std::fill(kinematics->velocity, kinematics->velocity + JS_ENCODER_MAX, 0.0);
+  std::fill(kinematics->acceleration,
+            kinematics->acceleration + JS_ENCODER_MAX, 0.0);
+  std::copy(position, position + n, kinematics->position);
+  std::copy(velocity, velocity + n, kinematics->velocity);
+  std::copy(acceleration, acceleration + n, kinematics->acceleration);
+  kinematics->num_encoder_values = n;
+}
+
+int64_t EncoderKinematics::Delta(int64_t value, int64_t last) const
+{
+  // unsigned arithmetic wraps the same way the counter does; the shortest
+  // signed distance around the counter gives the direction of travel
+  uint64_t delta = (static_cast<uint64_t>(value) - static_cast<uint64_t>(last))
+                   & counter_mask;
+
+  if (delta > (counter_mask >> 1)) {
+    return -static_cast<int64_t>(counter_mask - delta) - 1;
+  }
+
+  return static_cast<int64_t>(delta);
+}
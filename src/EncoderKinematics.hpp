@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_ENCODER_KINEMATICS_H
+#define JOESCAN_ENCODER_KINEMATICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Derives the position, velocity and acceleration of each encoder from
+ * the encoder values and timestamps of consecutive profiles of a scan head.
+ * Velocity and acceleration are each smoothed by a first order low pass filter
+ * whose gain follows the time between profiles, so profiles lost on the
+ * network don't distort the result. Updated by the receiver thread as each
+ * profile arrives, so no pass over past profiles is needed.
+ */
+class EncoderKinematics {
+ public:
+  EncoderKinematics();
+
+  /**
+   * Enables the kinematics; must not be called while scanning.
+   *
+   * @param config The filter settings.
+   */
+  void Enable(const jsEncoderKinematicsConfig &config);
+
+  /**
+   * Disables the kinematics; must not be called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if the kinematics are enabled, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Clears the filter state, to be called before scanning starts.
+   */
+  void Reset();
+
+  /**
+   * Updates the filters with the encoder values of the next profile.
+   *
+   * @param timestamp_ns The timestamp of the profile.
+   * @param encoders The encoder values of the profile.
+   * @param kinematics Updated with the kinematics at the profile.
+   */
+  void Update(uint64_t timestamp_ns, const std::vector<int64_t> &encoders,
+              jsEncoderKinematics *kinematics);
+
+ private:
+  int64_t Delta(int64_t value, int64_t last) const;
+
+  std::atomic<bool> is_enabled;
+  double time_constant_s;
+  uint64_t counter_mask;
+  uint32_t num_updates;
+  uint64_t last_timestamp_ns;
+  int64_t last_value[JS_ENCODER_MAX];
+  int64_t position[JS_ENCODER_MAX];
+  double velocity[JS_ENCODER_MAX];
+  double acceleration[JS_ENCODER_MAX];
+};
+} // namespace joescan
+
+#endif // JOESCAN_ENCODER_KINEMATICS_H
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "LatestProfile.hpp"
+
+#include <cstring>
+
+using namespace joescan;
+
+static int _slot_index(jsCamera camera, jsLaser laser)
+{
+  return static_cast<int>(camera) * JS_LASER_MAX + static_cast<int>(laser);
+}
+
+LatestProfile::LatestProfile() : is_enabled(false)
+{
+  for (auto &slot : slots) {
+    slot.seq = 0;
+    slot.is_empty = true;
+  }
+}
+
+void LatestProfile::Enable()
+{
+  Reset();
+  is_enabled = true;
+}
+
+void LatestProfile::Disable()
+{
+  is_enabled = false;
+}
+
+bool LatestProfile::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void LatestProfile::Reset()
+{
+  // a reader copying a slot sees its sequence change and retries
+  for (auto &slot : slots) {
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.is_empty.store(true, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+  }
+}
+
+void LatestProfile::Store(Profile &profile)
+{
+  jsCamera camera = profile.GetCamera();
+  jsLaser laser = profile.GetLaser();
+
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return;
+  }
+
+  Slot &slot = slots[_slot_index(camera, laser)];
+  uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+
+  // the sequence is odd while the slot is written
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  profile.CopyTo(&slot.profile);
+  slot.is_empty.store(false, std::memory_order_relaxed);
+  slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+bool LatestProfile::Load(jsCamera camera, jsLaser laser,
+                         jsRawProfile *dst) const
+{
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return false;
+  }
+
+  const Slot &slot = slots[_slot_index(camera, laser)];
+
+  // the receiver writes each slot at most once per scan period and a write
+  // is a single copy, so a retry is rare and the next attempt succeeds
+  for (;;) {
+    uint64_t begin = slot.seq.load(std::memory_order_acquire);
+    if (begin & 1) {
+      continue;
+    }
+
+    bool is_empty = slot.is_empty.load(std::memory_order_relaxed);
+    if (!is_empty) {
+      memcpy(dst, &slot.profile, sizeof(jsRawProfile));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) == begin) {
+      return !is_empty;
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_LATEST_PROFILE_H
+#define JOESCAN_LATEST_PROFILE_H
+
+#include <atomic>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Conflates the profiles of a scan head, keeping only the newest one
+ * from each camera and laser pair. Each pair has a single slot guarded by a
+ * sequence counter: the receiver thread overwrites the slot in place and
+ * readers copy it out, retrying if it changed while being copied. Neither
+ * side takes a lock and neither waits on the other to drain, so the profiles
+ * that are queued for other consumers are unaffected.
+ */
+class LatestProfile {
+ public:
+  LatestProfile();
+
+  /**
+   * Enables keeping the newest profiles; must not be called while scanning.
+   */
+  void Enable();
+
+  /**
+   * Disables keeping the newest profiles; must not be called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if the newest profiles are kept, `false`
+   * otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Empties all slots, to be called before scanning starts.
+   */
+  void Reset();
+
+  /**
+   * Replaces the profile held for the camera and laser pair of a profile;
+   * must only be called from the receiver thread.
+   *
+   * @param profile The profile to keep.
+   */
+  void Store(Profile &profile);
+
+  /**
+   * Copies the profile held for a camera and laser pair.
+   *
+   * @param camera The camera of the profile.
+   * @param laser The laser of the profile.
+   * @param dst The raw profile to update, without its data format.
+   * @return Boolean `true` if a profile was copied, `false` if none was
+   * received since scanning started.
+   */
+  bool Load(jsCamera camera, jsLaser laser, jsRawProfile *dst) const;
+
+ private:
+  static const int kMaxSlots = JS_CAMERA_MAX * JS_LASER_MAX;
+
+  struct Slot {
+    // odd while the slot is being written; only ever advances, so a reader
+    // can't mistake a slot emptied and written again for an unchanged one
+    std::atomic<uint64_t> seq;
+    // guarded by the sequence like the profile
+    std::atomic<bool> is_empty;
+    jsRawProfile profile;
+  };
+
+  std::atomic<bool> is_enabled;
+  Slot slots[kMaxSlots];
+};
+} // namespace joescan
+
+#endif // JOESCAN_LATEST_PROFILE_H
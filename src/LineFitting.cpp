@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "LineFitting.hpp"
+
+using namespace joescan;
+
+static const jsRegion kAnyRegion = {std::numeric_limits<int32_t>::min(),
+                                    std::numeric_limits<int32_t>::max(),
+                                    std::numeric_limits<int32_t>::min(),
+                                    std::numeric_limits<int32_t>::max()};
+
+/**
+ * @brief Line through the centroid of a set of points along their principal
+ * axis, the least squares fit minimizing perpendicular distance.
+ */
+struct FittedLine {
+  double x;
+  double y;
+  double dir_x;
+  double dir_y;
+  double mean_sq_error;
+};
+
+static FittedLine LineFromMoments(const int64_t sums[6])
+{
+  FittedLine line;
+  double n = static_cast<double>(sums[0]);
+
+  line.x = sums[1] / n;
+  line.y = sums[2] / n;
+
+  double cxx = sums[3] / n - line.x * line.x;
+  double cyy = sums[4] / n - line.y * line.y;
+  double cxy = sums[5] / n - line.x * line.y;
+
+  // the direction is the eigenvector of the covariance matrix with the
+  // greatest eigenvalue, the least eigenvalue is the mean squared distance
+  double theta = 0.5 * std::atan2(2.0 * cxy, cxx - cyy);
+  double half_diff = 0.5 * (cxx - cyy);
+  double root = std::sqrt(half_diff * half_diff + cxy * cxy);
+
+  line.dir_x = std::cos(theta);
+  line.dir_y = std::sin(theta);
+  line.mean_sq_error = std::max(0.0, 0.5 * (cxx + cyy) - root);
+
+  return line;
+}
+
+static void SetInvalid(jsLineSegment *segment, uint32_t num_points)
+{
+  double nan = std::numeric_limits<double>::quiet_NaN();
+
+  segment->x0 = nan;
+  segment->y0 = nan;
+  segment->x1 = nan;
+  segment->y1 = nan;
+  segment->rms_error = nan;
+  segment->num_points = num_points;
+}
+
+/**
+ * Sets a segment from a fitted line, spanning the projections of the first
+ * and last points and directed from the first towards the last.
+ */
+static void SetSegment(const FittedLine &line, const jsProfileData &first,
+                       const jsProfileData &last, uint32_t num_points,
+                       jsLineSegment *segment)
+{
+  double t0 = (first.x - line.x) * line.dir_x + (first.y - line.y) * line.dir_y;
+  double t1 = (last.x - line.x) * line.dir_x + (last.y - line.y) * line.dir_y;
+
+  segment->x0 = line.x + t0 * line.dir_x;
+  segment->y0 = line.y + t0 * line.dir_y;
+  segment->x1 = line.x + t1 * line.dir_x;
+  segment->y1 = line.y + t1 * line.dir_y;
+  segment->rms_error = std::sqrt(line.mean_sq_error);
+  segment->num_points = num_points;
+}
+
+static inline bool InRegion(const jsProfileData &p, const jsRegion &region)
+{
+  return (p.x >= region.x_min) && (p.x <= region.x_max) &&
+         (p.y >= region.y_min) && (p.y <= region.y_max);
+}
+
+static double DistanceToChord(const jsProfileData &a, const jsProfileData &b,
+                              const jsProfileData &p)
+{
+  double dx = static_cast<double>(b.x) - a.x;
+  double dy = static_cast<double>(b.y) - a.y;
+  double px = static_cast<double>(p.x) - a.x;
+  double py = static_cast<double>(p.y) - a.y;
+  double len = std::sqrt(dx * dx + dy * dy);
+
+  if (0.0 == len) {
+    return std::sqrt(px * px + py * py);
+  }
+
+  return std::fabs(dx * py - dy * px) / len;
+}
+
+/**
+ * Tests if all points of a range lie within the tolerance of the least
+ * squares line fitted to them.
+ */
+static bool FitsLine(const ReductionKernels &kernels,
+                     const jsProfileData *data, uint32_t len,
+                     double tolerance)
+{
+  int64_t sums[6] = {0, 0, 0, 0, 0, 0};
+  kernels.sum_moments(data, len, kAnyRegion, sums);
+  FittedLine line = LineFromMoments(sums);
+
+  double normal_x = -line.dir_y;
+  double normal_y = line.dir_x;
+  double offset = normal_x * line.x + normal_y * line.y;
+  uint32_t count = kernels.count_near_line(data, len, normal_x, normal_y,
+                                           offset, tolerance);
+
+  return count == len;
+}
+
+void joescan::FitLine(const ReductionKernels &kernels,
+                      const jsProfileData *data, uint32_t len,
+                      const jsRegion &region, jsLineSegment *line)
+{
+  int64_t sums[6] = {0, 0, 0, 0, 0, 0};
+  kernels.sum_moments(data, len, region, sums);
+
+  uint32_t num_points = static_cast<uint32_t>(sums[0]);
+  if (2 > num_points) {
+    SetInvalid(line, num_points);
+    return;
+  }
+
+  uint32_t first = 0;
+  while (!InRegion(data[first], region)) {
+    first++;
+  }
+
+  uint32_t last = len - 1;
+  while (!InRegion(data[last], region)) {
+    last--;
+  }
+
+  SetSegment(LineFromMoments(sums), data[first], data[last], num_points, line);
+}
+
+uint32_t joescan::FitSegments(const ReductionKernels &kernels,
+                              const jsProfileData *data, uint32_t len,
+                              double tolerance, jsLineSegment *segments,
+                              uint32_t max_segments)
+{
+  if (2 > len) {
+    return 0;
+  }
+
+  // split, pieces share their end points and are found in profile order
+  std::vector<std::pair<uint32_t, uint32_t>> pieces;
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  stack.push_back(std::make_pair(0, len - 1));
+
+  while (!stack.empty()) {
+    uint32_t a = stack.back().first;
+    uint32_t b = stack.back().second;
+    stack.pop_back();
+
+    uint32_t farthest = a;
+    double max_distance = 0.0;
+    for (uint32_t n = a + 1; n < b; n++) {
+      double d = DistanceToChord(data[a], data[b], data[n]);
+      if (d > max_distance) {
+        max_distance = d;
+        farthest = n;
+      }
+    }
+
+    if (max_distance > tolerance) {
+      stack.push_back(std::make_pair(farthest, b));
+      stack.push_back(std::make_pair(a, farthest));
+    } else {
+      pieces.push_back(std::make_pair(a, b));
+    }
+  }
+
+  // merge
+  uint32_t num_segments = 0;
+  uint32_t a = pieces[0].first;
+  uint32_t b = pieces[0].second;
+
+  for (size_t n = 1; n <= pieces.size(); n++) {
+    if ((n < pieces.size()) &&
+        FitsLine(kernels, &data[a], pieces[n].second - a + 1, tolerance)) {
+      b = pieces[n].second;
+      continue;
+    }
+
+    if (num_segments < max_segments) {
+      int64_t sums[6] = {0, 0, 0, 0, 0, 0};
+      kernels.sum_moments(&data[a], b - a + 1, kAnyRegion, sums);
+      SetSegment(LineFromMoments(sums), data[a], data[b], b - a + 1,
+                 &segments[num_segments]);
+    }
+    num_segments++;
+
+    if (n < pieces.size()) {
+      a = pieces[n].first;
+      b = pieces[n].second;
+    }
+  }
+
+  return num_segments;
+}
+
+void joescan::FindLine(const ReductionKernels &kernels,
+                       const jsProfileData *data, uint32_t len,
+                       double tolerance, uint32_t iterations,
+                       jsLineSegment *line)
+{
+  if (2 > len) {
+    SetInvalid(line, len);
+    return;
+  }
+
+  uint32_t best_count = 0;
+  double best_normal_x = 0.0;
+  double best_normal_y = 0.0;
+  double best_offset = 0.0;
+  // xorshift, seeded the same every call so results are repeatable
+  uint32_t state = 0x9E3779B9;
+
+  for (uint32_t i = 0; (i < iterations) && (best_count < len); i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    uint32_t m = state % len;
+    uint32_t n = (state / len) % (len - 1);
+    n = (n >= m) ? n + 1 : n;
+
+    double dx = static_cast<double>(data[n].x) - data[m].x;
+    double dy = static_cast<double>(data[n].y) - data[m].y;
+    double d = std::sqrt(dx * dx + dy * dy);
+    if (0.0 == d) {
+      continue;
+    }
+
+    double normal_x = -dy / d;
+    double normal_y = dx / d;
+    double offset = normal_x * data[m].x + normal_y * data[m].y;
+    uint32_t count = kernels.count_near_line(data, len, normal_x, normal_y,
+                                             offset, tolerance);
+    if (count > best_count) {
+      best_count = count;
+      best_normal_x = normal_x;
+      best_normal_y = normal_y;
+      best_offset = offset;
+    }
+  }
+
+  if (2 > best_count) {
+    SetInvalid(line, 0);
+    return;
+  }
+
+  // refit to the points found to be part of the line
+  int64_t sums[6] = {0, 0, 0, 0, 0, 0};
+  uint32_t first = len;
+  uint32_t last = 0;
+  for (uint32_t n = 0; n < len; n++) {
+    // tested through the kernel so the points match those counted above
+    uint32_t near =
+      kernels.count_near_line(&data[n], 1, best_normal_x, best_normal_y,
+                              best_offset, tolerance);
+    if (0 == near) {
+      continue;
+    }
+
+    int64_t x = data[n].x;
+    int64_t y = data[n].y;
+    sums[0] += 1;
+    sums[1] += x;
+    sums[2] += y;
+    sums[3] += x * x;
+    sums[4] += y * y;
+    sums[5] += x * y;
+    first = (len == first) ? n : first;
+    last = n;
+  }
+
+  SetSegment(LineFromMoments(sums), data[first], data[last], best_count,
+             line);
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_LINE_FITTING_H
+#define JOESCAN_LINE_FITTING_H
+
+#include <cstdint>
+
+#include "ReductionKernels.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * Fits a line to the points within a region by least squares, minimizing the
+ * perpendicular distance of the points to the line. Costs a single pass over
+ * the array.
+ *
+ * @param kernels The reduction kernels to use.
+ * @param data The array of valid points.
+ * @param len The length of the array.
+ * @param region The region to consider points within.
+ * @param line Updated with the fitted line; its end points are the
+ * projections of the first and last points within the region.
+ */
+void FitLine(const ReductionKernels &kernels, const jsProfileData *data,
+             uint32_t len, const jsRegion &region, jsLineSegment *line);
+
+/**
+ * Simplifies the points to a sequence of line segments by split and merge.
+ * The points are first split recursively at the point farthest from the
+ * chord joining the ends of each piece, until no point is farther than the
+ * tolerance; neighboring pieces are then merged while a least squares line
+ * fitted to both keeps all of their points within the tolerance. Costs
+ * O(n * k) for `n` points and `k` segments before merging.
+ *
+ * @param kernels The reduction kernels to use.
+ * @param data The array of valid points, in profile order.
+ * @param len The length of the array.
+ * @param tolerance The greatest distance of a point from its segment.
+ * @param segments Array to be updated with the segments found.
+ * @param max_segments The length of the `segments` array.
+ * @return The number of segments found, which may be greater than
+ * `max_segments`; only the first `max_segments` are written.
+ */
+uint32_t FitSegments(const ReductionKernels &kernels,
+                     const jsProfileData *data, uint32_t len,
+                     double tolerance, jsLineSegment *segments,
+                     uint32_t max_segments);
+
+/**
+ * Finds the line passing within the tolerance of the most points by random
+ * sample consensus, then refits it to those points by least squares. The
+ * random sampling is seeded the same for every call so the result for a
+ * given array is repeatable. Costs O(n * iterations) for `n` points.
+ *
+ * @param kernels The reduction kernels to use.
+ * @param data The array of valid points.
+ * @param len The length of the array.
+ * @param tolerance The greatest distance of a point from the line for it to
+ * be considered part of the line.
+ * @param iterations The number of candidate lines to try.
+ * @param line Updated with the line found; its end points are the
+ * projections of the first and last points that are part of the line.
+ */
+void FindLine(const ReductionKernels &kernels, const jsProfileData *data,
+              uint32_t len, double tolerance, uint32_t iterations,
+              jsLineSegment *line);
+} // namespace joescan
+
+#endif // JOESCAN_LINE_FITTING_H
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "MappingTable.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace joescan;
+
+MappingTable::MappingTable()
+{
+  memset(&info, 0, sizeof(info));
+}
+
+void MappingTable::Set(const jsMappingTable &table, const float *x,
+                       const float *y)
+{
+  uint32_t n = table.num_columns * table.num_rows;
+
+  info = table;
+  this->x.assign(x, x + n);
+  this->y.assign(y, y + n);
+}
+
+bool MappingTable::IsLoaded() const
+{
+  return !x.empty();
+}
+
+jsMappingTable MappingTable::GetInfo() const
+{
+  return info;
+}
+
+uint32_t MappingTable::Get(float *x, float *y, uint32_t max_entries) const
+{
+  uint32_t n = std::min(max_entries, static_cast<uint32_t>(this->x.size()));
+
+  std::copy(this->x.begin(), this->x.begin() + n, x);
+  std::copy(this->y.begin(), this->y.begin() + n, y);
+
+  return n;
+}
+
+MappingTableLookup MappingTable::GetLookup() const
+{
+  MappingTableLookup lookup;
+
+  lookup.x = x.data();
+  lookup.y = y.data();
+  lookup.num_columns = info.num_columns;
+  lookup.num_rows = info.num_rows;
+  lookup.row_scale =
+    1.0f / static_cast<float>(info.row_step << kSubpixelFractionBits);
+
+  return lookup;
+}
+
+bool MappingTable::IsValid(const jsMappingTable &table)
+{
+  return (0 < table.num_columns) &&
+         (JS_CAMERA_IMAGE_DATA_MAX_WIDTH >= table.num_columns) &&
+         (2 <= table.num_rows) &&
+         (JS_CAMERA_IMAGE_DATA_MAX_HEIGHT >= table.num_rows) &&
+         (0 < table.row_step) &&
+         (JS_CAMERA_IMAGE_DATA_MAX_HEIGHT >= table.row_step);
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_MAPPING_TABLE_H
+#define JOESCAN_MAPPING_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/// Subpixel value sent for a column without a laser line.
+static const uint16_t kInvalidSubpixel = 0xFFFF;
+/// The number of fractional bits of a subpixel value.
+static const int kSubpixelFractionBits = 5;
+
+/**
+ * @brief The view of a mapping table used by the decode kernels.
+ */
+struct MappingTableLookup {
+  const float *x;
+  const float *y;
+  uint32_t num_columns;
+  uint32_t num_rows;
+  // converts a subpixel value to a row of the table
+  float row_scale;
+};
+
+/**
+ * @brief Holds the mapping table of a camera, used to compute the camera
+ * coordinates of the laser line from its subpixel row in each column. Set
+ * only while not scanning and read by the receiver thread while scanning.
+ */
+class MappingTable {
+ public:
+  MappingTable();
+
+  /**
+   * Replaces the table; must not be called while scanning.
+   *
+   * @param table The description of the table, assumed to be valid.
+   * @param x The `num_columns * num_rows` X entries of the table.
+   * @param y The `num_columns * num_rows` Y entries of the table.
+   */
+  void Set(const jsMappingTable &table, const float *x, const float *y);
+
+  /**
+   * @return Boolean `true` if a table is set, `false` otherwise.
+   */
+  bool IsLoaded() const;
+
+  /**
+   * @return The description of the table, with dimensions of `0` if none is
+   * set.
+   */
+  jsMappingTable GetInfo() const;
+
+  /**
+   * Copies out the entries of the table.
+   *
+   * @param x Array to be updated with the X entries.
+   * @param y Array to be updated with the Y entries.
+   * @param max_entries The maximum number of entries to copy to each array.
+   * @return The number of entries copied to each array.
+   */
+  uint32_t Get(float *x, float *y, uint32_t max_entries) const;
+
+  /**
+   * @return The view of the table for the decode kernels; only valid while
+   * the table is set and unchanged.
+   */
+  MappingTableLookup GetLookup() const;
+
+  /**
+   * Checks that the description of a table is within the supported range.
+   *
+   * @param table The description of the table.
+   * @return Boolean `true` if the table is valid, `false` otherwise.
+   */
+  static bool IsValid(const jsMappingTable &table);
+
+ private:
+  jsMappingTable info;
+  std::vector<float> x;
+  std::vector<float> y;
+};
+} // namespace joescan
+
+#endif // JOESCAN_MAPPING_TABLE_H
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_MESSAGE_SCHEMA_H
+#define JOESCAN_MESSAGE_SCHEMA_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
+#include "NetworkTypes.hpp"
+
+/**
+ * Declares a field of a message schema stored in member `m` of class `c`, in
+ * network byte order with the size of the member.
+ */
+#define SCHEMA_FIELD(c, m) joescan::SchemaField<c, decltype(c::m), &c::m>
+
+/**
+ * Declares a field of a message schema stored in member `m` of class `c`, in
+ * network byte order with the size of integral type `w`; used for members
+ * that are enums or wider than the protocol field.
+ */
+#define SCHEMA_WIRE_FIELD(c, m, w)                                            \
+  joescan::SchemaField<c, decltype(c::m), &c::m, w>
+
+namespace joescan {
+inline uint8_t ByteSwap(uint8_t value)
+{
+  return value;
+}
+
+inline uint16_t ByteSwap(uint16_t value)
+{
+#ifdef _MSC_VER
+  return _byteswap_ushort(value);
+#else
+  return __builtin_bswap16(value);
+#endif
+}
+
+inline uint32_t ByteSwap(uint32_t value)
+{
+#ifdef _MSC_VER
+  return _byteswap_ulong(value);
+#else
+  return __builtin_bswap32(value);
+#endif
+}
+
+inline uint64_t ByteSwap(uint64_t value)
+{
+#ifdef _MSC_VER
+  return _byteswap_uint64(value);
+#else
+  return __builtin_bswap64(value);
+#endif
+}
+
+/**
+ * Converts an integer between host and network byte order; the conversion
+ * is its own inverse.
+ */
+template <typename T>
+inline T NetworkOrder(T value)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  return value;
+#else
+  typedef typename std::make_unsigned<T>::type U;
+  return static_cast<T>(ByteSwap(static_cast<U>(value)));
+#endif
+}
+
+/**
+ * Stores an integer in network byte order at a possibly unaligned address.
+ */
+template <typename T>
+inline void StoreNetwork(uint8_t *buf, T value)
+{
+  value = NetworkOrder(value);
+  memcpy(buf, &value, sizeof(T));
+}
+
+/**
+ * Loads an integer in network byte order from a possibly unaligned address.
+ */
+template <typename T>
+inline T LoadNetwork(const uint8_t *buf)
+{
+  T value;
+  memcpy(&value, buf, sizeof(T));
+  return NetworkOrder(value);
+}
+
+/**
+ * @brief Describes one field of a message: the member of class `C` holding
+ * it and the integral type `W` it is sent as. Members that are not integral
+ * are expected to be `BETTER_ENUM` types.
+ */
+template <typename C, typename T, T C::*M, typename W = T>
+struct SchemaField {
+  static constexpr uint32_t kSize = sizeof(W);
+
+  static void Write(const C &c, uint8_t *buf)
+  {
+    StoreNetwork<W>(buf, ToWire(c.*M));
+  }
+
+  static void Read(C &c, const uint8_t *buf)
+  {
+    c.*M = FromWire<T>(LoadNetwork<W>(buf));
+  }
+
+ private:
+  template <typename V>
+  static typename std::enable_if<std::is_integral<V>::value, W>::type ToWire(
+    const V &v)
+  {
+    return static_cast<W>(v);
+  }
+
+  template <typename V>
+  static typename std::enable_if<!std::is_integral<V>::value, W>::type
+  ToWire(const V &v)
+  {
+    return static_cast<W>(v._to_integral());
+  }
+
+  template <typename V>
+  static typename std::enable_if<std::is_integral<V>::value, V>::type
+  FromWire(W w)
+  {
+    return static_cast<V>(w);
+  }
+
+  template <typename V>
+  static typename std::enable_if<!std::is_integral<V>::value, V>::type
+  FromWire(W w)
+  {
+    return V::_from_integral(w);
+  }
+};
+
+/**
+ * @brief Describes `N` unused bytes of a message, sent as zero and ignored
+ * when read.
+ */
+template <uint32_t N>
+struct SchemaPadding {
+  static constexpr uint32_t kSize = N;
+
+  template <typename C>
+  static void Write(const C &, uint8_t *buf)
+  {
+    memset(buf, 0, N);
+  }
+
+  template <typename C>
+  static void Read(C &, const uint8_t *)
+  {
+  }
+};
+
+/**
+ * @brief Describes the fixed layout of a message as a sequence of fields. The
+ * size and the offset of each field are computed at compile time, so reading
+ * and writing a message unrolls to a series of stores and loads into a
+ * buffer of at least `kSize` bytes; both return the position just past the
+ * fields, where any variable length data follows.
+ */
+template <typename... Fields>
+struct MessageSchema;
+
+template <>
+struct MessageSchema<> {
+  static constexpr uint32_t kSize = 0;
+
+  template <typename C>
+  static uint8_t *Write(const C &, uint8_t *buf)
+  {
+    return buf;
+  }
+
+  template <typename C>
+  static const uint8_t *Read(C &, const uint8_t *buf)
+  {
+    return buf;
+  }
+};
+
+template <typename F, typename... Rest>
+struct MessageSchema<F, Rest...> {
+  static constexpr uint32_t kSize = F::kSize + MessageSchema<Rest...>::kSize;
+
+  template <typename C>
+  static uint8_t *Write(const C &c, uint8_t *buf)
+  {
+    F::Write(c, buf);
+    return MessageSchema<Rest...>::Write(c, buf + F::kSize);
+  }
+
+  template <typename C>
+  static const uint8_t *Read(C &c, const uint8_t *buf)
+  {
+    F::Read(c, buf);
+    return MessageSchema<Rest...>::Read(c, buf + F::kSize);
+  }
+};
+
+/// The header that starts every message that is not profile data.
+typedef MessageSchema<SCHEMA_FIELD(InfoHeader, magic),
+                      SCHEMA_FIELD(InfoHeader, size),
+                      SCHEMA_FIELD(InfoHeader, type)>
+  InfoHeaderSchema;
+} // namespace joescan
+
+#endif // JOESCAN_MESSAGE_SCHEMA_H
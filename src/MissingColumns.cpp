@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "MissingColumns.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace joescan;
+
+static bool _is_missing(const jsMissingColumns &missing, uint32_t column)
+{
+  return 0 != (missing.mask[column >> 3] & (1 << (column & 7)));
+}
+
+static int32_t _lerp(int32_t a, int32_t b, double t)
+{
+  return static_cast<int32_t>(std::lround(a + (b - a) * t));
+}
+
+std::vector<uint16_t> joescan::FindMissingColumns(
+  const std::vector<bool> &parts_received, uint32_t start_column,
+  uint32_t end_column, uint32_t step)
+{
+  std::vector<uint16_t> columns;
+  uint32_t num_parts = static_cast<uint32_t>(parts_received.size());
+
+  if ((0 == step) || (0 == num_parts) || (end_column < start_column)) {
+    return columns;
+  }
+
+  uint32_t num_vals = (end_column - start_column + 1) / step;
+  for (uint32_t p = 0; p < num_parts; p++) {
+    if (parts_received[p]) {
+      continue;
+    }
+
+    for (uint32_t v = p; v < num_vals; v += num_parts) {
+      uint32_t column = start_column + v * step;
+      if (JS_RAW_PROFILE_DATA_LEN > column) {
+        columns.push_back(static_cast<uint16_t>(column));
+      }
+    }
+  }
+
+  std::sort(columns.begin(), columns.end());
+  return columns;
+}
+
+uint32_t joescan::InterpolateMissingColumns(jsRawProfile *profile,
+                                            const jsMissingColumns &missing,
+                                            uint32_t stride, uint32_t max_gap)
+{
+  jsProfileData *data = profile->data;
+  uint32_t len = std::min(profile->data_len,
+                          static_cast<uint32_t>(JS_RAW_PROFILE_DATA_LEN));
+  uint32_t filled = 0;
+
+  if (0 == missing.num_missing) {
+    return 0;
+  }
+
+  for (uint32_t c = stride; c < len; c++) {
+    // only look at the first column of each run
+    if (!_is_missing(missing, c) || _is_missing(missing, c - stride)) {
+      continue;
+    }
+
+    uint32_t last = c;
+    while ((last + stride < len) && _is_missing(missing, last + stride)) {
+      last += stride;
+    }
+
+    uint32_t before = c - stride;
+    uint32_t after = last + stride;
+    uint32_t run = (last - c) / stride + 1;
+    if ((run > max_gap) || (after >= len) ||
+        (JS_PROFILE_DATA_INVALID_XY == data[before].x) ||
+        (JS_PROFILE_DATA_INVALID_XY == data[after].x)) {
+      continue;
+    }
+
+    const jsProfileData &a = data[before];
+    const jsProfileData &b = data[after];
+    bool is_brightness = (JS_PROFILE_DATA_INVALID_BRIGHTNESS != a.brightness) &&
+                         (JS_PROFILE_DATA_INVALID_BRIGHTNESS != b.brightness);
+
+    for (uint32_t k = 1; k <= run; k++) {
+      jsProfileData &d = data[before + k * stride];
+      double t = static_cast<double>(k) / (run + 1);
+
+      if (JS_PROFILE_DATA_INVALID_XY == d.x) {
+        profile->data_valid_xy++;
+      }
+      d.x = _lerp(a.x, b.x, t);
+      d.y = _lerp(a.y, b.y, t);
+
+      if (is_brightness) {
+        if (JS_PROFILE_DATA_INVALID_BRIGHTNESS == d.brightness) {
+          profile->data_valid_brightness++;
+        }
+        d.brightness = _lerp(a.brightness, b.brightness, t);
+      }
+    }
+    filled += run;
+  }
+
+  return filled;
+}
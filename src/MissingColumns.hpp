@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_MISSING_COLUMNS_H
+#define JOESCAN_MISSING_COLUMNS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * Finds the columns of a profile carried by datagrams that were not received.
+ * The values of a profile are dealt out to its datagrams in turn, so datagram
+ * `p` of `n` carries every `n`th value starting with value `p`.
+ *
+ * @param parts_received For each datagram of the profile, `true` if it was
+ * received.
+ * @param start_column The first column of the profile.
+ * @param end_column The last column of the profile, inclusive.
+ * @param step The number of columns between consecutive values.
+ * @return The missing columns in ascending order.
+ */
+std::vector<uint16_t> FindMissingColumns(
+  const std::vector<bool> &parts_received, uint32_t start_column,
+  uint32_t end_column, uint32_t step);
+
+/**
+ * Fills runs of missing columns by linear interpolation between the valid
+ * columns on either side of each run, leaving runs that are too long or that
+ * border an invalid column in place. Only columns marked missing are written.
+ *
+ * @param profile The raw profile to repair.
+ * @param missing The missing columns of the profile.
+ * @param stride The number of columns between values of the data format.
+ * @param max_gap The longest run of missing values to fill.
+ * @return The number of columns filled.
+ */
+uint32_t InterpolateMissingColumns(jsRawProfile *profile,
+                                   const jsMissingColumns &missing,
+                                   uint32_t stride, uint32_t max_gap);
+} // namespace joescan
+
+#endif // JOESCAN_MISSING_COLUMNS_H
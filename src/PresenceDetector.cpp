@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "PresenceDetector.hpp"
+#include "ReductionKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace joescan;
+
+static int _source_index(jsCamera camera, jsLaser laser)
+{
+  return static_cast<int>(camera) * JS_LASER_MAX + static_cast<int>(laser);
+}
+
+PresenceDetector::PresenceDetector()
+  : is_enabled(false),
+    events(JS_PIECE_EVENTS_MAX)
+{
+  memset(&config, 0, sizeof(config));
+  Reset();
+}
+
+void PresenceDetector::Enable(const jsPresenceConfig &config)
+{
+  this->config = config;
+  Reset();
+  is_enabled = true;
+}
+
+void PresenceDetector::Disable()
+{
+  is_enabled = false;
+}
+
+bool PresenceDetector::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void PresenceDetector::Reset()
+{
+  state = PRESENCE_IDLE;
+  piece_id = 0;
+  num_absent = 0;
+  num_piece_profiles = 0;
+  last_present = nullptr;
+  pending.clear();
+  std::fill(is_source_present, is_source_present + kMaxSources, false);
+
+  std::lock_guard<std::mutex> lock(events_lock);
+  events.clear();
+}
+
+void PresenceDetector::Process(uint32_t scan_head_id,
+                               std::shared_ptr<Profile> profile,
+                               std::vector<std::shared_ptr<Profile>> &released)
+{
+  released.clear();
+
+  jsCamera camera = profile->GetCamera();
+  jsLaser laser = profile->GetLaser();
+  bool is_seen = IsPresent(*profile);
+  if ((JS_CAMERA_MAX > camera) && (JS_LASER_MAX > laser)) {
+    is_source_present[_source_index(camera, laser)] = is_seen;
+  }
+  if (is_seen) {
+    last_present = profile;
+  }
+
+  bool is_present = is_seen ||
+                    std::any_of(is_source_present,
+                                is_source_present + kMaxSources,
+                                [](bool b) { return b; });
+
+  if (PRESENCE_IDLE == state) {
+    if (is_present) {
+      pending.push_back(profile);
+      if (config.start_count <= pending.size()) {
+        piece_id++;
+        state = PRESENCE_PIECE;
+        num_absent = 0;
+        num_piece_profiles = static_cast<uint32_t>(pending.size());
+        AddEvent(JS_PIECE_EVENT_START, scan_head_id, *pending.front(), 0);
+
+        for (auto &p : pending) {
+          p->SetPieceId(piece_id);
+        }
+        released.swap(pending);
+      }
+    } else {
+      // too few profiles in a row saw something to start a piece
+      if (!config.suppress_empty) {
+        released.swap(pending);
+        released.push_back(profile);
+      }
+      pending.clear();
+    }
+  } else {
+    if (is_present) {
+      num_absent = 0;
+    } else if (config.end_count <= ++num_absent) {
+      AddEvent(JS_PIECE_EVENT_END, scan_head_id, *last_present,
+               num_piece_profiles);
+      state = PRESENCE_IDLE;
+      last_present = nullptr;
+
+      if (!config.suppress_empty) {
+        released.push_back(profile);
+      }
+      return;
+    }
+
+    // gaps shorter than the end count belong to the piece
+    profile->SetPieceId(piece_id);
+    num_piece_profiles++;
+    released.push_back(profile);
+  }
+}
+
+uint64_t PresenceDetector::Release(
+  std::vector<std::shared_ptr<Profile>> &released)
+{
+  uint64_t timestamp = pending.empty() ? 0 : pending.back()->GetTimestamp();
+
+  released.clear();
+  if (!config.suppress_empty) {
+    released.swap(pending);
+  }
+  pending.clear();
+
+  return timestamp;
+}
+
+uint32_t PresenceDetector::PopEvents(jsPieceEvent *events,
+                                     uint32_t max_events)
+{
+  std::lock_guard<std::mutex> lock(events_lock);
+  uint32_t n = std::min(max_events, static_cast<uint32_t>(this->events.size()));
+
+  std::copy(this->events.begin(), this->events.begin() + n, events);
+  this->events.erase_begin(n);
+
+  return n;
+}
+
+bool PresenceDetector::GetPendingTimestamp(uint64_t *timestamp) const
+{
+  if (pending.empty()) {
+    return false;
+  }
+
+  *timestamp = pending.front()->GetTimestamp();
+  return true;
+}
+
+bool PresenceDetector::IsPresent(Profile &profile) const
+{
+  uint32_t num_valid = profile.GetNumberValidGeometry();
+
+  if (config.min_valid_points > num_valid) {
+    return false;
+  } else if (0 == config.min_region_points) {
+    return true;
+  } else if (config.min_region_points > num_valid) {
+    return false;
+  }
+
+  // the bounding box gathered while decoding rules out most empty profiles
+  // without touching the data
+  const jsRegion &region = config.region;
+  ProfileSummary *summary = profile.GetSummaryPointer();
+  if ((summary->x_max < region.x_min) || (summary->x_min > region.x_max) ||
+      (summary->y_max < region.y_min) || (summary->y_min > region.y_max)) {
+    return false;
+  }
+
+  const ReductionKernels &kernels = GetReductionKernels();
+  uint32_t len = profile.GetDataLength();
+  uint32_t count = kernels.count(profile.GetDataPointer(), len, region);
+
+  // the data array is not compacted, its invalid entries all lie at the
+  // invalid X/Y value and are counted if the region holds it
+  if ((JS_PROFILE_DATA_INVALID_XY >= region.x_min) &&
+      (JS_PROFILE_DATA_INVALID_XY <= region.x_max) &&
+      (JS_PROFILE_DATA_INVALID_XY >= region.y_min) &&
+      (JS_PROFILE_DATA_INVALID_XY <= region.y_max)) {
+    count -= len - num_valid;
+  }
+
+  return config.min_region_points <= count;
+}
+
+void PresenceDetector::AddEvent(jsPieceEventType type, uint32_t scan_head_id,
+                                const Profile &profile, uint32_t num_profiles)
+{
+  jsPieceEvent event;
+  std::vector<int64_t> e = profile.GetEncoderValues();
+
+  event.type = type;
+  event.scan_head_id = scan_head_id;
+  event.piece_id = piece_id;
+  event.timestamp_ns = profile.GetTimestamp();
+  memset(event.encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
+  std::copy(e.begin(), e.end(), event.encoder_values);
+  event.num_encoder_values = static_cast<uint32_t>(e.size());
+  event.num_profiles = num_profiles;
+
+  std::lock_guard<std::mutex> lock(events_lock);
+  events.push_back(event);
+}
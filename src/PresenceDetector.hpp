@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_PRESENCE_DETECTOR_H
+#define JOESCAN_PRESENCE_DETECTOR_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "boost/circular_buffer.hpp"
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Segments the profiles of a scan head into pieces. Each profile is
+ * tested using the valid point count gathered while decoding it and, if a
+ * region is configured, a count of the points within it; pieces start and end
+ * after a configurable number of consecutive profiles with and without
+ * presence. The scan head is taken to see a piece while the latest profile
+ * of any of its cameras and lasers does, so that the profiles of sources
+ * that don't see the piece neither hold off its start nor end it early. Runs
+ * on the receiver thread before profiles are buffered.
+ */
+class PresenceDetector {
+ public:
+  PresenceDetector();
+
+  /**
+   * Enables presence detection; must not be called while scanning.
+   *
+   * @param config The presence detection settings.
+   */
+  void Enable(const jsPresenceConfig &config);
+
+  /**
+   * Disables presence detection; must not be called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if presence detection is enabled, `false`
+   * otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Clears the detector state and the events, to be called before scanning
+   * starts; profiles still held back are discarded, see `Release`.
+   */
+  void Reset();
+
+  /**
+   * Gives up on confirming a piece, such as when the scan head stopped
+   * scanning, releasing the profiles held back to confirm it as profiles
+   * outside of a piece.
+   *
+   * @param released Updated with the profiles ready to be buffered, in the
+   * order received; empty if none were held back or they are suppressed.
+   * @return The timestamp of the newest profile held back, `0` if none.
+   */
+  uint64_t Release(std::vector<std::shared_ptr<Profile>> &released);
+
+  /**
+   * Tests the next profile for presence, tagging it with its piece.
+   *
+   * @param scan_head_id The ID of the scan head the profile came from.
+   * @param profile The profile to test.
+   * @param released Updated with the profiles ready to be buffered, in the
+   * order received; empty while profiles are held back to confirm a piece or
+   * if the profile is suppressed.
+   */
+  void Process(uint32_t scan_head_id, std::shared_ptr<Profile> profile,
+               std::vector<std::shared_ptr<Profile>> &released);
+
+  /**
+   * Removes the oldest events.
+   *
+   * @param events Array to be filled with events.
+   * @param max_events The maximum number of events to remove.
+   * @return The number of events removed.
+   */
+  uint32_t PopEvents(jsPieceEvent *events, uint32_t max_events);
+
+  /**
+   * Obtains the timestamp of the oldest profile held back to confirm a piece.
+   *
+   * @param timestamp Updated with the timestamp, if a profile is held back.
+   * @return Boolean `true` if a profile is held back, `false` otherwise.
+   */
+  bool GetPendingTimestamp(uint64_t *timestamp) const;
+
+ private:
+  enum PresenceState {
+    PRESENCE_IDLE,
+    PRESENCE_PIECE,
+  };
+
+  static const int kMaxSources = JS_CAMERA_MAX * JS_LASER_MAX;
+
+  bool IsPresent(Profile &profile) const;
+  void AddEvent(jsPieceEventType type, uint32_t scan_head_id,
+                const Profile &profile, uint32_t num_profiles);
+
+  std::atomic<bool> is_enabled;
+  jsPresenceConfig config;
+
+  enum PresenceState state;
+  uint64_t piece_id;
+  uint32_t num_absent;
+  uint32_t num_piece_profiles;
+  // whether the latest profile of each source saw a piece
+  bool is_source_present[kMaxSources];
+  std::shared_ptr<Profile> last_present;
+  std::vector<std::shared_ptr<Profile>> pending;
+
+  std::mutex events_lock;
+  boost::circular_buffer<jsPieceEvent> events;
+};
+} // namespace joescan
+
+#endif // JOESCAN_PRESENCE_DETECTOR_H
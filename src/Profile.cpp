@@ -6,7 +6,9 @@
  */
 
 #include "Profile.hpp"
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 
 using namespace joescan;
@@ -23,8 +25,10 @@ Profile::Profile(DataType mask)
   num_valid_geometry = 0;
   scan_head = 0;
   timestamp = 0;
+  piece_id = 0;
   udp_packets_expected = 0;
   udp_packets_received = 0;
+  memset(&kinematics, 0, sizeof(kinematics));
 
   if (mask & DataType::Image) {
     image.resize(kMaxColumns * kMaxRows, 0);
@@ -33,7 +37,9 @@ Profile::Profile(DataType mask)
     image_size = static_cast<uint32_t>(image.size());
   }
 
-  if ((mask & DataType::Brightness) || (mask & DataType::XYData)) {
+  // subpixel data is mapped to X/Y data as it is decoded
+  if ((mask & DataType::Brightness) || (mask & DataType::XYData) ||
+      (mask & DataType::Subpixel)) {
     data.resize(kMaxColumns,
                 {
                   JS_PROFILE_DATA_INVALID_XY,         // x
@@ -44,11 +50,6 @@ Profile::Profile(DataType mask)
     // to std::vector size() function
     data_size = static_cast<uint32_t>(data.size());
   }
-
-  if (mask & DataType::Subpixel) {
-    // TODO: FKS-252
-    throw std::runtime_error("Subpixel DataType currently not supported.");
-  }
 }
 
 void Profile::SetScanHead(uint8_t scan_head)
@@ -71,6 +72,11 @@ void Profile::SetTimestamp(uint64_t timestamp)
   this->timestamp = timestamp;
 }
 
+void Profile::SetPieceId(uint64_t piece_id)
+{
+  this->piece_id = piece_id;
+}
+
 void Profile::SetEncoderValues(std::vector<int64_t> encoders)
 {
   if (JS_ENCODER_MAX <= encoders.size()) {
@@ -96,6 +102,20 @@ void Profile::SetUDPPacketInfo(uint32_t packets_received,
   udp_packets_received = packets_received;
 }
 
+void Profile::SetMissingColumns(std::vector<uint16_t> columns)
+{
+  missing_columns = std::move(columns);
+}
+
+void Profile::GetMissingColumns(jsMissingColumns *missing) const
+{
+  memset(missing->mask, 0, sizeof(missing->mask));
+  for (auto column : missing_columns) {
+    missing->mask[column >> 3] |= static_cast<uint8_t>(1 << (column & 7));
+  }
+  missing->num_missing = static_cast<uint32_t>(missing_columns.size());
+}
+
 std::pair<uint32_t, uint32_t> Profile::GetUDPPacketInfo()
 {
   std::pair<uint32_t, uint32_t> info;
@@ -147,11 +167,26 @@ uint64_t Profile::GetTimestamp() const
   return timestamp;
 }
 
+uint64_t Profile::GetPieceId() const
+{
+  return piece_id;
+}
+
 std::vector<int64_t> Profile::GetEncoderValues() const
 {
   return encoder_vals;
 }
 
+jsEncoderKinematics *Profile::GetKinematicsPointer()
+{
+  return &kinematics;
+}
+
+jsEncoderKinematics Profile::GetKinematics() const
+{
+  return kinematics;
+}
+
 uint32_t Profile::GetExposureTime() const
 {
   return exposure_time;
@@ -167,6 +202,146 @@ std::vector<jsProfileData> Profile::Data() const
   return data;
 }
 
+jsProfileData *Profile::GetDataPointer()
+{
+  return data.data();
+}
+
+const jsProfileData *Profile::GetDataPointer() const
+{
+  return data.data();
+}
+
+uint32_t Profile::GetDataLength() const
+{
+  return data_size;
+}
+
+void Profile::AddFloatData()
+{
+  float_x.assign(data_size, std::numeric_limits<float>::quiet_NaN());
+  float_y.assign(data_size, std::numeric_limits<float>::quiet_NaN());
+}
+
+bool Profile::HasFloatData() const
+{
+  return (0 != data_size) && (data_size == float_x.size());
+}
+
+float *Profile::GetFloatXPointer()
+{
+  return float_x.data();
+}
+
+const float *Profile::GetFloatXPointer() const
+{
+  return float_x.data();
+}
+
+float *Profile::GetFloatYPointer()
+{
+  return float_y.data();
+}
+
+const float *Profile::GetFloatYPointer() const
+{
+  return float_y.data();
+}
+
+ProfileSummary *Profile::GetSummaryPointer()
+{
+  return &summary;
+}
+
+jsProfileSummary Profile::GetSummary() const
+{
+  jsProfileSummary s;
+
+  if (0 == summary.num_valid) {
+    s.x_min = JS_PROFILE_DATA_INVALID_XY;
+    s.x_max = JS_PROFILE_DATA_INVALID_XY;
+    s.y_min = JS_PROFILE_DATA_INVALID_XY;
+    s.y_max = JS_PROFILE_DATA_INVALID_XY;
+    s.highest_x = JS_PROFILE_DATA_INVALID_XY;
+    s.highest_y = JS_PROFILE_DATA_INVALID_XY;
+    s.highest_brightness = JS_PROFILE_DATA_INVALID_XY;
+    s.centroid_x = JS_PROFILE_DATA_INVALID_XY;
+    s.centroid_y = JS_PROFILE_DATA_INVALID_XY;
+    s.num_valid = 0;
+    return s;
+  }
+
+  s.x_min = summary.x_min;
+  s.x_max = summary.x_max;
+  s.y_min = summary.y_min;
+  s.y_max = summary.y_max;
+  s.highest_x = summary.highest_x;
+  s.highest_y = summary.highest_y;
+  // brightness is decoded independently of X/Y, look it up once all of the
+  // profile's data has arrived
+  s.highest_brightness = data[summary.highest_idx].brightness;
+  s.centroid_x = static_cast<int32_t>(summary.sum_x / summary.num_valid);
+  s.centroid_y = static_cast<int32_t>(summary.sum_y / summary.num_valid);
+  s.num_valid = summary.num_valid;
+
+  return s;
+}
+
+void Profile::CopyTo(jsRawProfile *dst)
+{
+  dst->scan_head_id = scan_head;
+  dst->camera = camera;
+  dst->laser = laser;
+  dst->timestamp_ns = timestamp;
+  dst->laser_on_time_us = laser_on_time;
+  dst->udp_packets_received = udp_packets_received;
+  dst->udp_packets_expected = udp_packets_expected;
+
+  uint32_t n = std::min(static_cast<uint32_t>(encoder_vals.size()),
+                        static_cast<uint32_t>(JS_ENCODER_MAX));
+  memset(dst->encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
+  std::copy(encoder_vals.begin(), encoder_vals.begin() + n,
+            dst->encoder_values);
+  dst->num_encoder_values = n;
+
+  uint32_t len = std::min(data_size,
+                          static_cast<uint32_t>(JS_RAW_PROFILE_DATA_LEN));
+  memcpy(dst->data, data.data(), sizeof(jsProfileData) * len);
+  dst->data_len = len;
+  dst->summary = GetSummary();
+  dst->data_valid_brightness = num_valid_brightness;
+  dst->data_valid_xy = num_valid_geometry;
+  dst->piece_id = piece_id;
+}
+
+void Profile::AddValidGeometry(uint32_t n)
+{
+  num_valid_geometry += n;
+}
+
+void Profile::AddValidBrightness(uint32_t n)
+{
+  num_valid_brightness += n;
+}
+
+void Profile::RebuildSummary()
+{
+  summary = ProfileSummary();
+  num_valid_geometry = 0;
+  num_valid_brightness = 0;
+
+  for (uint32_t n = 0; n < data_size; n++) {
+    if ((JS_PROFILE_DATA_INVALID_XY != data[n].x) &&
+        (JS_PROFILE_DATA_INVALID_XY != data[n].y)) {
+      summary.Add(data[n].x, data[n].y, n);
+      num_valid_geometry++;
+    }
+    if (JS_PROFILE_DATA_INVALID_BRIGHTNESS != data[n].brightness) {
+      num_valid_brightness++;
+    }
+  }
+}
+
 std::vector<uint8_t> Profile::Image() const
 {
   return image;
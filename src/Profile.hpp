@@ -13,6 +13,7 @@
 
 #include "NetworkTypes.hpp"
 #include "Point2D.hpp"
+#include "ProfileSummary.hpp"
 #include "joescan_pinchot.h"
 
 namespace joescan {
@@ -53,6 +54,13 @@ class Profile {
    */
   void SetTimestamp(uint64_t timestamp);
 
+  /**
+   * Sets the piece the profile belongs to.
+   *
+   * @param piece_id The ID of the piece, `0` for none.
+   */
+  void SetPieceId(uint64_t piece_id);
+
   /**
    * Sets the encoder values associated with the given profile.
    *
@@ -83,6 +91,13 @@ class Profile {
    */
   void SetUDPPacketInfo(uint32_t packets_received, uint32_t packets_expected);
 
+  /**
+   * Sets the columns lost with datagrams that were not received.
+   *
+   * @param columns The missing columns.
+   */
+  void SetMissingColumns(std::vector<uint16_t> columns);
+
   /**
    * Inserts brightness measurement at a given position into the profile.
    *
@@ -153,6 +168,13 @@ class Profile {
    */
   uint64_t GetTimestamp() const;
 
+  /**
+   * Obtains the piece the profile belongs to.
+   *
+   * @return The ID of the piece, `0` for none.
+   */
+  uint64_t GetPieceId() const;
+
   /**
    * The encoder values associated with the given profile.
    *
@@ -160,6 +182,22 @@ class Profile {
    */
   std::vector<int64_t> GetEncoderValues() const;
 
+  /**
+   * Obtains direct access to the encoder kinematics of this profile, to be
+   * filled in as the profile is received.
+   *
+   * @return Pointer to the encoder kinematics.
+   */
+  jsEncoderKinematics *GetKinematicsPointer();
+
+  /**
+   * Obtains the encoder kinematics of this profile; `num_encoder_values` is
+   * zero if they were not computed.
+   *
+   * @return The encoder kinematics.
+   */
+  jsEncoderKinematics GetKinematics() const;
+
   /**
    * Obtains the camera exposure time for this profile in microseconds.
    *
@@ -183,6 +221,13 @@ class Profile {
    */
   std::pair<uint32_t, uint32_t> GetUDPPacketInfo();
 
+  /**
+   * Obtains the columns lost with datagrams that were not received.
+   *
+   * @param missing Updated with the bitmap of missing columns.
+   */
+  void GetMissingColumns(jsMissingColumns *missing) const;
+
   /**
    * Obtains the total number of valid brightness values in this profile.
    *
@@ -205,6 +250,97 @@ class Profile {
    */
   std::vector<jsProfileData> Data() const;
 
+  /**
+   * Obtains direct access to the profile data array, avoiding the copy made
+   * by `Data`. Not all entries are guaranteed to be valid.
+   *
+   * @return Pointer to the first entry of the profile data array.
+   */
+  jsProfileData *GetDataPointer();
+  const jsProfileData *GetDataPointer() const;
+
+  /**
+   * Obtains the number of entries in the profile data array.
+   *
+   * @return Length of the profile data array.
+   */
+  uint32_t GetDataLength() const;
+
+  /**
+   * Adds arrays of float X and Y values alongside the profile data array,
+   * filled with NaN, for the decode to write the float output to.
+   */
+  void AddFloatData();
+
+  /**
+   * @return Boolean `true` if the profile has float X and Y arrays, `false`
+   * otherwise.
+   */
+  bool HasFloatData() const;
+
+  /**
+   * Obtains direct access to the float X values, which are indexed like the
+   * profile data array; only valid if `HasFloatData` returns `true`.
+   *
+   * @return Pointer to the first float X value.
+   */
+  float *GetFloatXPointer();
+  const float *GetFloatXPointer() const;
+
+  /**
+   * Obtains direct access to the float Y values, which are indexed like the
+   * profile data array; only valid if `HasFloatData` returns `true`.
+   *
+   * @return Pointer to the first float Y value.
+   */
+  float *GetFloatYPointer();
+  const float *GetFloatYPointer() const;
+
+  /**
+   * Obtains direct access to the running summary of the profile, to be
+   * updated as X/Y geometry is written to the profile data array.
+   *
+   * @return Pointer to the running summary.
+   */
+  ProfileSummary *GetSummaryPointer();
+
+  /**
+   * Obtains the summary of the valid X/Y geometry in this profile.
+   *
+   * @return The profile summary.
+   */
+  jsProfileSummary GetSummary() const;
+
+  /**
+   * Copies this profile to the raw profile presented to the end user,
+   * leaving the data format unset as it is not known to the profile.
+   *
+   * @param dst The raw profile to update.
+   */
+  void CopyTo(jsRawProfile *dst);
+
+  /**
+   * Increments the count of valid X/Y geometry values after they have been
+   * written directly to the profile data array.
+   *
+   * @param n The number of valid X/Y geometry values added.
+   */
+  void AddValidGeometry(uint32_t n);
+
+  /**
+   * Increments the count of valid brightness values after they have been
+   * written directly to the profile data array.
+   *
+   * @param n The number of valid brightness values added.
+   */
+  void AddValidBrightness(uint32_t n);
+
+  /**
+   * Recomputes the summary and the counts of valid values from the profile
+   * data array, after its values have been changed in place.
+   */
+  void RebuildSummary();
+
   /**
    * For image mode, obtains all of the pixel data for a given profile.
    *
@@ -229,17 +365,25 @@ class Profile {
   jsCamera camera;
   jsLaser laser;
   uint64_t timestamp;
+  uint64_t piece_id;
   uint32_t udp_packets_expected;
   uint32_t udp_packets_received;
+  // empty unless datagrams were lost
+  std::vector<uint16_t> missing_columns;
   std::vector<int64_t> encoder_vals;
+  jsEncoderKinematics kinematics;
   uint32_t exposure_time;
   uint32_t laser_on_time;
   std::vector<jsProfileData> data;
+  // empty unless the scan head has float output enabled
+  std::vector<float> float_x;
+  std::vector<float> float_y;
   std::vector<uint8_t> image;
   uint32_t data_size;
   uint32_t image_size;
   uint32_t num_valid_geometry;
   uint32_t num_valid_brightness;
+  ProfileSummary summary;
 };
 
 /*
@@ -259,6 +403,7 @@ inline void Profile::InsertPoint(uint32_t idx, Point2D<int32_t> value)
   if (idx < data_size) {
     data[idx].x = value.x;
     data[idx].y = value.y;
+    summary.Add(value.x, value.y, idx);
     num_valid_geometry++;
   }
 }
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "ProfileHistory.hpp"
+
+#include <algorithm>
+
+using namespace joescan;
+
+static bool _is_older(const std::shared_ptr<Profile> &a,
+                      const std::shared_ptr<Profile> &b)
+{
+  return a->GetTimestamp() < b->GetTimestamp();
+}
+
+ProfileHistory::ProfileHistory() : is_enabled(false)
+{
+  config.max_profiles = 0;
+  config.max_age_ns = 0;
+}
+
+void ProfileHistory::Enable(const jsHistoryConfig &config)
+{
+  Reset();
+  this->config = config;
+  is_enabled = true;
+}
+
+void ProfileHistory::Disable()
+{
+  is_enabled = false;
+  Reset();
+}
+
+bool ProfileHistory::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void ProfileHistory::Reset()
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  profiles.clear();
+  for (auto &index : encoder_index) {
+    index.clear();
+  }
+}
+
+void ProfileHistory::Add(std::shared_ptr<Profile> profile)
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  // profiles are received in the order taken, whether the cameras expose in
+  // turn or together, so a profile is nearly always the newest and is
+  // appended
+  auto it = std::upper_bound(profiles.begin(), profiles.end(), profile,
+                             _is_older);
+  profiles.insert(it, profile);
+
+  std::vector<int64_t> e = profile->GetEncoderValues();
+  uint32_t n = std::min(static_cast<uint32_t>(e.size()),
+                        static_cast<uint32_t>(JS_ENCODER_MAX));
+  for (uint32_t i = 0; i < n; i++) {
+    encoder_index[i].insert(std::make_pair(e[i], profile));
+  }
+
+  Evict();
+}
+
+std::vector<std::shared_ptr<Profile>> ProfileHistory::GetByTime(
+  uint64_t min_ns, uint64_t max_ns, uint32_t max_profiles)
+{
+  std::vector<std::shared_ptr<Profile>> found;
+  std::lock_guard<std::mutex> lk(lock);
+
+  auto first = std::partition_point(
+    profiles.begin(), profiles.end(),
+    [min_ns](const std::shared_ptr<Profile> &p) {
+      return p->GetTimestamp() < min_ns;
+    });
+
+  for (auto it = first; (it != profiles.end()) && (found.size() < max_profiles);
+       ++it) {
+    if ((*it)->GetTimestamp() > max_ns) {
+      break;
+    }
+    found.push_back(*it);
+  }
+
+  return found;
+}
+
+std::vector<std::shared_ptr<Profile>> ProfileHistory::GetByEncoder(
+  jsEncoder encoder, int64_t min, int64_t max, uint32_t max_profiles)
+{
+  std::vector<std::shared_ptr<Profile>> found;
+  std::lock_guard<std::mutex> lk(lock);
+
+  if ((0 > encoder) || (JS_ENCODER_MAX <= encoder)) {
+    return found;
+  }
+
+  EncoderIndex &index = encoder_index[encoder];
+  auto first = index.lower_bound(min);
+  auto last = index.upper_bound(max);
+  for (auto it = first; it != last; ++it) {
+    found.push_back(it->second);
+  }
+
+  // an encoder may run backwards, the index order is not the time order
+  std::sort(found.begin(), found.end(), _is_older);
+  if (found.size() > max_profiles) {
+    found.resize(max_profiles);
+  }
+
+  return found;
+}
+
+void ProfileHistory::Evict()
+{
+  while (!profiles.empty()) {
+    const std::shared_ptr<Profile> &oldest = profiles.front();
+    uint64_t newest_ns = profiles.back()->GetTimestamp();
+    bool is_full = profiles.size() > config.max_profiles;
+    bool is_stale = (0 != config.max_age_ns) &&
+                    (newest_ns - oldest->GetTimestamp() > config.max_age_ns);
+
+    if (!is_full && !is_stale) {
+      break;
+    }
+
+    Remove(oldest);
+    profiles.pop_front();
+  }
+}
+
+void ProfileHistory::Remove(const std::shared_ptr<Profile> &profile)
+{
+  std::vector<int64_t> e = profile->GetEncoderValues();
+  uint32_t n = std::min(static_cast<uint32_t>(e.size()),
+                        static_cast<uint32_t>(JS_ENCODER_MAX));
+
+  for (uint32_t i = 0; i < n; i++) {
+    auto range = encoder_index[i].equal_range(e[i]);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == profile) {
+        encoder_index[i].erase(it);
+        break;
+      }
+    }
+  }
+}
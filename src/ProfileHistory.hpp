@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_PROFILE_HISTORY_H
+#define JOESCAN_PROFILE_HISTORY_H
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Retains the most recent profiles of a scan head after they have been
+ * read out, bounded by count and by age. The history holds references to the
+ * same profile objects that are buffered for reading, so retaining a profile
+ * copies nothing. Profiles are kept in timestamp order and indexed by the
+ * value of each encoder, so both kinds of range query are logarithmic.
+ */
+class ProfileHistory {
+ public:
+  ProfileHistory();
+
+  /**
+   * Enables retaining profiles; must not be called while scanning.
+   *
+   * @param config The bounds of the history.
+   */
+  void Enable(const jsHistoryConfig &config);
+
+  /**
+   * Disables retaining profiles and releases those retained; must not be
+   * called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if profiles are retained, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Releases all retained profiles, to be called before scanning starts.
+   */
+  void Reset();
+
+  /**
+   * Retains a profile, releasing the profiles beyond the bounds.
+   *
+   * @param profile The profile to retain.
+   */
+  void Add(std::shared_ptr<Profile> profile);
+
+  /**
+   * Finds the retained profiles with timestamps within a range.
+   *
+   * @param min_ns The least timestamp, inclusive.
+   * @param max_ns The greatest timestamp, inclusive.
+   * @param max_profiles The maximum number of profiles to return.
+   * @return The oldest matching profiles in timestamp order.
+   */
+  std::vector<std::shared_ptr<Profile>> GetByTime(uint64_t min_ns,
+                                                  uint64_t max_ns,
+                                                  uint32_t max_profiles);
+
+  /**
+   * Finds the retained profiles with the value of an encoder within a range.
+   *
+   * @param encoder The encoder to compare.
+   * @param min The least encoder value, inclusive.
+   * @param max The greatest encoder value, inclusive.
+   * @param max_profiles The maximum number of profiles to return.
+   * @return The oldest matching profiles in timestamp order.
+   */
+  std::vector<std::shared_ptr<Profile>> GetByEncoder(jsEncoder encoder,
+                                                     int64_t min, int64_t max,
+                                                     uint32_t max_profiles);
+
+ private:
+  void Evict();
+  void Remove(const std::shared_ptr<Profile> &profile);
+
+  std::atomic<bool> is_enabled;
+  jsHistoryConfig config;
+
+  std::mutex lock;
+  // retained profiles ordered by timestamp, oldest first
+  std::deque<std::shared_ptr<Profile>> profiles;
+  // index of the retained profiles by the value of each encoder
+  typedef std::multimap<int64_t, std::shared_ptr<Profile>> EncoderIndex;
+  EncoderIndex encoder_index[JS_ENCODER_MAX];
+};
+} // namespace joescan
+
+#endif // JOESCAN_PROFILE_HISTORY_H
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "ProfileResampler.hpp"
+#include "ReductionKernels.hpp"
+#include "SimdKernels.hpp"
+
+#include <cstring>
+
+using namespace joescan;
+
+ProfileResampler::ProfileResampler() : is_enabled(false)
+{
+  memset(&config, 0, sizeof(config));
+}
+
+void ProfileResampler::Enable(const jsResampleConfig &config)
+{
+  this->config = config;
+  points.resize(kLen);
+  is_enabled = true;
+}
+
+void ProfileResampler::Disable()
+{
+  is_enabled = false;
+  std::vector<jsProfileData>().swap(points);
+}
+
+bool ProfileResampler::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void ProfileResampler::Apply(Profile &profile)
+{
+  if (kLen != profile.GetDataLength()) {
+    // profiles holding only an image have no data to resample
+    return;
+  }
+
+  jsProfileData *data = profile.GetDataPointer();
+  uint32_t len = GetSimdKernels().copy_valid(data, kLen, 1, points.data());
+  GetReductionKernels().resample(points.data(), len, config, data);
+
+  for (uint32_t n = config.num_points; n < kLen; n++) {
+    data[n].x = JS_PROFILE_DATA_INVALID_XY;
+    data[n].y = JS_PROFILE_DATA_INVALID_XY;
+    data[n].brightness = JS_PROFILE_DATA_INVALID_BRIGHTNESS;
+  }
+
+  profile.RebuildSummary();
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_PROFILE_RESAMPLER_H
+#define JOESCAN_PROFILE_RESAMPLER_H
+
+#include <atomic>
+#include <vector>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Replaces the data of each profile of a scan head with its points
+ * resampled onto a grid of evenly spaced X coordinates. Runs on the receiver
+ * thread as profiles are buffered, after the temporal filter, which works on
+ * camera columns.
+ */
+class ProfileResampler {
+ public:
+  ProfileResampler();
+
+  /**
+   * Enables resampling; must not be called while scanning.
+   *
+   * @param config The grid to resample onto.
+   */
+  void Enable(const jsResampleConfig &config);
+
+  /**
+   * Disables resampling; must not be called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if resampling is enabled, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Resamples a profile in place and updates its summary to match.
+   *
+   * @param profile The profile to resample.
+   */
+  void Apply(Profile &profile);
+
+ private:
+  static const uint32_t kLen = JS_PROFILE_DATA_LEN;
+
+  std::atomic<bool> is_enabled;
+  jsResampleConfig config;
+  // the valid points of the profile being resampled
+  std::vector<jsProfileData> points;
+};
+} // namespace joescan
+
+#endif // JOESCAN_PROFILE_RESAMPLER_H
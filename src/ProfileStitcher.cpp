@@ -0,0 +1,309 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ProfileStitcher.hpp"
+
+using namespace joescan;
+
+static bool CompareX(const jsStitchedProfileData &a,
+                     const jsStitchedProfileData &b)
+{
+  return a.x < b.x;
+}
+
+ProfileStitcher::ProfileStitcher()
+  : is_enabled(false),
+    rule(JS_STITCH_OVERLAP_KEEP_ALL),
+    has_origin(false),
+    origin_ns(0),
+    cycle_ns(0.0),
+    min_index(0)
+{
+}
+
+void ProfileStitcher::Enable(jsStitchOverlapRule rule)
+{
+  this->rule = rule;
+  is_enabled = true;
+}
+
+void ProfileStitcher::Disable()
+{
+  is_enabled = false;
+}
+
+bool ProfileStitcher::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void ProfileStitcher::Start(
+  const std::vector<std::pair<uint32_t, jsCamera>> &sources,
+  double scan_rate_hz, jsCameraExposureMode mode)
+{
+  std::lock_guard<std::mutex> lock(frame_lock);
+  this->sources = sources;
+  std::sort(this->sources.begin(), this->sources.end());
+  frames.clear();
+  has_origin = false;
+  origin_ns = 0;
+  // each scan head has taken a profile with every one of its cameras once
+  // per cycle; cameras taking turns need one scan period each
+  cycle_ns = 1e9 / scan_rate_hz;
+  if (JS_CAMERA_EXPOSURE_MODE_INTERLEAVED == mode) {
+    cycle_ns *= JS_CAMERA_MAX;
+  }
+  min_index = std::numeric_limits<int64_t>::min();
+}
+
+void ProfileStitcher::Flush()
+{
+  std::lock_guard<std::mutex> lock(stitched_lock);
+  stitched.clear();
+}
+
+void ProfileStitcher::AddProfile(uint32_t scan_head_id,
+                                 std::shared_ptr<Profile> profile)
+{
+  if (!is_enabled) {
+    return;
+  }
+
+  std::vector<Frame> ready;
+
+  {
+    std::lock_guard<std::mutex> lock(frame_lock);
+    auto source = std::make_pair(scan_head_id, profile->GetCamera());
+    auto iter = std::lower_bound(sources.begin(), sources.end(), source);
+    if ((sources.end() == iter) || (source != *iter)) {
+      return;
+    }
+
+    uint64_t timestamp = profile->GetTimestamp();
+    if (!has_origin) {
+      origin_ns = timestamp;
+      has_origin = true;
+    }
+
+    // Frames span one cycle, offset by a quarter cycle from the first profile
+    // seen; the profiles of every camera then land in the middle of a frame
+    // whether they were taken at the start or halfway through the cycle.
+    double elapsed = static_cast<double>(
+      static_cast<int64_t>(timestamp - origin_ns));
+    int64_t index = static_cast<int64_t>(std::floor(elapsed / cycle_ns + 0.25));
+    if (index < min_index) {
+      // too late, the frame has already been stitched
+      return;
+    }
+
+    auto frame_iter = frames.find(index);
+    if (frames.end() == frame_iter) {
+      Frame frame;
+      frame.index = index;
+      frame.num_received = 0;
+      frame.profiles.resize(sources.size());
+      frame_iter = frames.insert(std::make_pair(index, frame)).first;
+    }
+
+    Frame &frame = frame_iter->second;
+    size_t n = static_cast<size_t>(iter - sources.begin());
+    if (nullptr == frame.profiles[n]) {
+      frame.profiles[n] = profile;
+      frame.num_received++;
+    }
+
+    if (frame.num_received == sources.size()) {
+      ready.push_back(frame);
+      frames.erase(frame_iter);
+    }
+
+    // a frame older than the previous one is not going to be completed; this
+    // bounds the latency of frames missing a profile to two cycles
+    if (min_index < index - 1) {
+      min_index = index - 1;
+    }
+
+    while (!frames.empty() && (frames.begin()->first < min_index)) {
+      ready.push_back(frames.begin()->second);
+      frames.erase(frames.begin());
+    }
+  }
+
+  // stitching is done outside of the lock so other receivers can continue to
+  // add profiles, possibly stitching other frames at the same time
+  for (auto const &frame : ready) {
+    PushProfile(Stitch(frame));
+  }
+}
+
+uint32_t ProfileStitcher::AvailableProfiles()
+{
+  std::lock_guard<std::mutex> lock(stitched_lock);
+  return static_cast<uint32_t>(stitched.size());
+}
+
+std::vector<std::shared_ptr<StitchedProfile>> ProfileStitcher::PopProfiles(
+  uint32_t count)
+{
+  std::vector<std::shared_ptr<StitchedProfile>> profiles;
+  std::lock_guard<std::mutex> lock(stitched_lock);
+
+  while (!stitched.empty() && (0 < count)) {
+    profiles.push_back(stitched.front());
+    stitched.pop_front();
+    count--;
+  }
+
+  return profiles;
+}
+
+std::shared_ptr<StitchedProfile> ProfileStitcher::Stitch(
+  const Frame &frame) const
+{
+  std::shared_ptr<StitchedProfile> out = std::make_shared<StitchedProfile>();
+  std::vector<std::vector<jsStitchedProfileData>> runs(sources.size());
+  const Profile *first = nullptr;
+
+  out->frame = frame.index;
+  out->timestamp_ns = 0;
+  out->num_sources_received = frame.num_received;
+  out->sources.resize(sources.size());
+
+  for (size_t n = 0; n < sources.size(); n++) {
+    jsStitchedSource &source = out->sources[n];
+    const Profile *profile = frame.profiles[n].get();
+
+    source.scan_head_id = sources[n].first;
+    source.camera = sources[n].second;
+    source.timestamp_ns = 0;
+    source.data_len = 0;
+
+    if (nullptr == profile) {
+      continue;
+    }
+
+    source.timestamp_ns = profile->GetTimestamp();
+    if ((nullptr == first) ||
+        (profile->GetTimestamp() < first->GetTimestamp())) {
+      first = profile;
+    }
+
+    const jsProfileData *data = profile->GetDataPointer();
+    std::vector<jsStitchedProfileData> &run = runs[n];
+    run.reserve(profile->GetDataLength());
+    for (uint32_t m = 0; m < profile->GetDataLength(); m++) {
+      if (JS_PROFILE_DATA_INVALID_XY != data[m].x) {
+        jsStitchedProfileData p = {data[m].x, data[m].y, data[m].brightness,
+                                   static_cast<uint32_t>(n)};
+        run.push_back(p);
+      }
+    }
+
+    // a camera's points usually run in order of X one way or the other
+    if (std::is_sorted(run.rbegin(), run.rend(), CompareX)) {
+      std::reverse(run.begin(), run.end());
+    } else if (!std::is_sorted(run.begin(), run.end(), CompareX)) {
+      std::stable_sort(run.begin(), run.end(), CompareX);
+    }
+  }
+
+  if (nullptr != first) {
+    out->timestamp_ns = first->GetTimestamp();
+    out->encoder_values = first->GetEncoderValues();
+  }
+
+  // resolve the overlap between sources; each run is sorted, so its extent
+  // is given by its first and last points
+  if (JS_STITCH_OVERLAP_MIDPOINT == rule) {
+    std::vector<size_t> order;
+    for (size_t n = 0; n < runs.size(); n++) {
+      if (!runs[n].empty()) {
+        order.push_back(n);
+      }
+    }
+
+    // order the sources by the center of their extent, each keeps its points
+    // up to halfway through the overlap with its neighbors
+    std::sort(order.begin(), order.end(), [&runs](size_t a, size_t b) {
+      return (int64_t(runs[a].front().x) + runs[a].back().x) <
+             (int64_t(runs[b].front().x) + runs[b].back().x);
+    });
+
+    std::vector<int64_t> cuts;
+    for (size_t n = 1; n < order.size(); n++) {
+      cuts.push_back((int64_t(runs[order[n - 1]].back().x) +
+                      runs[order[n]].front().x) /
+                     2);
+    }
+
+    for (size_t n = 0; n < order.size(); n++) {
+      int64_t lo = (0 == n) ? std::numeric_limits<int64_t>::min()
+                            : cuts[n - 1];
+      int64_t hi = ((order.size() - 1) == n)
+                     ? std::numeric_limits<int64_t>::max()
+                     : cuts[n];
+      std::vector<jsStitchedProfileData> &run = runs[order[n]];
+      run.erase(std::remove_if(run.begin(), run.end(),
+                               [lo, hi](const jsStitchedProfileData &p) {
+                                 return (p.x < lo) || (p.x >= hi);
+                               }),
+                run.end());
+    }
+  } else if (JS_STITCH_OVERLAP_PRIORITY == rule) {
+    // sources are ordered by scan head ID and camera, which is the priority;
+    // extents are taken before removing any points
+    std::vector<std::pair<int32_t, int32_t>> extents;
+    for (size_t n = 0; n < runs.size(); n++) {
+      std::vector<jsStitchedProfileData> &run = runs[n];
+      if (run.empty()) {
+        continue;
+      }
+
+      auto extent = std::make_pair(run.front().x, run.back().x);
+      for (auto const &e : extents) {
+        run.erase(std::remove_if(run.begin(), run.end(),
+                                 [&e](const jsStitchedProfileData &p) {
+                                   return (p.x >= e.first) &&
+                                          (p.x <= e.second);
+                                 }),
+                  run.end());
+      }
+      extents.push_back(extent);
+    }
+  }
+
+  // merge the sorted runs, lower sources go first where X is equal
+  for (size_t n = 0; n < runs.size(); n++) {
+    size_t mid = out->data.size();
+    out->sources[n].data_len = static_cast<uint32_t>(runs[n].size());
+    out->data.insert(out->data.end(), runs[n].begin(), runs[n].end());
+    std::inplace_merge(out->data.begin(), out->data.begin() + mid,
+                       out->data.end(), CompareX);
+  }
+
+  return out;
+}
+
+void ProfileStitcher::PushProfile(std::shared_ptr<StitchedProfile> profile)
+{
+  std::lock_guard<std::mutex> lock(stitched_lock);
+
+  // frames stitched in parallel may finish out of order
+  auto iter = stitched.end();
+  while ((stitched.begin() != iter) && ((*(iter - 1))->frame > profile->frame)) {
+    --iter;
+  }
+
+  stitched.insert(iter, profile);
+  while (kMaxStitchedProfiles < static_cast<int>(stitched.size())) {
+    stitched.pop_front();
+  }
+}
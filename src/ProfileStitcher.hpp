@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_PROFILE_STITCHER_H
+#define JOESCAN_PROFILE_STITCHER_H
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief The profiles of all scan heads in a frame, combined into a single
+ * contour ordered by X.
+ */
+struct StitchedProfile {
+  int64_t frame;
+  uint64_t timestamp_ns;
+  std::vector<int64_t> encoder_values;
+  uint32_t num_sources_received;
+  std::vector<jsStitchedSource> sources;
+  std::vector<jsStitchedProfileData> data;
+};
+
+/**
+ * @brief Groups the profiles of every camera of every scan head into frames
+ * and stitches each frame into a single contour. Profiles are added from the
+ * receiver threads; a frame is stitched by the thread adding its last profile,
+ * so frames are stitched in parallel and become available as soon as they
+ * are complete.
+ */
+class ProfileStitcher {
+ public:
+  ProfileStitcher();
+
+  /**
+   * Enables stitching; must not be called while scanning.
+   *
+   * @param rule The rule used to resolve points where sources overlap.
+   */
+  void Enable(jsStitchOverlapRule rule);
+
+  /**
+   * Disables stitching; must not be called while scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if stitching is enabled, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Clears all frames and sets up for a new scan; stitched profiles not yet
+   * read are kept.
+   *
+   * @param sources The scan head ID and camera of every source expected in
+   * each frame.
+   * @param scan_rate_hz The scan rate of the scan heads.
+   * @param mode The camera exposure mode of the scan heads, determining
+   * whether a frame spans one scan period or one period per camera.
+   */
+  void Start(const std::vector<std::pair<uint32_t, jsCamera>> &sources,
+             double scan_rate_hz, jsCameraExposureMode mode);
+
+  /**
+   * Discards all stitched profiles not yet read.
+   */
+  void Flush();
+
+  /**
+   * Adds a profile to its frame, stitching the frame if it is complete and
+   * any older frames that can no longer be completed.
+   *
+   * @param scan_head_id The ID of the scan head the profile came from.
+   * @param profile The profile to add.
+   */
+  void AddProfile(uint32_t scan_head_id, std::shared_ptr<Profile> profile);
+
+  /**
+   * @return The number of stitched profiles available to be read.
+   */
+  uint32_t AvailableProfiles();
+
+  /**
+   * Removes stitched profiles in frame order.
+   *
+   * @param count The greatest number of profiles to remove.
+   * @return The profiles removed.
+   */
+  std::vector<std::shared_ptr<StitchedProfile>> PopProfiles(uint32_t count);
+
+ private:
+  struct Frame {
+    int64_t index;
+    uint32_t num_received;
+    std::vector<std::shared_ptr<Profile>> profiles;
+  };
+
+  std::shared_ptr<StitchedProfile> Stitch(const Frame &frame) const;
+  void PushProfile(std::shared_ptr<StitchedProfile> profile);
+
+  static const int kMaxStitchedProfiles = JS_SCAN_HEAD_PROFILES_MAX;
+
+  std::atomic<bool> is_enabled;
+  jsStitchOverlapRule rule;
+  std::vector<std::pair<uint32_t, jsCamera>> sources;
+
+  std::mutex frame_lock;
+  std::map<int64_t, Frame> frames;
+  bool has_origin;
+  uint64_t origin_ns;
+  double cycle_ns;
+  int64_t min_index;
+
+  std::mutex stitched_lock;
+  std::deque<std::shared_ptr<StitchedProfile>> stitched;
+};
+} // namespace joescan
+
+#endif // JOESCAN_PROFILE_STITCHER_H
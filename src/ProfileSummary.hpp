@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_PROFILE_SUMMARY_H
+#define JOESCAN_PROFILE_SUMMARY_H
+
+#include <cstdint>
+#include <limits>
+
+namespace joescan {
+/**
+ * @brief Running summary of the valid X/Y points decoded into a profile. The
+ * decode kernels add each point as it is written to the profile, the final
+ * `jsProfileSummary` is derived from it once the profile is read out.
+ */
+struct ProfileSummary {
+  int64_t sum_x;
+  int64_t sum_y;
+  int32_t x_min;
+  int32_t x_max;
+  int32_t y_min;
+  int32_t y_max;
+  int32_t highest_x;
+  int32_t highest_y;
+  uint32_t highest_idx;
+  uint32_t num_valid;
+
+  ProfileSummary()
+    : sum_x(0),
+      sum_y(0),
+      x_min(std::numeric_limits<int32_t>::max()),
+      x_max(std::numeric_limits<int32_t>::min()),
+      y_min(std::numeric_limits<int32_t>::max()),
+      y_max(std::numeric_limits<int32_t>::min()),
+      highest_x(0),
+      highest_y(std::numeric_limits<int32_t>::min()),
+      highest_idx(std::numeric_limits<uint32_t>::max()),
+      num_valid(0)
+  {
+  }
+
+  /**
+   * Adds a valid point to the summary.
+   *
+   * @param x The X coordinate of the point.
+   * @param y The Y coordinate of the point.
+   * @param idx The index of the point in the profile data array; used to
+   * settle ties for the highest point since points are not added in order.
+   */
+  inline void Add(int32_t x, int32_t y, uint32_t idx)
+  {
+    sum_x += x;
+    sum_y += y;
+    x_min = (x < x_min) ? x : x_min;
+    x_max = (x > x_max) ? x : x_max;
+    y_min = (y < y_min) ? y : y_min;
+    y_max = (y > y_max) ? y : y_max;
+    if ((y > highest_y) || ((y == highest_y) && (idx < highest_idx))) {
+      highest_x = x;
+      highest_y = y;
+      highest_idx = idx;
+    }
+    num_valid++;
+  }
+};
+} // namespace joescan
+
+#endif // JOESCAN_PROFILE_SUMMARY_H
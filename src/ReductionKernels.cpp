@@ -0,0 +1,1231 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ReductionKernels.hpp"
+#include "SimdKernels.hpp"
+#include "SimdTarget.hpp"
+
+using namespace joescan;
+
+/*
+ * Scalar kernels; these are used as is on CPUs without vector extensions and
+ * also to process the remainder of an array in the vectorized kernels.
+ */
+
+static inline bool InRegion(const jsProfileData &p, const jsRegion &region)
+{
+  return (p.x >= region.x_min) && (p.x <= region.x_max) &&
+         (p.y >= region.y_min) && (p.y <= region.y_max);
+}
+
+static inline bool IsBetter(const jsProfileData *data, uint32_t n,
+                            uint32_t best, uint32_t len, bool highest)
+{
+  if (len == best) {
+    return true;
+  }
+
+  return (highest) ? (data[n].y > data[best].y) : (data[n].y < data[best].y);
+}
+
+// This must perform the exact same sequence of operations as the vectorized
+// kernels so every variant computes identical segment areas.
+static inline double SegmentArea(const jsProfileData &a,
+                                 const jsProfileData &b, double slope,
+                                 double intercept)
+{
+  double x0 = static_cast<double>(a.x);
+  double x1 = static_cast<double>(b.x);
+  double h0 = static_cast<double>(a.y) - (slope * x0 + intercept);
+  double h1 = static_cast<double>(b.y) - (slope * x1 + intercept);
+
+  return (std::fabs(x1 - x0) * (h0 + h1)) * 0.5;
+}
+
+static uint32_t FindExtremeRange(const jsProfileData *data, uint32_t start,
+                                 uint32_t len, const jsRegion &region,
+                                 bool highest, uint32_t best)
+{
+  for (uint32_t n = start; n < len; n++) {
+    if (InRegion(data[n], region) && IsBetter(data, n, best, len, highest)) {
+      best = n;
+    }
+  }
+
+  return best;
+}
+
+static uint32_t CountRange(const jsProfileData *data, uint32_t start,
+                           uint32_t len, const jsRegion &region)
+{
+  uint32_t count = 0;
+
+  for (uint32_t n = start; n < len; n++) {
+    if (InRegion(data[n], region)) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+static void SumWeightedRange(const jsProfileData *data, uint32_t start,
+                             uint32_t len, const jsRegion &region,
+                             bool weighted, int64_t sums[3])
+{
+  for (uint32_t n = start; n < len; n++) {
+    if (InRegion(data[n], region)) {
+      int64_t w = (weighted) ? data[n].brightness : 1;
+      sums[0] += w * data[n].x;
+      sums[1] += w * data[n].y;
+      sums[2] += w;
+    }
+  }
+}
+
+// This must perform the exact same sequence of operations as the vectorized
+// kernels so every variant counts the same points.
+static inline bool IsNearLine(const jsProfileData &p, double normal_x,
+                              double normal_y, double offset, double tolerance)
+{
+  double d = (normal_x * static_cast<double>(p.x) +
+              normal_y * static_cast<double>(p.y)) -
+             offset;
+
+  return std::fabs(d) <= tolerance;
+}
+
+static double AreaRange(const jsProfileData *data, uint32_t start,
+                        uint32_t len, const jsRegion &region, double slope,
+                        double intercept)
+{
+  double area = 0.0;
+
+  for (uint32_t n = start; (n + 1) < len; n++) {
+    if (InRegion(data[n], region) && InRegion(data[n + 1], region)) {
+      area += SegmentArea(data[n], data[n + 1], slope, intercept);
+    }
+  }
+
+  return area;
+}
+
+static void SumMomentsRange(const jsProfileData *data, uint32_t start,
+                            uint32_t len, const jsRegion &region,
+                            int64_t sums[6])
+{
+  for (uint32_t n = start; n < len; n++) {
+    if (InRegion(data[n], region)) {
+      int64_t x = data[n].x;
+      int64_t y = data[n].y;
+      sums[0] += 1;
+      sums[1] += x;
+      sums[2] += y;
+      sums[3] += x * x;
+      sums[4] += y * y;
+      sums[5] += x * y;
+    }
+  }
+}
+
+static uint32_t CountNearLineRange(const jsProfileData *data, uint32_t start,
+                                   uint32_t len, double normal_x,
+                                   double normal_y, double offset,
+                                   double tolerance)
+{
+  uint32_t count = 0;
+
+  for (uint32_t n = start; n < len; n++) {
+    if (IsNearLine(data[n], normal_x, normal_y, offset, tolerance)) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+static void SumConicMomentsRange(const double *u, const double *v,
+                                 uint32_t start, uint32_t len,
+                                 double sums[14])
+{
+  for (uint32_t n = start; n < len; n++) {
+    double uu = u[n] * u[n];
+    double uv = u[n] * v[n];
+    double vv = v[n] * v[n];
+    sums[0] += u[n];
+    sums[1] += v[n];
+    sums[2] += uu;
+    sums[3] += uv;
+    sums[4] += vv;
+    sums[5] += uu * u[n];
+    sums[6] += uu * v[n];
+    sums[7] += u[n] * vv;
+    sums[8] += vv * v[n];
+    sums[9] += uu * uu;
+    sums[10] += uu * uv;
+    sums[11] += uu * vv;
+    sums[12] += uv * vv;
+    sums[13] += vv * vv;
+  }
+}
+
+/**
+ * Finds the first grid point at or past an X coordinate, clamped to the grid;
+ * points past the last grid point all map to `num_points`. The quotient is
+ * estimated with the reciprocal of the grid step and settled with exact
+ * products, avoiding a 64 bit division per point.
+ */
+static inline int32_t GridCeil(int32_t x, const jsResampleConfig &config,
+                               double inv_step)
+{
+  int64_t d = static_cast<int64_t>(x) - config.x_start;
+  if (0 >= d) {
+    return 0;
+  }
+
+  int64_t c = static_cast<int64_t>(static_cast<double>(d) * inv_step);
+  c += ((c * config.x_step) < d) ? 1 : 0;
+  c -= (((c - 1) * config.x_step) >= d) ? 1 : 0;
+  return static_cast<int32_t>(
+    std::min(c, static_cast<int64_t>(config.num_points)));
+}
+
+/**
+ * Interpolates grid points `start` onwards. `last` holds for each grid point
+ * the position, in the order the points are taken, of the last point whose
+ * first grid point it is, or `-1`; the running maximum of it from `carry`
+ * on is the last point at or before the grid point.
+ */
+static uint32_t InterpolateRange(const jsProfileData *data, uint32_t len,
+                                 bool reverse, const int32_t *last,
+                                 uint32_t start, int32_t carry,
+                                 const jsResampleConfig &config,
+                                 jsProfileData *dst)
+{
+  uint32_t count = 0;
+
+  for (uint32_t i = start; i < config.num_points; i++) {
+    int32_t a = std::max(last[i], carry);
+    carry = a;
+
+    if (0 > a) {
+      dst[i].x = JS_PROFILE_DATA_INVALID_XY;
+      dst[i].y = JS_PROFILE_DATA_INVALID_XY;
+      dst[i].brightness = JS_PROFILE_DATA_INVALID_BRIGHTNESS;
+      continue;
+    }
+
+    // the next point is past the grid point, unless there is none
+    int32_t gx = static_cast<int32_t>(static_cast<int64_t>(config.x_start) +
+                                      static_cast<int64_t>(i) * config.x_step);
+    uint32_t n = static_cast<uint32_t>(a);
+    uint32_t m = ((n + 1) < len) ? (n + 1) : n;
+    const jsProfileData &p = data[reverse ? (len - 1 - n) : n];
+    const jsProfileData &q = data[reverse ? (len - 1 - m) : m];
+
+    if ((p.x != gx) &&
+        ((n == m) || ((0 < config.max_gap) &&
+                      ((static_cast<int64_t>(q.x) - p.x) > config.max_gap)))) {
+      dst[i].x = JS_PROFILE_DATA_INVALID_XY;
+      dst[i].y = JS_PROFILE_DATA_INVALID_XY;
+      dst[i].brightness = JS_PROFILE_DATA_INVALID_BRIGHTNESS;
+      continue;
+    }
+
+    // the offset from the first point is rounded, not the interpolated
+    // value, so the single precision division only has to cover the rise
+    // of one segment
+    float dx = static_cast<float>(q.x - p.x);
+    float t = (0.0f == dx) ? 0.0f : static_cast<float>(gx - p.x) / dx;
+    float rise = t * static_cast<float>(q.y - p.y);
+
+    dst[i].x = gx;
+    dst[i].y = p.y + static_cast<int32_t>(std::lrint(rise));
+    dst[i].brightness = (0.5f > t) ? p.brightness : q.brightness;
+    count++;
+  }
+
+  return count;
+}
+
+static uint32_t FindExtremeScalar(const jsProfileData *data, uint32_t len,
+                                  const jsRegion &region, bool highest)
+{
+  return FindExtremeRange(data, 0, len, region, highest, len);
+}
+
+static uint32_t CountScalar(const jsProfileData *data, uint32_t len,
+                            const jsRegion &region)
+{
+  return CountRange(data, 0, len, region);
+}
+
+static void SumWeightedScalar(const jsProfileData *data, uint32_t len,
+                              const jsRegion &region, bool weighted,
+                              int64_t sums[3])
+{
+  SumWeightedRange(data, 0, len, region, weighted, sums);
+}
+
+static double AreaScalar(const jsProfileData *data, uint32_t len,
+                         const jsRegion &region, double slope,
+                         double intercept)
+{
+  return AreaRange(data, 0, len, region, slope, intercept);
+}
+
+static void SumMomentsScalar(const jsProfileData *data, uint32_t len,
+                             const jsRegion &region, int64_t sums[6])
+{
+  SumMomentsRange(data, 0, len, region, sums);
+}
+
+static uint32_t CountNearLineScalar(const jsProfileData *data, uint32_t len,
+                                    double normal_x, double normal_y,
+                                    double offset, double tolerance)
+{
+  return CountNearLineRange(data, 0, len, normal_x, normal_y, offset,
+                            tolerance);
+}
+
+static void SumConicMomentsScalar(const double *u, const double *v,
+                                  uint32_t len, double sums[14])
+{
+  SumConicMomentsRange(u, v, 0, len, sums);
+}
+
+static uint32_t ResampleScalar(const jsProfileData *data, uint32_t len,
+                               const jsResampleConfig &config,
+                               jsProfileData *dst)
+{
+  // the columns of a camera map to either increasing or decreasing X
+  const bool reverse = (1 < len) && (data[0].x > data[len - 1].x);
+  int32_t last[JS_PROFILE_DATA_LEN + 1];
+
+  // each point is recorded at its first grid point, so no search is needed
+  // and X doubling back is settled in favor of the later points
+  const double inv_step = 1.0 / config.x_step;
+  std::fill(last, last + config.num_points + 1, -1);
+  for (uint32_t j = 0; j < len; j++) {
+    const jsProfileData &p = data[reverse ? (len - 1 - j) : j];
+    last[GridCeil(p.x, config, inv_step)] = static_cast<int32_t>(j);
+  }
+
+  return InterpolateRange(data, len, reverse, last, 0, -1, config, dst);
+}
+
+#ifdef JS_SIMD_X86
+/*
+ * AVX2 kernels, 8 points per iteration.
+ */
+
+/**
+ * Splits 8 consecutive `jsProfileData` structs into vectors of their X, Y
+ * and brightness values.
+ */
+JS_SIMD_TARGET("avx2")
+static inline void Deinterleave8(const jsProfileData *p, __m256i *x,
+                                 __m256i *y, __m256i *b)
+{
+  const __m256i *src = reinterpret_cast<const __m256i *>(p);
+  // v0: x0 y0 b0 x1 y1 b1 x2 y2
+  // v1: b2 x3 y3 b3 x4 y4 b4 x5
+  // v2: y5 b5 x6 y6 b6 x7 y7 b7
+  __m256i v0 = _mm256_loadu_si256(src);
+  __m256i v1 = _mm256_loadu_si256(src + 1);
+  __m256i v2 = _mm256_loadu_si256(src + 2);
+
+  __m256i t = _mm256_blend_epi32(_mm256_blend_epi32(v0, v1, 0x92), v2, 0x24);
+  *x = _mm256_permutevar8x32_epi32(t, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+  t = _mm256_blend_epi32(_mm256_blend_epi32(v0, v1, 0x24), v2, 0x49);
+  *y = _mm256_permutevar8x32_epi32(t, _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6));
+  t = _mm256_blend_epi32(_mm256_blend_epi32(v0, v1, 0x49), v2, 0x92);
+  *b = _mm256_permutevar8x32_epi32(t, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+}
+
+/**
+ * Joins vectors of X, Y and brightness values into 8 consecutive
+ * `jsProfileData` structs, the inverse of `Deinterleave8`.
+ */
+JS_SIMD_TARGET("avx2")
+static inline void Interleave8(__m256i x, __m256i y, __m256i b,
+                               jsProfileData *p)
+{
+  __m256i *dst = reinterpret_cast<__m256i *>(p);
+  __m256i tx =
+    _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+  __m256i ty =
+    _mm256_permutevar8x32_epi32(y, _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+  __m256i tb =
+    _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+
+  _mm256_storeu_si256(dst,
+                      _mm256_blend_epi32(_mm256_blend_epi32(tx, ty, 0x92), tb,
+                                         0x24));
+  _mm256_storeu_si256(dst + 1,
+                      _mm256_blend_epi32(_mm256_blend_epi32(tb, tx, 0x92), ty,
+                                         0x24));
+  _mm256_storeu_si256(dst + 2,
+                      _mm256_blend_epi32(_mm256_blend_epi32(tb, tx, 0x24), ty,
+                                         0x49));
+}
+
+/**
+ * Tests which of the 8 points lie within the region, returning a vector with
+ * all bits set in the lanes that do.
+ */
+JS_SIMD_TARGET("avx2")
+static inline __m256i InRegion8(__m256i x, __m256i y, const jsRegion &region)
+{
+  __m256i x_out =
+    _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(region.x_min), x),
+                    _mm256_cmpgt_epi32(x, _mm256_set1_epi32(region.x_max)));
+  __m256i y_out =
+    _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(region.y_min), y),
+                    _mm256_cmpgt_epi32(y, _mm256_set1_epi32(region.y_max)));
+
+  return _mm256_andnot_si256(_mm256_or_si256(x_out, y_out),
+                             _mm256_set1_epi32(-1));
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t FindExtremeAVX2(const jsProfileData *data, uint32_t len,
+                                const jsRegion &region, bool highest)
+{
+  const __m256i none = _mm256_set1_epi32(-1);
+  const __m256i eight = _mm256_set1_epi32(8);
+  __m256i best_y = _mm256_set1_epi32((highest)
+                                       ? std::numeric_limits<int32_t>::min()
+                                       : std::numeric_limits<int32_t>::max());
+  __m256i best_idx = none;
+  __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i x, y, b;
+  uint32_t n = 0;
+
+  // each lane tracks the first best point of the entries it sees
+  for (; (n + 8) <= len; n += 8) {
+    Deinterleave8(&data[n], &x, &y, &b);
+    __m256i better = (highest) ? _mm256_cmpgt_epi32(y, best_y)
+                               : _mm256_cmpgt_epi32(best_y, y);
+    better = _mm256_or_si256(better, _mm256_cmpeq_epi32(best_idx, none));
+    __m256i update = _mm256_and_si256(InRegion8(x, y, region), better);
+    best_y = _mm256_blendv_epi8(best_y, y, update);
+    best_idx = _mm256_blendv_epi8(best_idx, idx, update);
+    idx = _mm256_add_epi32(idx, eight);
+  }
+
+  int32_t lanes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), best_idx);
+  uint32_t best = len;
+  for (int k = 0; k < 8; k++) {
+    if (0 > lanes[k]) {
+      continue;
+    }
+
+    uint32_t i = static_cast<uint32_t>(lanes[k]);
+    if (IsBetter(data, i, best, len, highest) ||
+        ((data[i].y == data[best].y) && (i < best))) {
+      best = i;
+    }
+  }
+
+  return FindExtremeRange(data, n, len, region, highest, best);
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t CountAVX2(const jsProfileData *data, uint32_t len,
+                          const jsRegion &region)
+{
+  __m256i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    Deinterleave8(&data[n], &x, &y, &b);
+    __m256i in = InRegion8(x, y, region);
+    count += PopCount(_mm256_movemask_ps(_mm256_castsi256_ps(in)));
+  }
+
+  return count + CountRange(data, n, len, region);
+}
+
+JS_SIMD_TARGET("avx2")
+static void SumWeightedAVX2(const jsProfileData *data, uint32_t len,
+                            const jsRegion &region, bool weighted,
+                            int64_t sums[3])
+{
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+  __m256i sum_x = _mm256_setzero_si256();
+  __m256i sum_y = _mm256_setzero_si256();
+  __m256i sum_w = _mm256_setzero_si256();
+  __m256i x, y, b;
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    Deinterleave8(&data[n], &x, &y, &b);
+    __m256i w = _mm256_and_si256((weighted) ? b : one, InRegion8(x, y, region));
+
+    // products of the even lanes, then of the odd lanes, as 64 bit integers
+    sum_x = _mm256_add_epi64(sum_x, _mm256_mul_epi32(w, x));
+    sum_x = _mm256_add_epi64(sum_x,
+                             _mm256_mul_epi32(_mm256_srli_epi64(w, 32),
+                                              _mm256_srli_epi64(x, 32)));
+    sum_y = _mm256_add_epi64(sum_y, _mm256_mul_epi32(w, y));
+    sum_y = _mm256_add_epi64(sum_y,
+                             _mm256_mul_epi32(_mm256_srli_epi64(w, 32),
+                                              _mm256_srli_epi64(y, 32)));
+    sum_w = _mm256_add_epi64(sum_w, _mm256_and_si256(w, low));
+    sum_w = _mm256_add_epi64(sum_w, _mm256_srli_epi64(w, 32));
+  }
+
+  int64_t lanes[4];
+  __m256i *sum[3] = {&sum_x, &sum_y, &sum_w};
+  for (int i = 0; i < 3; i++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), *sum[i]);
+    sums[i] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+
+  SumWeightedRange(data, n, len, region, weighted, sums);
+}
+
+JS_SIMD_TARGET("avx2")
+static double AreaAVX2(const jsProfileData *data, uint32_t len,
+                       const jsRegion &region, double slope, double intercept)
+{
+  const __m256d vslope = _mm256_set1_pd(slope);
+  const __m256d vintercept = _mm256_set1_pd(intercept);
+  const __m256d half = _mm256_set1_pd(0.5);
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  __m256d area = _mm256_setzero_pd();
+  __m256i x0, y0, x1, y1, b;
+  uint32_t n = 0;
+
+  // each lane handles the segment from point `n + k` to point `n + k + 1`
+  for (; (n + 9) <= len; n += 8) {
+    Deinterleave8(&data[n], &x0, &y0, &b);
+    Deinterleave8(&data[n + 1], &x1, &y1, &b);
+    __m256i in = _mm256_and_si256(InRegion8(x0, y0, region),
+                                  InRegion8(x1, y1, region));
+
+    for (int h = 0; h < 2; h++) {
+      __m128i x0h = (0 == h) ? _mm256_castsi256_si128(x0)
+                             : _mm256_extracti128_si256(x0, 1);
+      __m128i y0h = (0 == h) ? _mm256_castsi256_si128(y0)
+                             : _mm256_extracti128_si256(y0, 1);
+      __m128i x1h = (0 == h) ? _mm256_castsi256_si128(x1)
+                             : _mm256_extracti128_si256(x1, 1);
+      __m128i y1h = (0 == h) ? _mm256_castsi256_si128(y1)
+                             : _mm256_extracti128_si256(y1, 1);
+      __m128i inh = (0 == h) ? _mm256_castsi256_si128(in)
+                             : _mm256_extracti128_si256(in, 1);
+
+      __m256d x0d = _mm256_cvtepi32_pd(x0h);
+      __m256d x1d = _mm256_cvtepi32_pd(x1h);
+      __m256d h0 = _mm256_sub_pd(
+        _mm256_cvtepi32_pd(y0h),
+        _mm256_add_pd(_mm256_mul_pd(vslope, x0d), vintercept));
+      __m256d h1 = _mm256_sub_pd(
+        _mm256_cvtepi32_pd(y1h),
+        _mm256_add_pd(_mm256_mul_pd(vslope, x1d), vintercept));
+      __m256d dx = _mm256_andnot_pd(sign, _mm256_sub_pd(x1d, x0d));
+      __m256d a =
+        _mm256_mul_pd(_mm256_mul_pd(dx, _mm256_add_pd(h0, h1)), half);
+      __m256d mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(inh));
+      area = _mm256_add_pd(area, _mm256_and_pd(a, mask));
+    }
+  }
+
+  double lanes[4];
+  _mm256_storeu_pd(lanes, area);
+
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+         AreaRange(data, n, len, region, slope, intercept);
+}
+
+/**
+ * Adds the 64 bit products of the even lanes and of the odd lanes of two
+ * vectors of 32 bit integers to a vector of 64 bit sums.
+ */
+JS_SIMD_TARGET("avx2")
+static inline __m256i AddProducts4(__m256i sum, __m256i a, __m256i b)
+{
+  sum = _mm256_add_epi64(sum, _mm256_mul_epi32(a, b));
+  return _mm256_add_epi64(sum,
+                          _mm256_mul_epi32(_mm256_srli_epi64(a, 32),
+                                           _mm256_srli_epi64(b, 32)));
+}
+
+JS_SIMD_TARGET("avx2")
+static void SumMomentsAVX2(const jsProfileData *data, uint32_t len,
+                           const jsRegion &region, int64_t sums[6])
+{
+  const __m256i one = _mm256_set1_epi32(1);
+  __m256i sum[5] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                    _mm256_setzero_si256(), _mm256_setzero_si256(),
+                    _mm256_setzero_si256()};
+  __m256i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    Deinterleave8(&data[n], &x, &y, &b);
+    __m256i in = InRegion8(x, y, region);
+    count += PopCount(_mm256_movemask_ps(_mm256_castsi256_ps(in)));
+    x = _mm256_and_si256(x, in);
+    y = _mm256_and_si256(y, in);
+
+    sum[0] = AddProducts4(sum[0], x, one);
+    sum[1] = AddProducts4(sum[1], y, one);
+    sum[2] = AddProducts4(sum[2], x, x);
+    sum[3] = AddProducts4(sum[3], y, y);
+    sum[4] = AddProducts4(sum[4], x, y);
+  }
+
+  int64_t lanes[4];
+  sums[0] += count;
+  for (int i = 0; i < 5; i++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sum[i]);
+    sums[i + 1] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+
+  SumMomentsRange(data, n, len, region, sums);
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t CountNearLineAVX2(const jsProfileData *data, uint32_t len,
+                                  double normal_x, double normal_y,
+                                  double offset, double tolerance)
+{
+  const __m256d vnormal_x = _mm256_set1_pd(normal_x);
+  const __m256d vnormal_y = _mm256_set1_pd(normal_y);
+  const __m256d voffset = _mm256_set1_pd(offset);
+  const __m256d vtolerance = _mm256_set1_pd(tolerance);
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  __m256i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    Deinterleave8(&data[n], &x, &y, &b);
+
+    for (int h = 0; h < 2; h++) {
+      __m128i xh = (0 == h) ? _mm256_castsi256_si128(x)
+                            : _mm256_extracti128_si256(x, 1);
+      __m128i yh = (0 == h) ? _mm256_castsi256_si128(y)
+                            : _mm256_extracti128_si256(y, 1);
+
+      __m256d d = _mm256_sub_pd(
+        _mm256_add_pd(_mm256_mul_pd(vnormal_x, _mm256_cvtepi32_pd(xh)),
+                      _mm256_mul_pd(vnormal_y, _mm256_cvtepi32_pd(yh))),
+        voffset);
+      __m256d near =
+        _mm256_cmp_pd(_mm256_andnot_pd(sign, d), vtolerance, _CMP_LE_OQ);
+      count += PopCount(_mm256_movemask_pd(near));
+    }
+  }
+
+  return count + CountNearLineRange(data, n, len, normal_x, normal_y, offset,
+                                    tolerance);
+}
+
+JS_SIMD_TARGET("avx2")
+static void SumConicMomentsAVX2(const double *u, const double *v,
+                                uint32_t len, double sums[14])
+{
+  __m256d sum[14];
+  uint32_t n = 0;
+
+  for (int i = 0; i < 14; i++) {
+    sum[i] = _mm256_setzero_pd();
+  }
+
+  for (; (n + 4) <= len; n += 4) {
+    __m256d vu = _mm256_loadu_pd(&u[n]);
+    __m256d vv = _mm256_loadu_pd(&v[n]);
+    __m256d uu = _mm256_mul_pd(vu, vu);
+    __m256d uv = _mm256_mul_pd(vu, vv);
+    __m256d v2 = _mm256_mul_pd(vv, vv);
+
+    sum[0] = _mm256_add_pd(sum[0], vu);
+    sum[1] = _mm256_add_pd(sum[1], vv);
+    sum[2] = _mm256_add_pd(sum[2], uu);
+    sum[3] = _mm256_add_pd(sum[3], uv);
+    sum[4] = _mm256_add_pd(sum[4], v2);
+    sum[5] = _mm256_add_pd(sum[5], _mm256_mul_pd(uu, vu));
+    sum[6] = _mm256_add_pd(sum[6], _mm256_mul_pd(uu, vv));
+    sum[7] = _mm256_add_pd(sum[7], _mm256_mul_pd(vu, v2));
+    sum[8] = _mm256_add_pd(sum[8], _mm256_mul_pd(v2, vv));
+    sum[9] = _mm256_add_pd(sum[9], _mm256_mul_pd(uu, uu));
+    sum[10] = _mm256_add_pd(sum[10], _mm256_mul_pd(uu, uv));
+    sum[11] = _mm256_add_pd(sum[11], _mm256_mul_pd(uu, v2));
+    sum[12] = _mm256_add_pd(sum[12], _mm256_mul_pd(uv, v2));
+    sum[13] = _mm256_add_pd(sum[13], _mm256_mul_pd(v2, v2));
+  }
+
+  double lanes[4];
+  for (int i = 0; i < 14; i++) {
+    _mm256_storeu_pd(lanes, sum[i]);
+    sums[i] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+
+  SumConicMomentsRange(u, v, n, len, sums);
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t ResampleAVX2(const jsProfileData *data, uint32_t len,
+                             const jsResampleConfig &config,
+                             jsProfileData *dst)
+{
+  if ((0 == len) || (8 > config.num_points)) {
+    return ResampleScalar(data, len, config, dst);
+  }
+
+  const bool reverse = (1 < len) && (data[0].x > data[len - 1].x);
+  const uint32_t num_points = config.num_points;
+  // the points in the order taken, padded with copies of the last point so
+  // vectors can be loaded starting at any of them
+  int32_t px[JS_PROFILE_DATA_LEN + 8];
+  int32_t py[JS_PROFILE_DATA_LEN + 8];
+  int32_t pb[JS_PROFILE_DATA_LEN + 8];
+  int32_t last[JS_PROFILE_DATA_LEN + 1];
+  uint32_t j = 0;
+
+  const __m256i rev = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  for (; (j + 8) <= len; j += 8) {
+    __m256i x, y, b;
+    Deinterleave8(&data[j], &x, &y, &b);
+    uint32_t k = j;
+    if (reverse) {
+      x = _mm256_permutevar8x32_epi32(x, rev);
+      y = _mm256_permutevar8x32_epi32(y, rev);
+      b = _mm256_permutevar8x32_epi32(b, rev);
+      k = len - j - 8;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&px[k]), x);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&py[k]), y);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&pb[k]), b);
+  }
+  for (; j < len; j++) {
+    uint32_t k = reverse ? (len - 1 - j) : j;
+    px[k] = data[j].x;
+    py[k] = data[j].y;
+    pb[k] = data[j].brightness;
+  }
+  for (j = len; j < (len + 8); j++) {
+    px[j] = px[len - 1];
+    py[j] = py[len - 1];
+    pb[j] = pb[len - 1];
+  }
+
+  // the first grid point of each point, 4 at a time; rounding the product
+  // with the reciprocal can only carry a quotient across an integer if the
+  // quotient is that integer, which then rounds up one too far
+  const __m256d start_d = _mm256_set1_pd(config.x_start);
+  const __m256d step_d = _mm256_set1_pd(config.x_step);
+  const __m256d inv_d = _mm256_set1_pd(1.0 / config.x_step);
+  const __m256d one_d = _mm256_set1_pd(1.0);
+  const __m256d zero_d = _mm256_setzero_pd();
+  const __m256d max_d = _mm256_set1_pd(num_points);
+  std::fill(last, last + num_points + 1, -1);
+  for (j = 0; (j + 4) <= len; j += 4) {
+    __m128i xi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&px[j]));
+    __m256d d = _mm256_sub_pd(_mm256_cvtepi32_pd(xi), start_d);
+    __m256d q = _mm256_round_pd(_mm256_mul_pd(d, inv_d),
+                                _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    __m256d ge = _mm256_cmp_pd(_mm256_mul_pd(_mm256_sub_pd(q, one_d), step_d),
+                               d, _CMP_GE_OQ);
+    q = _mm256_sub_pd(q, _mm256_and_pd(ge, one_d));
+    q = _mm256_min_pd(_mm256_max_pd(q, zero_d), max_d);
+    // extracted rather than stored and reloaded, which stalls store
+    // forwarding on some CPUs
+    __m128i c = _mm256_cvttpd_epi32(q);
+    last[_mm_cvtsi128_si32(c)] = static_cast<int32_t>(j);
+    last[_mm_extract_epi32(c, 1)] = static_cast<int32_t>(j + 1);
+    last[_mm_extract_epi32(c, 2)] = static_cast<int32_t>(j + 2);
+    last[_mm_extract_epi32(c, 3)] = static_cast<int32_t>(j + 3);
+  }
+  for (; j < len; j++) {
+    last[GridCeil(px[j], config, 1.0 / config.x_step)] =
+      static_cast<int32_t>(j);
+  }
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i none = _mm256_set1_epi32(-1);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i num = _mm256_set1_epi32(static_cast<int32_t>(len));
+  const __m256i gap = _mm256_set1_epi32(config.max_gap);
+  const __m256i shift1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+  const __m256i shift2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+  const __m256i shift4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+  const __m256i top = _mm256_set1_epi32(7);
+  const __m256 zero_f = _mm256_setzero_ps();
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256i invalid = _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m256i invalid_b =
+    _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_BRIGHTNESS);
+  // the grid coordinates wrap around like the scalar ones would
+  const uint32_t step8 = static_cast<uint32_t>(config.x_step) * 8;
+  const __m256i step = _mm256_set1_epi32(static_cast<int32_t>(step8));
+  __m256i gx = _mm256_add_epi32(
+    _mm256_set1_epi32(config.x_start),
+    _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                       _mm256_set1_epi32(config.x_step)));
+  __m256i carry = none;
+  uint32_t count = 0;
+  uint32_t i = 0;
+
+  for (; (i + 8) <= num_points; i += 8) {
+    // running maximum across the lanes and from the previous vector
+    __m256i a =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&last[i]));
+    __m256i s;
+    s = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, shift1), none, 0x01);
+    a = _mm256_max_epi32(a, s);
+    s = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, shift2), none, 0x03);
+    a = _mm256_max_epi32(a, s);
+    s = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, shift4), none, 0x0F);
+    a = _mm256_max_epi32(a, s);
+    a = _mm256_max_epi32(a, carry);
+    carry = _mm256_permutevar8x32_epi32(a, top);
+
+    // the grid points of a vector mostly fall between a few consecutive
+    // points, which are loaded and permuted into place instead of gathered
+    __m256i bad = _mm256_cmpgt_epi32(zero, a);
+    __m256i ac = _mm256_max_epi32(a, zero);
+    int32_t first = _mm256_cvtsi256_si32(ac);
+    int32_t span = _mm256_cvtsi256_si32(carry) - first;
+    __m256i xa, xb, ya, yb, ba, bb;
+    if (8 > span) {
+      __m256i idx = _mm256_sub_epi32(ac, _mm256_set1_epi32(first));
+      const __m256i *p0 = reinterpret_cast<const __m256i *>(&px[first]);
+      const __m256i *p1 = reinterpret_cast<const __m256i *>(&px[first + 1]);
+      xa = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p0), idx);
+      xb = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p1), idx);
+      p0 = reinterpret_cast<const __m256i *>(&py[first]);
+      p1 = reinterpret_cast<const __m256i *>(&py[first + 1]);
+      ya = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p0), idx);
+      yb = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p1), idx);
+      p0 = reinterpret_cast<const __m256i *>(&pb[first]);
+      p1 = reinterpret_cast<const __m256i *>(&pb[first + 1]);
+      ba = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p0), idx);
+      bb = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(p1), idx);
+    } else {
+      xa = _mm256_i32gather_epi32(px, ac, 4);
+      xb = _mm256_i32gather_epi32(px + 1, ac, 4);
+      ya = _mm256_i32gather_epi32(py, ac, 4);
+      yb = _mm256_i32gather_epi32(py + 1, ac, 4);
+      ba = _mm256_i32gather_epi32(pb, ac, 4);
+      bb = _mm256_i32gather_epi32(pb + 1, ac, 4);
+    }
+
+    // same tests and order of operations as the scalar version
+    __m256i on_point = _mm256_cmpeq_epi32(xa, gx);
+    __m256i off = _mm256_xor_si256(
+      _mm256_cmpgt_epi32(num, _mm256_add_epi32(a, one)), none);
+    if (0 < config.max_gap) {
+      off = _mm256_or_si256(
+        off, _mm256_cmpgt_epi32(_mm256_sub_epi32(xb, xa), gap));
+    }
+    bad = _mm256_or_si256(bad, _mm256_andnot_si256(on_point, off));
+
+    __m256 dx = _mm256_cvtepi32_ps(_mm256_sub_epi32(xb, xa));
+    __m256 t = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(gx, xa)), dx);
+    t = _mm256_blendv_ps(t, zero_f, _mm256_cmp_ps(dx, zero_f, _CMP_EQ_OQ));
+    __m256 rise =
+      _mm256_mul_ps(t, _mm256_cvtepi32_ps(_mm256_sub_epi32(yb, ya)));
+    __m256i y = _mm256_add_epi32(ya, _mm256_cvtps_epi32(rise));
+    __m256i br = _mm256_castps_si256(
+      _mm256_blendv_ps(_mm256_castsi256_ps(bb), _mm256_castsi256_ps(ba),
+                       _mm256_cmp_ps(t, half, _CMP_LT_OQ)));
+
+    Interleave8(_mm256_blendv_epi8(gx, invalid, bad),
+                _mm256_blendv_epi8(y, invalid, bad),
+                _mm256_blendv_epi8(br, invalid_b, bad), &dst[i]);
+    count += 8 - PopCount(_mm256_movemask_ps(_mm256_castsi256_ps(bad)));
+    gx = _mm256_add_epi32(gx, step);
+  }
+
+  count += InterpolateRange(data, len, reverse, last, i,
+                            _mm256_cvtsi256_si32(carry), config, dst);
+
+  return count;
+}
+
+/*
+ * AVX-512 kernels, 16 points per iteration.
+ */
+
+/**
+ * Splits 16 consecutive `jsProfileData` structs into vectors of their X, Y
+ * and brightness values.
+ */
+JS_SIMD_TARGET("avx512f,avx512bw")
+static inline void Deinterleave16(const jsProfileData *p, __m512i *x,
+                                  __m512i *y, __m512i *b)
+{
+  const int32_t *src = reinterpret_cast<const int32_t *>(p);
+  __m512i v0 = _mm512_loadu_si512(src);
+  __m512i v1 = _mm512_loadu_si512(src + 16);
+  __m512i v2 = _mm512_loadu_si512(src + 32);
+
+  // first gather the values held by `v0` & `v1`, then those held by `v2`
+  __m512i t = _mm512_permutex2var_epi32(
+    v0, _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0),
+    v1);
+  *x = _mm512_permutex2var_epi32(
+    t,
+    _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29),
+    v2);
+  t = _mm512_permutex2var_epi32(
+    v0,
+    _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0),
+    v1);
+  *y = _mm512_permutex2var_epi32(
+    t,
+    _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30),
+    v2);
+  t = _mm512_permutex2var_epi32(
+    v0,
+    _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0),
+    v1);
+  *b = _mm512_permutex2var_epi32(
+    t,
+    _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31),
+    v2);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static inline __mmask16 InRegion16(__m512i x, __m512i y,
+                                   const jsRegion &region)
+{
+  return _mm512_cmpge_epi32_mask(x, _mm512_set1_epi32(region.x_min)) &
+         _mm512_cmple_epi32_mask(x, _mm512_set1_epi32(region.x_max)) &
+         _mm512_cmpge_epi32_mask(y, _mm512_set1_epi32(region.y_min)) &
+         _mm512_cmple_epi32_mask(y, _mm512_set1_epi32(region.y_max));
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t FindExtremeAVX512(const jsProfileData *data, uint32_t len,
+                                  const jsRegion &region, bool highest)
+{
+  const __m512i none = _mm512_set1_epi32(-1);
+  const __m512i sixteen = _mm512_set1_epi32(16);
+  __m512i best_y = _mm512_set1_epi32((highest)
+                                       ? std::numeric_limits<int32_t>::min()
+                                       : std::numeric_limits<int32_t>::max());
+  __m512i best_idx = none;
+  __m512i idx =
+    _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __m512i x, y, b;
+  uint32_t n = 0;
+
+  for (; (n + 16) <= len; n += 16) {
+    Deinterleave16(&data[n], &x, &y, &b);
+    __mmask16 better = (highest) ? _mm512_cmpgt_epi32_mask(y, best_y)
+                                 : _mm512_cmplt_epi32_mask(y, best_y);
+    better |= _mm512_cmpeq_epi32_mask(best_idx, none);
+    __mmask16 update = InRegion16(x, y, region) & better;
+    best_y = _mm512_mask_mov_epi32(best_y, update, y);
+    best_idx = _mm512_mask_mov_epi32(best_idx, update, idx);
+    idx = _mm512_add_epi32(idx, sixteen);
+  }
+
+  int32_t lanes[16];
+  _mm512_storeu_si512(lanes, best_idx);
+  uint32_t best = len;
+  for (int k = 0; k < 16; k++) {
+    if (0 > lanes[k]) {
+      continue;
+    }
+
+    uint32_t i = static_cast<uint32_t>(lanes[k]);
+    if (IsBetter(data, i, best, len, highest) ||
+        ((data[i].y == data[best].y) && (i < best))) {
+      best = i;
+    }
+  }
+
+  return FindExtremeRange(data, n, len, region, highest, best);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t CountAVX512(const jsProfileData *data, uint32_t len,
+                            const jsRegion &region)
+{
+  __m512i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 16) <= len; n += 16) {
+    Deinterleave16(&data[n], &x, &y, &b);
+    count += PopCount(InRegion16(x, y, region));
+  }
+
+  return count + CountRange(data, n, len, region);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static void SumWeightedAVX512(const jsProfileData *data, uint32_t len,
+                              const jsRegion &region, bool weighted,
+                              int64_t sums[3])
+{
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i low = _mm512_set1_epi64(0xFFFFFFFF);
+  __m512i sum_x = _mm512_setzero_si512();
+  __m512i sum_y = _mm512_setzero_si512();
+  __m512i sum_w = _mm512_setzero_si512();
+  __m512i x, y, b;
+  uint32_t n = 0;
+
+  for (; (n + 16) <= len; n += 16) {
+    Deinterleave16(&data[n], &x, &y, &b);
+    __m512i w =
+      _mm512_maskz_mov_epi32(InRegion16(x, y, region), (weighted) ? b : one);
+
+    sum_x = _mm512_add_epi64(sum_x, _mm512_mul_epi32(w, x));
+    sum_x = _mm512_add_epi64(sum_x,
+                             _mm512_mul_epi32(_mm512_srli_epi64(w, 32),
+                                              _mm512_srli_epi64(x, 32)));
+    sum_y = _mm512_add_epi64(sum_y, _mm512_mul_epi32(w, y));
+    sum_y = _mm512_add_epi64(sum_y,
+                             _mm512_mul_epi32(_mm512_srli_epi64(w, 32),
+                                              _mm512_srli_epi64(y, 32)));
+    sum_w = _mm512_add_epi64(sum_w, _mm512_and_si512(w, low));
+    sum_w = _mm512_add_epi64(sum_w, _mm512_srli_epi64(w, 32));
+  }
+
+  sums[0] += _mm512_reduce_add_epi64(sum_x);
+  sums[1] += _mm512_reduce_add_epi64(sum_y);
+  sums[2] += _mm512_reduce_add_epi64(sum_w);
+
+  SumWeightedRange(data, n, len, region, weighted, sums);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static double AreaAVX512(const jsProfileData *data, uint32_t len,
+                         const jsRegion &region, double slope,
+                         double intercept)
+{
+  const __m512d vslope = _mm512_set1_pd(slope);
+  const __m512d vintercept = _mm512_set1_pd(intercept);
+  const __m512d half = _mm512_set1_pd(0.5);
+  __m512d area = _mm512_setzero_pd();
+  __m512i x0, y0, x1, y1, b;
+  uint32_t n = 0;
+
+  for (; (n + 17) <= len; n += 16) {
+    Deinterleave16(&data[n], &x0, &y0, &b);
+    Deinterleave16(&data[n + 1], &x1, &y1, &b);
+    __mmask16 in = InRegion16(x0, y0, region) & InRegion16(x1, y1, region);
+
+    for (int h = 0; h < 2; h++) {
+      __m256i x0h = (0 == h) ? _mm512_castsi512_si256(x0)
+                             : _mm512_extracti64x4_epi64(x0, 1);
+      __m256i y0h = (0 == h) ? _mm512_castsi512_si256(y0)
+                             : _mm512_extracti64x4_epi64(y0, 1);
+      __m256i x1h = (0 == h) ? _mm512_castsi512_si256(x1)
+                             : _mm512_extracti64x4_epi64(x1, 1);
+      __m256i y1h = (0 == h) ? _mm512_castsi512_si256(y1)
+                             : _mm512_extracti64x4_epi64(y1, 1);
+      __mmask8 inh = static_cast<__mmask8>(in >> (h * 8));
+
+      __m512d x0d = _mm512_cvtepi32_pd(x0h);
+      __m512d x1d = _mm512_cvtepi32_pd(x1h);
+      __m512d h0 = _mm512_sub_pd(
+        _mm512_cvtepi32_pd(y0h),
+        _mm512_add_pd(_mm512_mul_pd(vslope, x0d), vintercept));
+      __m512d h1 = _mm512_sub_pd(
+        _mm512_cvtepi32_pd(y1h),
+        _mm512_add_pd(_mm512_mul_pd(vslope, x1d), vintercept));
+      __m512d dx = _mm512_abs_pd(_mm512_sub_pd(x1d, x0d));
+      __m512d a =
+        _mm512_mul_pd(_mm512_mul_pd(dx, _mm512_add_pd(h0, h1)), half);
+      area = _mm512_mask_add_pd(area, inh, area, a);
+    }
+  }
+
+  return _mm512_reduce_add_pd(area) +
+         AreaRange(data, n, len, region, slope, intercept);
+}
+
+/**
+ * Adds the 64 bit products of the even lanes and of the odd lanes of two
+ * vectors of 32 bit integers to a vector of 64 bit sums.
+ */
+JS_SIMD_TARGET("avx512f,avx512bw")
+static inline __m512i AddProducts8(__m512i sum, __m512i a, __m512i b)
+{
+  sum = _mm512_add_epi64(sum, _mm512_mul_epi32(a, b));
+  return _mm512_add_epi64(sum,
+                          _mm512_mul_epi32(_mm512_srli_epi64(a, 32),
+                                           _mm512_srli_epi64(b, 32)));
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static void SumMomentsAVX512(const jsProfileData *data, uint32_t len,
+                             const jsRegion &region, int64_t sums[6])
+{
+  const __m512i one = _mm512_set1_epi32(1);
+  __m512i sum[5] = {_mm512_setzero_si512(), _mm512_setzero_si512(),
+                    _mm512_setzero_si512(), _mm512_setzero_si512(),
+                    _mm512_setzero_si512()};
+  __m512i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 16) <= len; n += 16) {
+    Deinterleave16(&data[n], &x, &y, &b);
+    __mmask16 in = InRegion16(x, y, region);
+    count += PopCount(in);
+    x = _mm512_maskz_mov_epi32(in, x);
+    y = _mm512_maskz_mov_epi32(in, y);
+
+    sum[0] = AddProducts8(sum[0], x, one);
+    sum[1] = AddProducts8(sum[1], y, one);
+    sum[2] = AddProducts8(sum[2], x, x);
+    sum[3] = AddProducts8(sum[3], y, y);
+    sum[4] = AddProducts8(sum[4], x, y);
+  }
+
+  sums[0] += count;
+  for (int i = 0; i < 5; i++) {
+    sums[i + 1] += _mm512_reduce_add_epi64(sum[i]);
+  }
+
+  SumMomentsRange(data, n, len, region, sums);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t CountNearLineAVX512(const jsProfileData *data, uint32_t len,
+                                    double normal_x, double normal_y,
+                                    double offset, double tolerance)
+{
+  const __m512d vnormal_x = _mm512_set1_pd(normal_x);
+  const __m512d vnormal_y = _mm512_set1_pd(normal_y);
+  const __m512d voffset = _mm512_set1_pd(offset);
+  const __m512d vtolerance = _mm512_set1_pd(tolerance);
+  __m512i x, y, b;
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 16) <= len; n += 16) {
+    Deinterleave16(&data[n], &x, &y, &b);
+
+    for (int h = 0; h < 2; h++) {
+      __m256i xh = (0 == h) ? _mm512_castsi512_si256(x)
+                            : _mm512_extracti64x4_epi64(x, 1);
+      __m256i yh = (0 == h) ? _mm512_castsi512_si256(y)
+                            : _mm512_extracti64x4_epi64(y, 1);
+
+      __m512d d = _mm512_sub_pd(
+        _mm512_add_pd(_mm512_mul_pd(vnormal_x, _mm512_cvtepi32_pd(xh)),
+                      _mm512_mul_pd(vnormal_y, _mm512_cvtepi32_pd(yh))),
+        voffset);
+      count += PopCount(
+        _mm512_cmp_pd_mask(_mm512_abs_pd(d), vtolerance, _CMP_LE_OQ));
+    }
+  }
+
+  return count + CountNearLineRange(data, n, len, normal_x, normal_y, offset,
+                                    tolerance);
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static void SumConicMomentsAVX512(const double *u, const double *v,
+                                  uint32_t len, double sums[14])
+{
+  __m512d sum[14];
+  uint32_t n = 0;
+
+  for (int i = 0; i < 14; i++) {
+    sum[i] = _mm512_setzero_pd();
+  }
+
+  // the coordinates are doubles, 8 points per iteration
+  for (; (n + 8) <= len; n += 8) {
+    __m512d vu = _mm512_loadu_pd(&u[n]);
+    __m512d vv = _mm512_loadu_pd(&v[n]);
+    __m512d uu = _mm512_mul_pd(vu, vu);
+    __m512d uv = _mm512_mul_pd(vu, vv);
+    __m512d v2 = _mm512_mul_pd(vv, vv);
+
+    sum[0] = _mm512_add_pd(sum[0], vu);
+    sum[1] = _mm512_add_pd(sum[1], vv);
+    sum[2] = _mm512_add_pd(sum[2], uu);
+    sum[3] = _mm512_add_pd(sum[3], uv);
+    sum[4] = _mm512_add_pd(sum[4], v2);
+    sum[5] = _mm512_add_pd(sum[5], _mm512_mul_pd(uu, vu));
+    sum[6] = _mm512_add_pd(sum[6], _mm512_mul_pd(uu, vv));
+    sum[7] = _mm512_add_pd(sum[7], _mm512_mul_pd(vu, v2));
+    sum[8] = _mm512_add_pd(sum[8], _mm512_mul_pd(v2, vv));
+    sum[9] = _mm512_add_pd(sum[9], _mm512_mul_pd(uu, uu));
+    sum[10] = _mm512_add_pd(sum[10], _mm512_mul_pd(uu, uv));
+    sum[11] = _mm512_add_pd(sum[11], _mm512_mul_pd(uu, v2));
+    sum[12] = _mm512_add_pd(sum[12], _mm512_mul_pd(uv, v2));
+    sum[13] = _mm512_add_pd(sum[13], _mm512_mul_pd(v2, v2));
+  }
+
+  for (int i = 0; i < 14; i++) {
+    sums[i] += _mm512_reduce_add_pd(sum[i]);
+  }
+
+  SumConicMomentsRange(u, v, n, len, sums);
+}
+#endif // JS_SIMD_X86
+
+// Ordered the same as the table in `SimdKernels.cpp`.
+static const ReductionKernels kReductionKernels[] = {
+  {JS_SIMD_VARIANT_SCALAR, FindExtremeScalar, CountScalar, SumWeightedScalar,
+   AreaScalar, SumMomentsScalar, CountNearLineScalar, SumConicMomentsScalar,
+   ResampleScalar},
+#ifdef JS_SIMD_X86
+  // deinterleaving the profile data makes use of cross lane permutes that
+  // were introduced with AVX2, the scalar versions are used for SSE4.2
+  {JS_SIMD_VARIANT_SSE42, FindExtremeScalar, CountScalar, SumWeightedScalar,
+   AreaScalar, SumMomentsScalar, CountNearLineScalar, SumConicMomentsScalar,
+   ResampleScalar},
+  {JS_SIMD_VARIANT_AVX2, FindExtremeAVX2, CountAVX2, SumWeightedAVX2,
+   AreaAVX2, SumMomentsAVX2, CountNearLineAVX2, SumConicMomentsAVX2,
+   ResampleAVX2},
+  // resampling is bound by the permutes and the scatter of the segment
+  // search, wider vectors gain little over the AVX2 version
+  {JS_SIMD_VARIANT_AVX512, FindExtremeAVX512, CountAVX512, SumWeightedAVX512,
+   AreaAVX512, SumMomentsAVX512, CountNearLineAVX512, SumConicMomentsAVX512,
+   ResampleAVX2},
+#endif
+};
+
+static const int kNumReductionKernels =
+  sizeof(kReductionKernels) / sizeof(kReductionKernels[0]);
+
+const ReductionKernels &joescan::GetReductionKernels()
+{
+  static const ReductionKernels &kernels =
+    *GetReductionKernels(GetSimdKernels().variant);
+  return kernels;
+}
+
+const ReductionKernels *joescan::GetReductionKernels(jsSimdVariant variant)
+{
+  // the decode kernels already determine which variants the CPU supports
+  if (nullptr == GetSimdKernels(variant)) {
+    return nullptr;
+  }
+
+  for (int n = 0; n < kNumReductionKernels; n++) {
+    if (variant == kReductionKernels[n].variant) {
+      return &kReductionKernels[n];
+    }
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_REDUCTION_KERNELS_H
+#define JOESCAN_REDUCTION_KERNELS_H
+
+#include <cstdint>
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Table of kernels reducing profile data to a single value or
+ * resampling it, built for multiple instruction sets like `SimdKernels`. All kernels expect an array
+ * holding only valid points, such as the `data` array of a `jsProfile`; arrays
+ * with invalid entries must first be compacted with `SimdKernels::copy_valid`.
+ */
+struct ReductionKernels {
+  /** @brief The instruction set this table of kernels was built for. */
+  jsSimdVariant variant;
+
+  /**
+   * Finds the point with the greatest or least Y coordinate within a region,
+   * the first one found in case of a tie.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param region The region to search within.
+   * @param highest Set to `true` to find the greatest Y coordinate, `false`
+   * to find the least.
+   * @return Index of the point found, `len` if there are no points within
+   * the region.
+   */
+  uint32_t (*find_extreme)(const jsProfileData *data, uint32_t len,
+                           const jsRegion &region, bool highest);
+
+  /**
+   * Counts the points within a region.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param region The region to count points within.
+   * @return The number of points within the region.
+   */
+  uint32_t (*count)(const jsProfileData *data, uint32_t len,
+                    const jsRegion &region);
+
+  /**
+   * Sums the weighted coordinates and weights of the points within a region;
+   * the sums are exact.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param region The region to consider points within.
+   * @param weighted Set to `true` to weigh each point by its brightness,
+   * `false` to weigh all points equally.
+   * @param sums Updated with the sums of weighted X, weighted Y and weights.
+   */
+  void (*sum_weighted)(const jsProfileData *data, uint32_t len,
+                       const jsRegion &region, bool weighted, int64_t sums[3]);
+
+  /**
+   * Integrates the area between the polyline joining consecutive points and
+   * a reference line, over the segments with both ends within a region. The
+   * summation order differs between variants, so results may differ in the
+   * least significant bits.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param region The region to consider points within.
+   * @param slope The slope of the reference line.
+   * @param intercept The Y coordinate of the reference line at X of zero.
+   * @return The signed area.
+   */
+  double (*area)(const jsProfileData *data, uint32_t len,
+                 const jsRegion &region, double slope, double intercept);
+
+  /**
+   * Sums the coordinates and the products of the coordinates of the points
+   * within a region, the moments needed for a least squares line fit; the
+   * sums are exact.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param region The region to consider points within.
+   * @param sums Updated with the number of points, the sums of X, Y, X*X, Y*Y
+   * and X*Y, in that order.
+   */
+  void (*sum_moments)(const jsProfileData *data, uint32_t len,
+                      const jsRegion &region, int64_t sums[6]);
+
+  /**
+   * Counts the points within a distance of a line given in normal form,
+   * `normal_x * x + normal_y * y = offset`.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param normal_x The X component of the unit normal of the line.
+   * @param normal_y The Y component of the unit normal of the line.
+   * @param offset The distance of the line from the origin.
+   * @param tolerance The greatest distance from the line to count a point.
+   * @return The number of points within the distance.
+   */
+  uint32_t (*count_near_line)(const jsProfileData *data, uint32_t len,
+                              double normal_x, double normal_y, double offset,
+                              double tolerance);
+
+  /**
+   * Sums the monomials up to the fourth degree of normalized coordinates, the
+   * moments needed for a least squares conic fit. The summation order differs
+   * between variants, so results may differ in the least significant bits.
+   *
+   * @param u Array of normalized X coordinates.
+   * @param v Array of normalized Y coordinates.
+   * @param len The length of the arrays.
+   * @param sums Updated with the sums of u, v, u^2, uv, v^2, u^3, u^2v, uv^2,
+   * v^3, u^4, u^3v, u^2v^2, uv^3 and v^4, in that order.
+   */
+  void (*sum_conic_moments)(const double *u, const double *v, uint32_t len,
+                            double sums[14]);
+
+  /**
+   * Resamples the points onto a grid of evenly spaced X coordinates. The
+   * points are taken in order along X, increasing or decreasing; each point
+   * marks the first grid point at or past it and a running maximum over the
+   * grid finds the segment each grid point lies on.
+   *
+   * @param data The array of valid points.
+   * @param len The length of the array.
+   * @param config The grid to resample onto, its number of points at most
+   * `JS_PROFILE_DATA_LEN`.
+   * @param dst Array of `num_points` entries to be updated with the grid
+   * points; entries that could not be interpolated are invalid.
+   * @return The number of valid grid points.
+   */
+  uint32_t (*resample)(const jsProfileData *data, uint32_t len,
+                       const jsResampleConfig &config, jsProfileData *dst);
+};
+
+/**
+ * Obtains the reduction kernels built for the same instruction set as the
+ * table returned by `GetSimdKernels`.
+ *
+ * @return Reference to the selected kernel table.
+ */
+const ReductionKernels &GetReductionKernels();
+
+/**
+ * Obtains the reduction kernels built for a specific instruction set.
+ *
+ * @param variant The instruction set of the kernels.
+ * @return Pointer to the kernel table, `nullptr` if the variant was not built
+ * or is not supported by the CPU.
+ */
+const ReductionKernels *GetReductionKernels(jsSimdVariant variant);
+} // namespace joescan
+
+#endif // JOESCAN_REDUCTION_KERNELS_H
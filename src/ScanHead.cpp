@@ -13,7 +13,10 @@
 using namespace joescan;
 
 ScanHead::ScanHead(ScanManager &manager, ScanHeadShared &shared)
-  : scan_manager(manager), shared(shared), ip_address(0)
+  : scan_manager(manager),
+    shared(shared),
+    exposure_mode(JS_CAMERA_EXPOSURE_MODE_INTERLEAVED),
+    ip_address(0)
 {
 }
 
@@ -74,17 +77,36 @@ std::vector<std::shared_ptr<Profile>> ScanHead::GetProfiles(int max)
   return shared.PopProfiles(max);
 }
 
+std::vector<std::shared_ptr<Profile>> ScanHead::GetProfiles(jsCamera camera,
+                                                            jsLaser laser,
+                                                            int max)
+{
+  return shared.PopProfiles(camera, laser, max);
+}
+
 uint32_t ScanHead::AvailableProfiles()
 {
   return shared.AvailableProfiles();
 }
 
+uint32_t ScanHead::AvailableProfiles(jsCamera camera, jsLaser laser)
+{
+  return shared.AvailableProfiles(camera, laser);
+}
+
 uint32_t ScanHead::WaitUntilAvailableProfiles(uint32_t count,
                                               uint32_t timeout_us)
 {
   return shared.WaitUntilAvailableProfiles(count, timeout_us);
 }
 
+uint32_t ScanHead::WaitUntilAvailableProfiles(jsCamera camera, jsLaser laser,
+                                              uint32_t count,
+                                              uint32_t timeout_us)
+{
+  return shared.WaitUntilAvailableProfiles(camera, laser, count, timeout_us);
+}
+
 StatusMessage ScanHead::GetStatusMessage() const
 {
   return shared.GetStatusMessage();
@@ -105,6 +127,16 @@ jsDataFormat ScanHead::GetDataFormat() const
   return data_format;
 }
 
+void ScanHead::SetCameraExposureMode(jsCameraExposureMode mode)
+{
+  exposure_mode = mode;
+}
+
+jsCameraExposureMode ScanHead::GetCameraExposureMode() const
+{
+  return exposure_mode;
+}
+
 ScanHeadTemperatures ScanHead::GetTemperatures()
 {
   httplib::Client cli(ip_address_str, kRESTport);
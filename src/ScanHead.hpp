@@ -108,6 +108,16 @@ class ScanHead {
    */
   uint32_t AvailableProfiles();
 
+  /**
+   * Returns the number of profiles from a camera and laser pair that are
+   * available to be read.
+   *
+   * @param camera The camera of the profiles.
+   * @param laser The laser of the profiles.
+   * @return The number of profiles able to be read.
+   */
+  uint32_t AvailableProfiles(jsCamera camera, jsLaser laser);
+
   /**
    * Blocks until the number of profiles requested are available to be read.
    *
@@ -117,6 +127,19 @@ class ScanHead {
    */
   uint32_t WaitUntilAvailableProfiles(uint32_t count, uint32_t timeout_us);
 
+  /**
+   * Blocks until the number of profiles requested from a camera and laser
+   * pair are available to be read.
+   *
+   * @param camera The camera of the profiles.
+   * @param laser The laser of the profiles.
+   * @param count The desired number of profiles to wait for.
+   * @param timeout_us The max time to wait for in microseconds.
+   * @return The number of profiles able to be read.
+   */
+  uint32_t WaitUntilAvailableProfiles(jsCamera camera, jsLaser laser,
+                                      uint32_t count, uint32_t timeout_us);
+
   /**
    * Obtains up to the number of scanning profiles requested from the scan
    * head. Note, if the total number of profiles returned from the scan
@@ -128,6 +151,19 @@ class ScanHead {
    */
   std::vector<std::shared_ptr<Profile>> GetProfiles(int max);
 
+  /**
+   * Obtains up to the number of scanning profiles requested from a camera
+   * and laser pair of the scan head, leaving the profiles of other pairs in
+   * place.
+   *
+   * @param camera The camera of the profiles.
+   * @param laser The laser of the profiles.
+   * @param max The maximum number of profiles to return.
+   * @return Vector holding references to profile data.
+   */
+  std::vector<std::shared_ptr<Profile>> GetProfiles(jsCamera camera,
+                                                    jsLaser laser, int max);
+
   /**
    * Obtains the last reported status message from a scan head. Note, status
    * messages are only sent by the scan head when not actively scanning.
@@ -155,6 +191,20 @@ class ScanHead {
    */
   jsDataFormat GetDataFormat() const;
 
+  /**
+   * Sets whether the cameras of the scan head expose in turn or together.
+   *
+   * @param mode The camera exposure mode.
+   */
+  void SetCameraExposureMode(jsCameraExposureMode mode);
+
+  /**
+   * Gets whether the cameras of the scan head expose in turn or together.
+   *
+   * @return The camera exposure mode.
+   */
+  jsCameraExposureMode GetCameraExposureMode() const;
+
   ScanHeadTemperatures GetTemperatures();
 
   /**
@@ -167,6 +217,7 @@ class ScanHead {
   ScanManager &scan_manager;
   ScanHeadShared &shared;
   jsDataFormat data_format;
+  jsCameraExposureMode exposure_mode;
 
   uint32_t ip_address;
   std::string ip_address_str;
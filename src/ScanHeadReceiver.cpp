@@ -9,7 +9,9 @@
 #include <memory>
 #include <sstream>
 
+#include "MissingColumns.hpp"
 #include "ScanHeadReceiver.hpp"
+#include "SimdKernels.hpp"
 #include "joescan_pinchot.h"
 
 using namespace joescan;
@@ -18,7 +20,8 @@ ScanHeadReceiver::ScanHeadReceiver(ScanHeadShared &shared) : shared(shared)
 {
   packet_buf = new uint8_t[kMaxPacketSize];
   packet_buf_len = kMaxPacketSize;
-  profile_ptr = nullptr;
+  last_data_ns = 0;
+  is_stalled = false;
   state = RECEIVER_STOP;
 
   {
@@ -60,11 +63,19 @@ void ScanHeadReceiver::Start()
 {
   {
     std::lock_guard<std::mutex> lk(lock);
-    profile_ptr = nullptr;
     packets_received = 0;
     complete_profiles_received = 0;
-    last_profile_source = 0;
-    last_profile_timestamp = 0;
+    for (ProfileAssembly &assembly : assemblies) {
+      assembly = ProfileAssembly();
+    }
+    last_data_ns = 0;
+    is_stalled = false;
+    shared.GetEncoderKinematics().Reset();
+    shared.GetLatestProfile().Reset();
+    shared.GetPresenceDetector().Reset();
+    shared.GetProfileHistory().Reset();
+    shared.GetTemporalFilter().Reset();
+    shared.ResetWatermark();
     state = RECEIVER_START;
     shared.EnableWaitUntilAvailable();
   }
@@ -120,39 +131,68 @@ void ScanHeadReceiver::ReceiveMain()
         // Activity indicated, read out data from socket.
         int num_bytes =
           recv(sockfd, reinterpret_cast<char *>(packet_buf), packet_buf_len, 0);
+        // arrival time for the clock model, taken before anything else delays
+        // it
+        uint64_t host_ns = GetHostTimeNs();
 
         // Check to make sure we are still running in case recv returns due to
         // its socket fd being closed.
         if (RECEIVER_START == state) {
           std::lock_guard<std::mutex> lk(lock);
 
-          if (static_cast<std::size_t>(num_bytes) < sizeof(DatagramHeader)) {
-            throw std::runtime_error("Short header");
-          }
-
-          uint16_t magic = (packet_buf[0] << 8) | (packet_buf[1]);
-          if (kDataMagic == magic) {
-            packets_received++;
-
-            DataPacket packet(packet_buf, num_bytes, 0);
-            ProcessPacket(packet);
-          } else if (kResponseMagic == magic) {
-            StatusMessage status_message = StatusMessage(packet_buf, num_bytes);
-            expected_packets_received = status_message.GetNumPacketsSent();
-            expected_profiles_received = status_message.GetNumProfilesSent();
-            shared.SetStatusMessage(status_message);
-          } else {
-            throw std::runtime_error("Unknown magic");
+          // a bad datagram is reported and dropped, the thread carries on
+          try {
+            if (static_cast<std::size_t>(num_bytes) < sizeof(DatagramHeader)) {
+              throw std::runtime_error("Short header");
+            }
+
+            uint16_t magic = (packet_buf[0] << 8) | (packet_buf[1]);
+            if (kDataMagic == magic) {
+              packets_received++;
+              if (is_stalled) {
+                is_stalled = false;
+                shared.GetSystemEvents().Post(JS_SYSTEM_EVENT_SCAN_HEAD_RESUMED,
+                                              shared.GetId(), 0);
+              }
+              last_data_ns = host_ns;
+
+              DataPacket packet(packet_buf, num_bytes, 0);
+              ProcessPacket(packet, host_ns);
+            } else if (kResponseMagic == magic) {
+              StatusMessage status_message =
+                StatusMessage(packet_buf, num_bytes);
+              // status is only sent once the scan head stops, the rest of
+              // the profiles being assembled is not coming and neither are
+              // profiles to confirm a piece
+              PushIncompleteProfiles(UINT64_MAX);
+              shared.ReleaseHeldProfiles();
+              last_data_ns = 0;
+              is_stalled = false;
+              expected_packets_received = status_message.GetNumPacketsSent();
+              expected_profiles_received = status_message.GetNumProfilesSent();
+              shared.GetClockModel().AddStatus(status_message.GetGlobalTime(),
+                                               host_ns);
+              shared.SetStatusMessage(status_message);
+            } else {
+              throw std::runtime_error("Unknown magic");
+            }
+          } catch (std::exception &e) {
+            (void)e;
+            shared.GetSystemEvents().Post(JS_SYSTEM_EVENT_INVALID_DATAGRAM,
+                                          shared.GetId(), num_bytes);
           }
         }
+      } else if (0 == ret) {
+        std::lock_guard<std::mutex> lk(lock);
+        CheckStalled(GetHostTimeNs());
       }
     }
   }
 }
 
-void ScanHeadReceiver::ProcessPacket(DataPacket &packet)
+void ScanHeadReceiver::ProcessPacket(DataPacket &packet, uint64_t host_ns)
 {
-  uint32_t source = 0;
+  const SimdKernels &kernels = GetSimdKernels();
   uint64_t timestamp = 0;
   uint32_t raw_bytes_len = 0;
   uint8_t *raw_bytes = packet.GetRawBytes(&raw_bytes_len);
@@ -160,107 +200,130 @@ void ScanHeadReceiver::ProcessPacket(DataPacket &packet)
   uint32_t current_packet = packet.GetPartNum();
   DataType datatype_mask = packet.GetContents();
 
-  source = packet.GetSourceId();
+  jsCamera camera = packet.GetCamera();
+  jsLaser laser = packet.GetLaser();
+  if ((0 > camera) || (JS_CAMERA_MAX <= camera) || (0 > laser) ||
+      (JS_LASER_MAX <= laser)) {
+    throw std::runtime_error("Invalid source");
+  }
+
+  ProfileAssembly &assembly = assemblies[camera * JS_LASER_MAX + laser];
+  std::shared_ptr<Profile> &profile_ptr = assembly.profile;
   timestamp = packet.GetTimeStamp();
 
-  if ((source != last_profile_source) ||
-      (timestamp != last_profile_timestamp)) {
+  if (timestamp != assembly.timestamp) {
+    // profiles are sent in the order taken; with the cameras exposing
+    // simultaneously the datagrams of both are mixed, so only the profiles
+    // taken before this one are given up on
+    PushIncompleteProfiles(timestamp);
     if (nullptr != profile_ptr) {
       // have a partial profile, push it back despite loss
-      profile_ptr->SetUDPPacketInfo(packets_received_for_profile,
-                                    total_packets);
+      PushIncompleteProfile(assembly);
+    }
 
-      shared.PushProfile(profile_ptr);
+    assembly.timestamp = timestamp;
+    assembly.packets_received = 0;
+    assembly.packets_expected = total_packets;
+    assembly.parts_received.assign(total_packets, false);
+    assembly.start_column = packet.GetStartColumn();
+    assembly.end_column = packet.GetEndColumn();
+    assembly.step = 0;
+    if (datatype_mask & DataType::XYData) {
+      assembly.step = packet.GetFragmentLayout(DataType::XYData).step;
+    } else if (datatype_mask & DataType::Subpixel) {
+      assembly.step = packet.GetFragmentLayout(DataType::Subpixel).step;
+    } else if (datatype_mask & DataType::Brightness) {
+      assembly.step = packet.GetFragmentLayout(DataType::Brightness).step;
     }
 
-    last_profile_source = source;
-    last_profile_timestamp = timestamp;
-    packets_received_for_profile = 0;
+    // the first packet of a profile arrives with the least delay
+    shared.GetClockModel().AddProfile(camera, timestamp, host_ns);
 
     profile_ptr = std::make_shared<Profile>(datatype_mask);
     profile_ptr->SetScanHead(packet.GetScanHeadId());
-    profile_ptr->SetCamera(packet.GetCamera());
-    profile_ptr->SetLaser(packet.GetLaser());
+    profile_ptr->SetCamera(camera);
+    profile_ptr->SetLaser(laser);
     profile_ptr->SetTimestamp(packet.GetTimeStamp());
     profile_ptr->SetLaserOnTime(packet.GetLaserOnTime());
     profile_ptr->SetExposureTime(packet.GetExposureTime());
     if (0 != packet.NumEncoderVals()) {
-      profile_ptr->SetEncoderValues(packet.GetEncoderValues());
+      std::vector<int64_t> encoders = packet.GetEncoderValues();
+      EncoderKinematics &kinematics = shared.GetEncoderKinematics();
+
+      profile_ptr->SetEncoderValues(encoders);
+      if (kinematics.IsEnabled()) {
+        kinematics.Update(timestamp, encoders,
+                          profile_ptr->GetKinematicsPointer());
+      }
     }
+  } else if (nullptr == profile_ptr) {
+    // a duplicate of a datagram of a profile already pushed
+    return;
   }
 
   if (datatype_mask & DataType::Brightness) {
     FragmentLayout layout = packet.GetFragmentLayout(DataType::Brightness);
-    const uint32_t start_column = packet.GetStartColumn();
-    uint32_t idx = 0;
-
-    for (unsigned int j = 0; j < layout.num_vals; j++) {
-      idx = (j * total_packets + current_packet) * layout.step + start_column;
-
-      uint8_t brightness = raw_bytes[layout.offset + j];
-      if (JS_PROFILE_DATA_INVALID_BRIGHTNESS != brightness) {
-        profile_ptr->InsertBrightness(idx, brightness);
-      }
-    }
+    uint32_t idx = packet.GetStartColumn() + current_packet * layout.step;
+    uint32_t stride = total_packets * layout.step;
+    uint32_t count = 0;
+
+    count = kernels.decode_brightness(
+      &(raw_bytes[layout.offset]), layout.num_vals,
+      profile_ptr->GetDataPointer(), idx, stride,
+      profile_ptr->GetDataLength());
+    profile_ptr->AddValidBrightness(count);
   }
 
-  if (datatype_mask & DataType::XYData) {
-    FragmentLayout layout = packet.GetFragmentLayout(DataType::XYData);
-    uint32_t m = 0;
-    uint32_t n = layout.offset;
-    int16_t x_raw = 0;
-    int16_t y_raw = 0;
-    int camera_id = packet.GetCamera();
-    AlignmentParams alignment = shared.GetConfiguration().Alignment(camera_id);
-
-    for (unsigned int j = 0; j < layout.num_vals; j++) {
-      x_raw = htons(*(reinterpret_cast<int16_t *>(&(raw_bytes[n]))));
-      n += sizeof(int16_t);
-      y_raw = htons(*(reinterpret_cast<int16_t *>(&(raw_bytes[n]))));
-      n += sizeof(int16_t);
-
-      if ((JS_PROFILE_DATA_INVALID_XY != x_raw) &&
-          (JS_PROFILE_DATA_INVALID_XY != y_raw)) {
-        int32_t x = static_cast<int32_t>(x_raw);
-        int32_t y = static_cast<int32_t>(y_raw);
-        Point2D<int32_t> point = alignment.CameraToMill(x, y);
-
-        // destination
-        m = packet.GetStartColumn();
-        m += (j * total_packets + current_packet) * layout.step;
-        profile_ptr->InsertPoint(m, point);
+  if (datatype_mask & (DataType::XYData | DataType::Subpixel)) {
+    uint32_t count = 0;
+    AlignmentParams alignment = shared.GetConfiguration().Alignment(camera);
+    CameraToMillCoefficients c = alignment.GetCameraToMillCoefficients();
+    double units_per_inch = shared.GetFloatOutput();
+    float *float_x = nullptr;
+    float *float_y = nullptr;
+
+    if (0.0 != units_per_inch) {
+      if (!profile_ptr->HasFloatData()) {
+        profile_ptr->AddFloatData();
       }
+      // mill coordinates are in 1/1000 inches
+      c.float_scale = units_per_inch / 1000.0;
+      float_x = profile_ptr->GetFloatXPointer();
+      float_y = profile_ptr->GetFloatYPointer();
     }
-  }
 
-#if 0
-  // TODO: FKS-252
-  // Support in the future. How do we expose Subpixel data? Don't think we want
-  // normal customers to use it, just internal/special customers.
-  if (datatype_mask & DataType::Subpixel) {
-    FragmentLayout layout = packet.GetFragmentLayout(DataType::Subpixel);
-    uint32_t m = 0;
-    uint32_t n = layout.offset;
-    uint16_t pixel = 0;
-
-    for (unsigned int j = 0; j < layout.num_vals; j++) {
-      pixel = htons(*(reinterpret_cast<uint16_t *>(&(raw_bytes[n]))));
-      n += sizeof(uint16_t);
-
-      if (kInvalidSubpixel != pixel) {
-        m = packet.GetStartColumn();
-        m += (j * total_packets + current_packet) * layout.step;
-
-        Point2D point(pixel, m);
-        profile_ptr->InsertPixelCoordinate(m, point);
+    // the camera to mill transform, the float output and the profile summary
+    // are fused into the decode so that each point is only touched once
+    if (datatype_mask & DataType::XYData) {
+      FragmentLayout layout = packet.GetFragmentLayout(DataType::XYData);
+      uint32_t idx = packet.GetStartColumn() + current_packet * layout.step;
+      uint32_t stride = total_packets * layout.step;
+
+      count = kernels.decode_xy(&(raw_bytes[layout.offset]), layout.num_vals,
+                                c, profile_ptr->GetDataPointer(), float_x,
+                                float_y, idx, stride,
+                                profile_ptr->GetDataLength(),
+                                profile_ptr->GetSummaryPointer());
+    } else {
+      FragmentLayout layout = packet.GetFragmentLayout(DataType::Subpixel);
+      uint32_t idx = packet.GetStartColumn() + current_packet * layout.step;
+      uint32_t stride = total_packets * layout.step;
+      MappingTable &table = shared.GetMappingTable(camera);
+
+      // the table can not change while scanning
+      if (table.IsLoaded()) {
+        count = kernels.decode_subpixel(
+          &(raw_bytes[layout.offset]), layout.num_vals, table.GetLookup(), c,
+          profile_ptr->GetDataPointer(), float_x, float_y, idx, stride,
+          profile_ptr->GetDataLength(), profile_ptr->GetSummaryPointer());
       }
     }
+    profile_ptr->AddValidGeometry(count);
   }
-#endif
 
   if (datatype_mask & DataType::Image) {
     // skip subpixel packet
-    if ((packets_received_for_profile + 1) != total_packets) {
+    if ((assembly.packets_received + 1) != total_packets) {
       FragmentLayout layout = packet.GetFragmentLayout(DataType::Image);
       uint32_t len = kImageDataSize;
       uint32_t m = current_packet * len;
@@ -272,8 +335,12 @@ void ScanHeadReceiver::ProcessPacket(DataPacket &packet)
     }
   }
 
-  packets_received_for_profile++;
-  if (packets_received_for_profile == total_packets) {
+  if (current_packet < assembly.parts_received.size()) {
+    assembly.parts_received[current_packet] = true;
+  }
+
+  assembly.packets_received++;
+  if (assembly.packets_received == total_packets) {
     // received all packets for the profile
     profile_ptr->SetUDPPacketInfo(total_packets, total_packets);
     shared.PushProfile(profile_ptr);
@@ -281,3 +348,53 @@ void ScanHeadReceiver::ProcessPacket(DataPacket &packet)
     complete_profiles_received++;
   }
 }
+
+void ScanHeadReceiver::CheckStalled(uint64_t host_ns)
+{
+  if ((0 == last_data_ns) || is_stalled ||
+      (host_ns - last_data_ns < kStalledNs)) {
+    return;
+  }
+
+  is_stalled = true;
+  shared.GetSystemEvents().Post(
+    JS_SYSTEM_EVENT_SCAN_HEAD_STALLED, shared.GetId(),
+    static_cast<int64_t>((host_ns - last_data_ns) / 1000000));
+}
+
+void ScanHeadReceiver::PushIncompleteProfile(ProfileAssembly &assembly)
+{
+  shared.GetSystemEvents().Post(
+    JS_SYSTEM_EVENT_PROFILE_INCOMPLETE, shared.GetId(),
+    assembly.packets_expected - assembly.packets_received);
+
+  assembly.profile->SetUDPPacketInfo(assembly.packets_received,
+                                     assembly.packets_expected);
+  assembly.profile->SetMissingColumns(
+    FindMissingColumns(assembly.parts_received, assembly.start_column,
+                       assembly.end_column, assembly.step));
+
+  shared.PushProfile(assembly.profile);
+  assembly.profile = nullptr;
+}
+
+void ScanHeadReceiver::PushIncompleteProfiles(uint64_t timestamp)
+{
+  // oldest first, profiles are buffered in the order taken
+  for (;;) {
+    ProfileAssembly *oldest = nullptr;
+
+    for (ProfileAssembly &assembly : assemblies) {
+      if ((nullptr != assembly.profile) && (timestamp > assembly.timestamp) &&
+          ((nullptr == oldest) || (oldest->timestamp > assembly.timestamp))) {
+        oldest = &assembly;
+      }
+    }
+
+    if (nullptr == oldest) {
+      break;
+    }
+
+    PushIncompleteProfile(*oldest);
+  }
+}
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace joescan {
 class ScanManager;
@@ -47,21 +48,41 @@ class ScanHeadReceiver {
     RECEIVER_SHUTDOWN,
   };
 
+  // a profile being assembled out of its datagrams
+  struct ProfileAssembly {
+    // `nullptr` once the profile is pushed
+    std::shared_ptr<Profile> profile;
+    uint64_t timestamp = 0;
+    uint32_t packets_received = 0;
+    uint32_t packets_expected = 0;
+    // the datagrams received and the columns they are dealt out over, to
+    // find the columns lost with the others
+    std::vector<bool> parts_received;
+    uint32_t start_column = 0;
+    uint32_t end_column = 0;
+    uint32_t step = 0;
+  };
+
   void ReceiveMain();
-  void ProcessPacket(DataPacket &packet);
+  void ProcessPacket(DataPacket &packet, uint64_t host_ns);
+  void PushIncompleteProfile(ProfileAssembly &assembly);
+  void PushIncompleteProfiles(uint64_t timestamp);
+  void CheckStalled(uint64_t host_ns);
 
   // The JS-50 theoretical max packet size is 8k plus header, in reality the
   // max size is 1456 * 4 + header. Using 6k.
   static const int kMaxPacketSize = 6144;
   // JS-50 in image mode will have 4 rows of 1456 pixels for each packet.
   static const int kImageDataSize = 4 * 1456;
+  // time without any datagram while profiles are expected for the scan head
+  // to be reported as stalled
+  static const uint64_t kStalledNs = 1000000000;
+  static const int kMaxSources = JS_CAMERA_MAX * JS_LASER_MAX;
 
   std::condition_variable sync;
   std::mutex lock;
   std::thread receiver;
 
-  std::shared_ptr<Profile> profile_ptr;
-
   ScanHeadShared &shared;
   std::atomic<enum ScanHeadReceiverState> state;
   SOCKET sockfd;
@@ -69,12 +90,16 @@ class ScanHeadReceiver {
   uint8_t *packet_buf;
   uint32_t packet_buf_len;
   uint64_t packets_received;
-  uint32_t packets_received_for_profile;
+  // one for each camera and laser pair; the cameras of a scan head in
+  // simultaneous exposure send the datagrams of their profiles mixed
+  ProfileAssembly assemblies[kMaxSources];
   uint64_t complete_profiles_received;
   uint64_t expected_packets_received;
   uint64_t expected_profiles_received;
-  uint32_t last_profile_source;
-  uint64_t last_profile_timestamp;
+  // host time of the last profile datagram, `0` once the scan head reported
+  // its status on stopping and no more are expected
+  uint64_t last_data_ns;
+  bool is_stalled;
 };
 } // namespace joescan
 
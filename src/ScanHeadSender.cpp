@@ -19,7 +19,7 @@ using std::chrono::milliseconds;
 using std::chrono::seconds;
 using std::chrono::steady_clock;
 
-ScanHeadSender::ScanHeadSender()
+ScanHeadSender::ScanHeadSender(SystemEvents &events) : events(events)
 {
   is_running = true;
   is_scanning = false;
@@ -123,6 +123,7 @@ void ScanHeadSender::SendMain()
                          sizeof(scanner_addr));
 
           if (0 >= r) {
+            events.Post(JS_SYSTEM_EVENT_SEND_FAILED, UINT32_MAX, ip_addr);
             std::stringstream error_msg;
             error_msg << "Failed sendto IP address " << std::hex << ip_addr;
             throw std::runtime_error(error_msg.str());
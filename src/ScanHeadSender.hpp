@@ -12,6 +12,7 @@
 #include "Profile.hpp"
 #include "NetworkIncludes.hpp"
 #include "StatusMessage.hpp"
+#include "SystemEvents.hpp"
 
 #include <atomic>
 #include <condition_variable>
@@ -22,7 +23,7 @@
 namespace joescan {
 class ScanHeadSender {
  public:
-  ScanHeadSender();
+  ScanHeadSender(SystemEvents &events);
   ~ScanHeadSender();
 
   void Send(Datagram datagram, uint32_t ip_address);
@@ -74,6 +75,7 @@ class ScanHeadSender {
   /** @brief Provides access lock to `send_message` queue. */
   std::mutex mutex_send;
 
+  SystemEvents &events;
   SOCKET sockfd;
   std::atomic<bool> is_running;
   std::atomic<bool> is_scanning;
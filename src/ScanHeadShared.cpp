@@ -10,12 +10,34 @@
 
 using namespace joescan;
 
-ScanHeadShared::ScanHeadShared(std::string serial, uint32_t id)
-  : circ_buffer(kMaxCircularBufferSize)
+static int _source_index(jsCamera camera, jsLaser laser)
+{
+  return static_cast<int>(camera) * JS_LASER_MAX + static_cast<int>(laser);
+}
+
+ScanHeadShared::ScanHeadShared(std::string serial, uint32_t id,
+                               ProfileStitcher &stitcher,
+                               SystemEvents &events)
+  : is_dropping_profiles(false),
+    num_dropped_profiles(0),
+    watermark(0),
+    float_units_per_inch(0.0),
+    is_burst(false),
+    is_burst_complete(false),
+    burst_requested(0),
+    burst_received(0),
+    burst_sent(0),
+    burst_start_ns(0),
+    stitcher(stitcher),
+    events(events)
 {
   this->is_data_available_condition_enabled = false, this->id = id;
   this->serial = serial;
   this->status_message_timestamp = 0;
+
+  for (auto &circ_buffer : circ_buffers) {
+    circ_buffer.set_capacity(kMaxCircularBufferSize);
+  }
 }
 
 ScanHeadConfiguration ScanHeadShared::GetConfiguration() const
@@ -30,7 +52,15 @@ void ScanHeadShared::SetConfig(ScanHeadConfiguration config)
 
 uint32_t ScanHeadShared::AvailableProfiles()
 {
-  return static_cast<uint32_t>(circ_buffer.size());
+  std::lock_guard<std::mutex> lock(data_lock);
+  return NumBufferedProfiles();
+}
+
+uint32_t ScanHeadShared::AvailableProfiles(jsCamera camera, jsLaser laser)
+{
+  std::lock_guard<std::mutex> lock(data_lock);
+  return static_cast<uint32_t>(circ_buffers[_source_index(camera, laser)]
+                                 .size());
 }
 
 uint32_t ScanHeadShared::WaitUntilAvailableProfiles(uint32_t count,
@@ -39,6 +69,27 @@ uint32_t ScanHeadShared::WaitUntilAvailableProfiles(uint32_t count,
   std::chrono::microseconds elapsed(0);
   auto t0 = std::chrono::high_resolution_clock::now();
 
+  while ((is_data_available_condition_enabled) &&
+         (NumBufferedProfiles() < count) && (elapsed.count() < timeout_us)) {
+    std::unique_lock<std::mutex> lock(data_lock);
+    data_available.wait(lock);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+  }
+
+  return NumBufferedProfiles();
+}
+
+uint32_t ScanHeadShared::WaitUntilAvailableProfiles(jsCamera camera,
+                                                    jsLaser laser,
+                                                    uint32_t count,
+                                                    uint32_t timeout_us)
+{
+  auto &circ_buffer = circ_buffers[_source_index(camera, laser)];
+  std::chrono::microseconds elapsed(0);
+  auto t0 = std::chrono::high_resolution_clock::now();
+
   while ((is_data_available_condition_enabled) &&
          (circ_buffer.size() < count) && (elapsed.count() < timeout_us)) {
     std::unique_lock<std::mutex> lock(data_lock);
@@ -69,11 +120,13 @@ std::shared_ptr<Profile> ScanHeadShared::PopProfile()
 {
   std::shared_ptr<Profile> profile = nullptr;
   std::lock_guard<std::mutex> lock(data_lock);
+  int n = OldestSource();
 
-  if (!circ_buffer.empty()) {
-    profile = circ_buffer.front();
-    circ_buffer.pop_front();
+  if (0 <= n) {
+    profile = circ_buffers[n].front();
+    circ_buffers[n].pop_front();
   }
+  is_dropping_profiles = false;
 
   return profile;
 }
@@ -84,6 +137,29 @@ std::vector<std::shared_ptr<Profile>> ScanHeadShared::PopProfiles(
   std::vector<std::shared_ptr<Profile>> profiles;
   std::shared_ptr<Profile> profile = nullptr;
   std::lock_guard<std::mutex> lock(data_lock);
+  int n = OldestSource();
+
+  // the queues are merged back into the order the profiles were taken
+  while ((0 <= n) && (0 < count)) {
+    profile = circ_buffers[n].front();
+    circ_buffers[n].pop_front();
+
+    profiles.push_back(profile);
+    count--;
+    n = OldestSource();
+  }
+  is_dropping_profiles = false;
+
+  return profiles;
+}
+
+std::vector<std::shared_ptr<Profile>> ScanHeadShared::PopProfiles(
+  jsCamera camera, jsLaser laser, uint32_t count)
+{
+  auto &circ_buffer = circ_buffers[_source_index(camera, laser)];
+  std::vector<std::shared_ptr<Profile>> profiles;
+  std::shared_ptr<Profile> profile = nullptr;
+  std::lock_guard<std::mutex> lock(data_lock);
 
   while (!circ_buffer.empty() && (0 < count)) {
     profile = circ_buffer.front();
@@ -92,15 +168,234 @@ std::vector<std::shared_ptr<Profile>> ScanHeadShared::PopProfiles(
     profiles.push_back(profile);
     count--;
   }
+  is_dropping_profiles = false;
 
   return profiles;
 }
 
-void ScanHeadShared::PushProfile(std::shared_ptr<Profile> profile)
+bool ScanHeadShared::PeekTimestamp(uint64_t *timestamp)
 {
   std::lock_guard<std::mutex> lock(data_lock);
-  circ_buffer.push_back(profile);
-  data_available.notify_all();
+  int n = OldestSource();
+
+  if (0 > n) {
+    return false;
+  }
+
+  *timestamp = circ_buffers[n].front()->GetTimestamp();
+  return true;
+}
+
+void ScanHeadShared::PushProfile(std::shared_ptr<Profile> profile)
+{
+  if (validity_heatmap.IsEnabled()) {
+    validity_heatmap.Add(*profile);
+  }
+
+  if (presence_detector.IsEnabled()) {
+    presence_detector.Process(id, profile, released_profiles);
+    for (auto &p : released_profiles) {
+      BufferProfile(p);
+    }
+  } else {
+    BufferProfile(profile);
+  }
+
+  // stored after presence detection so a profile within a piece carries its
+  // piece ID, even while it is held back to confirm the piece
+  if (latest_profile.IsEnabled()) {
+    latest_profile.Store(*profile);
+  }
+
+  // profiles held back to confirm a piece are buffered later, so the
+  // watermark stops short of the oldest of them
+  uint64_t timestamp = profile->GetTimestamp();
+  uint64_t pending = 0;
+  if (presence_detector.IsEnabled() &&
+      presence_detector.GetPendingTimestamp(&pending) && (0 < pending)) {
+    timestamp = pending - 1;
+  }
+
+  if (timestamp > watermark) {
+    watermark = timestamp;
+  }
+
+  // counted once buffered, so a caller woken by the completion of the burst
+  // finds its last profile available
+  if (is_burst) {
+    bool is_last = false;
+    {
+      std::lock_guard<std::mutex> lock(burst_lock);
+      if (0 == burst_received) {
+        burst_start_ns = profile->GetTimestamp();
+      }
+      burst_received++;
+      is_last = (burst_received >= burst_requested);
+    }
+
+    if (is_last) {
+      // no more profiles are coming to confirm a piece
+      ReleaseHeldProfiles();
+
+      std::lock_guard<std::mutex> lock(burst_lock);
+      is_burst_complete = true;
+      burst_complete.notify_all();
+    }
+  }
+}
+
+void ScanHeadShared::ReleaseHeldProfiles()
+{
+  if (!presence_detector.IsEnabled()) {
+    return;
+  }
+
+  uint64_t timestamp = presence_detector.Release(released_profiles);
+  for (auto &p : released_profiles) {
+    BufferProfile(p);
+  }
+
+  if (timestamp > watermark) {
+    watermark = timestamp;
+  }
+}
+
+uint64_t ScanHeadShared::GetWatermark() const
+{
+  return watermark;
+}
+
+void ScanHeadShared::ResetWatermark()
+{
+  watermark = 0;
+}
+
+void ScanHeadShared::SetFloatOutput(double units_per_inch)
+{
+  float_units_per_inch = units_per_inch;
+}
+
+double ScanHeadShared::GetFloatOutput() const
+{
+  return float_units_per_inch;
+}
+
+void ScanHeadShared::BufferProfile(std::shared_ptr<Profile> profile)
+{
+  jsCamera camera = profile->GetCamera();
+  jsLaser laser = profile->GetLaser();
+
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return;
+  }
+
+  // filtered here rather than as received, so the profiles of a source are
+  // taken in order with their pieces already assigned
+  if (temporal_filter.IsEnabled()) {
+    temporal_filter.Apply(*profile);
+  }
+
+  if (profile_resampler.IsEnabled()) {
+    profile_resampler.Apply(*profile);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(data_lock);
+    auto &circ_buffer = circ_buffers[_source_index(camera, laser)];
+    if (circ_buffer.full()) {
+      // the oldest profile is overwritten; reported once per overflow
+      num_dropped_profiles++;
+      if (!is_dropping_profiles) {
+        is_dropping_profiles = true;
+        events.Post(JS_SYSTEM_EVENT_PROFILES_DROPPED, id,
+                    static_cast<int64_t>(num_dropped_profiles));
+      }
+    }
+    circ_buffer.push_back(profile);
+    data_available.notify_all();
+  }
+
+  stitcher.AddProfile(id, profile);
+
+  if (profile_history.IsEnabled()) {
+    profile_history.Add(profile);
+  }
+}
+
+uint32_t ScanHeadShared::NumBufferedProfiles() const
+{
+  size_t n = 0;
+
+  for (auto const &circ_buffer : circ_buffers) {
+    n += circ_buffer.size();
+  }
+
+  return static_cast<uint32_t>(n);
+}
+
+int ScanHeadShared::OldestSource() const
+{
+  int oldest = -1;
+
+  for (int n = 0; n < kMaxSources; n++) {
+    if (circ_buffers[n].empty()) {
+      continue;
+    } else if ((0 > oldest) || (circ_buffers[n].front()->GetTimestamp() <
+                                circ_buffers[oldest].front()->GetTimestamp())) {
+      oldest = n;
+    }
+  }
+
+  return oldest;
+}
+
+void ScanHeadShared::StartBurst(uint32_t num_profiles)
+{
+  std::lock_guard<std::mutex> lock(burst_lock);
+  is_burst = true;
+  is_burst_complete = false;
+  burst_requested = num_profiles;
+  burst_received = 0;
+  burst_sent = 0;
+  burst_start_ns = 0;
+}
+
+void ScanHeadShared::StopBurst()
+{
+  std::lock_guard<std::mutex> lock(burst_lock);
+  is_burst = false;
+  burst_complete.notify_all();
+}
+
+bool ScanHeadShared::IsBurstComplete()
+{
+  std::lock_guard<std::mutex> lock(burst_lock);
+  return is_burst_complete;
+}
+
+bool ScanHeadShared::WaitUntilBurstComplete(
+  std::chrono::steady_clock::time_point deadline)
+{
+  std::unique_lock<std::mutex> lock(burst_lock);
+  burst_complete.wait_until(lock, deadline, [this] {
+    return is_burst_complete || !is_burst;
+  });
+
+  return is_burst_complete;
+}
+
+jsBurstStatus ScanHeadShared::GetBurstStatus()
+{
+  std::lock_guard<std::mutex> lock(burst_lock);
+  jsBurstStatus status;
+
+  status.scan_head_id = id;
+  status.num_profiles_requested = burst_requested;
+  status.num_profiles_received = burst_received;
+  status.num_profiles_sent = burst_sent;
+  status.is_complete = is_burst_complete;
+
+  return status;
 }
 
 StatusMessage ScanHeadShared::GetStatusMessage() const
@@ -120,6 +415,19 @@ void ScanHeadShared::SetStatusMessage(StatusMessage status_message)
   this->status_message = status_message;
   this->status_message_timestamp = std::time(nullptr);
   data_available.notify_all();
+
+  if (is_burst) {
+    std::lock_guard<std::mutex> lk(burst_lock);
+    // a status sent before the first profile of the burst was taken is the
+    // late status of a previous burst chained to this one
+    if ((0 != burst_received) && (0 == burst_sent) &&
+        (status_message.GetGlobalTime() > burst_start_ns)) {
+      // status after the burst's profiles means the scan head has stopped
+      burst_sent = status_message.GetNumProfilesSent();
+      is_burst_complete = true;
+      burst_complete.notify_all();
+    }
+  }
 }
 
 uint64_t ScanHeadShared::GetStatusMessageTimestamp() const
@@ -127,6 +435,60 @@ uint64_t ScanHeadShared::GetStatusMessageTimestamp() const
   return status_message_timestamp;
 }
 
+ClockModel &ScanHeadShared::GetClockModel()
+{
+  return clock_model;
+}
+
+EncoderKinematics &ScanHeadShared::GetEncoderKinematics()
+{
+  return encoder_kinematics;
+}
+
+LatestProfile &ScanHeadShared::GetLatestProfile()
+{
+  return latest_profile;
+}
+
+MappingTable &ScanHeadShared::GetMappingTable(jsCamera camera)
+{
+  if ((0 > camera) || (JS_CAMERA_MAX <= camera)) {
+    throw std::runtime_error("Invalid camera");
+  }
+
+  return mapping_tables[camera];
+}
+
+PresenceDetector &ScanHeadShared::GetPresenceDetector()
+{
+  return presence_detector;
+}
+
+ProfileHistory &ScanHeadShared::GetProfileHistory()
+{
+  return profile_history;
+}
+
+ProfileResampler &ScanHeadShared::GetProfileResampler()
+{
+  return profile_resampler;
+}
+
+ValidityHeatmap &ScanHeadShared::GetValidityHeatmap()
+{
+  return validity_heatmap;
+}
+
+SystemEvents &ScanHeadShared::GetSystemEvents()
+{
+  return events;
+}
+
+TemporalFilter &ScanHeadShared::GetTemporalFilter()
+{
+  return temporal_filter;
+}
+
 std::string ScanHeadShared::GetSerial() const
 {
   return serial;
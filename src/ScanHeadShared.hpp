@@ -8,52 +8,133 @@
 #ifndef JOESCAN_SCAN_HEAD_SHARED_H
 #define JOESCAN_SCAN_HEAD_SHARED_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
 #include "boost/circular_buffer.hpp"
 
+#include "ClockModel.hpp"
+#include "EncoderKinematics.hpp"
+#include "LatestProfile.hpp"
+#include "MappingTable.hpp"
+#include "PresenceDetector.hpp"
+#include "ProfileHistory.hpp"
+#include "ProfileResampler.hpp"
 #include "Profile.hpp"
+#include "ProfileStitcher.hpp"
 #include "ScanHeadConfiguration.hpp"
 #include "StatusMessage.hpp"
+#include "SystemEvents.hpp"
+#include "TemporalFilter.hpp"
+#include "ValidityHeatmap.hpp"
 #include "joescan_pinchot.h"
 
 namespace joescan {
 class ScanHeadShared {
  public:
-  ScanHeadShared(std::string serial, uint32_t id);
+  ScanHeadShared(std::string serial, uint32_t id, ProfileStitcher &stitcher,
+                 SystemEvents &events);
 
   ScanHeadConfiguration GetConfiguration() const;
   void SetConfig(ScanHeadConfiguration config);
 
   uint32_t AvailableProfiles();
+  uint32_t AvailableProfiles(jsCamera camera, jsLaser laser);
   uint32_t WaitUntilAvailableProfiles(uint32_t count, uint32_t timeout_us);
+  uint32_t WaitUntilAvailableProfiles(jsCamera camera, jsLaser laser,
+                                      uint32_t count, uint32_t timeout_us);
   void EnableWaitUntilAvailable(void);
   void DisableWaitUntilAvailable(void);
   std::shared_ptr<Profile> PopProfile();
   std::vector<std::shared_ptr<Profile>> PopProfiles(uint32_t count);
+  std::vector<std::shared_ptr<Profile>> PopProfiles(jsCamera camera,
+                                                    jsLaser laser,
+                                                    uint32_t count);
+  bool PeekTimestamp(uint64_t *timestamp);
   void PushProfile(std::shared_ptr<Profile> profile);
+  void ReleaseHeldProfiles();
+  uint64_t GetWatermark() const;
+  void ResetWatermark();
+  void SetFloatOutput(double units_per_inch);
+  double GetFloatOutput() const;
+
+  void StartBurst(uint32_t num_profiles);
+  void StopBurst();
+  bool IsBurstComplete();
+  bool WaitUntilBurstComplete(
+    std::chrono::steady_clock::time_point deadline);
+  jsBurstStatus GetBurstStatus();
 
   StatusMessage GetStatusMessage() const;
   void ClearStatusMessage();
   void SetStatusMessage(StatusMessage status_message);
 
   uint64_t GetStatusMessageTimestamp() const;
+  ClockModel &GetClockModel();
+  EncoderKinematics &GetEncoderKinematics();
+  LatestProfile &GetLatestProfile();
+  MappingTable &GetMappingTable(jsCamera camera);
+  PresenceDetector &GetPresenceDetector();
+  ProfileHistory &GetProfileHistory();
+  ProfileResampler &GetProfileResampler();
+  ValidityHeatmap &GetValidityHeatmap();
+  SystemEvents &GetSystemEvents();
+  TemporalFilter &GetTemporalFilter();
   std::string GetSerial() const;
   uint32_t GetId() const;
 
  private:
-  static const int kMaxCircularBufferSize = JS_SCAN_HEAD_PROFILES_MAX;
+  static const int kMaxSources = JS_CAMERA_MAX * JS_LASER_MAX;
+  static const int kMaxCircularBufferSize =
+    JS_SCAN_HEAD_PROFILES_MAX / kMaxSources;
+
+  void BufferProfile(std::shared_ptr<Profile> profile);
+  uint32_t NumBufferedProfiles() const;
+  int OldestSource() const;
 
   ScanHeadConfiguration config;
   StatusMessage status_message;
-  boost::circular_buffer<std::shared_ptr<Profile>> circ_buffer;
+  // one queue for each camera and laser pair, so each can be read alone
+  boost::circular_buffer<std::shared_ptr<Profile>> circ_buffers[kMaxSources];
   std::mutex data_lock;
   std::condition_variable data_available;
   bool is_data_available_condition_enabled;
+  // set once profiles are discarded for want of room, until the next read
+  bool is_dropping_profiles;
+  uint64_t num_dropped_profiles;
   uint64_t status_message_timestamp;
+  ClockModel clock_model;
+  EncoderKinematics encoder_kinematics;
+  LatestProfile latest_profile;
+  MappingTable mapping_tables[JS_CAMERA_MAX];
+  PresenceDetector presence_detector;
+  ProfileHistory profile_history;
+  ValidityHeatmap validity_heatmap;
+  TemporalFilter temporal_filter;
+  ProfileResampler profile_resampler;
+  // no profile older than this will be buffered from now on
+  std::atomic<uint64_t> watermark;
+  // float output units in an inch, `0` if float output is disabled
+  std::atomic<double> float_units_per_inch;
+
+  // a burst is complete once all its profiles are received or the scan head
+  // reports its status, which it only does when it has stopped scanning
+  std::mutex burst_lock;
+  std::condition_variable burst_complete;
+  std::atomic<bool> is_burst;
+  bool is_burst_complete;
+  uint32_t burst_requested;
+  uint32_t burst_received;
+  uint32_t burst_sent;
+  // timestamp of the first profile of the burst, in the scan head's time
+  uint64_t burst_start_ns;
+  std::vector<std::shared_ptr<Profile>> released_profiles;
   std::string serial;
   uint32_t id;
+  ProfileStitcher &stitcher;
+  SystemEvents &events;
 };
 } // namespace joescan
 
@@ -19,14 +19,17 @@
 #include "VersionCompatibilityException.hpp"
 #include "VersionParser.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <functional>
+#include <queue>
 #include <sstream>
 
 using namespace joescan;
 
-ScanManager::ScanManager()
+ScanManager::ScanManager() : sender(events)
 {
   session_id = 1;
 }
@@ -71,7 +74,8 @@ ScanHead *ScanManager::CreateScanner(std::string serial_number, uint32_t id)
     throw std::runtime_error(error_msg);
   }
 
-  ScanHeadShared *shared = new ScanHeadShared(serial_number, id);
+  ScanHeadShared *shared = new ScanHeadShared(serial_number, id, stitcher,
+                                              events);
   shares_by_serial[serial_number] = shared;
 
   ScanHeadReceiver *receiver = new ScanHeadReceiver(*shared);
@@ -116,6 +120,9 @@ void ScanManager::RemoveScanner(std::string serial_number)
 
   auto scanner = scanners_by_serial.find(serial_number);
   if (scanner != scanners_by_serial.end()) {
+    scanned_heads.erase(std::remove(scanned_heads.begin(),
+                                    scanned_heads.end(), scanner->second),
+                        scanned_heads.end());
     uint32_t id = scanner->second->GetId();
     scanners_by_serial.erase(serial_number);
     if (scanners_by_id.find(id) != scanners_by_id.end()) {
@@ -148,6 +155,7 @@ void ScanManager::RemoveAllScanners()
 
   scanners_by_serial.clear();
   scanners_by_id.clear();
+  scanned_heads.clear();
 }
 
 uint32_t ScanManager::GetNumberScanners()
@@ -184,6 +192,8 @@ std::map<std::string, ScanHead *> ScanManager::Connect(uint32_t timeout_s)
       throw std::runtime_error(error_msg);
     }
 
+    // the scan head may have restarted since the last connection
+    scan_head->GetScanHeadShared().GetClockModel().Reset();
     receiver->Start();
   }
 
@@ -191,6 +201,13 @@ std::map<std::string, ScanHead *> ScanManager::Connect(uint32_t timeout_s)
   // for all receivers_by_serial call SetSessionId(session_id);
   session_id++;
   connected = BroadcastConnect(timeout_s);
+  for (auto const &pair : connected) {
+    ScanHead *scan_head = pair.second;
+    StatusMessage msg = scan_head->GetStatusMessage();
+    events.Post(JS_SYSTEM_EVENT_CONNECTED, scan_head->GetId(),
+                msg.GetVersionInformation().major);
+  }
+
   if (connected.size() == scanners_by_serial.size()) {
     state = SystemState::Connected;
   }
@@ -284,6 +301,7 @@ void ScanManager::Disconnect()
 
     sender.Send(message, scan_head->GetIpAddress());
     receiver->Stop();
+    events.Post(JS_SYSTEM_EVENT_DISCONNECTED, scan_head->GetId(), 0);
   }
   sender.Stop();
 
@@ -313,6 +331,15 @@ void ScanManager::StartScanning()
     throw std::runtime_error(error_msg);
   }
 
+  std::vector<ScanHead *> scan_heads;
+  for (auto const &pair : scanners_by_serial) {
+    scan_heads.push_back(pair.second);
+  }
+  StopBurst();
+  scanned_heads = scan_heads;
+  stitcher.Flush();
+  StartStitching(scan_heads);
+
   // Just create & enqueue scan request messages in the SenderReceiver.
   std::vector<std::pair<uint32_t, Datagram>> requests;
   requests.reserve(scanners_by_serial.size());
@@ -331,6 +358,7 @@ void ScanManager::StartScanning()
                         static_cast<uint32_t>(ceil(interval)),
                         0xFFFFFFFF, // uint32_t max
                         scan_head->GetConfiguration());
+    request.SetExposureMode(scan_head->GetCameraExposureMode());
 
     auto ip_addr_and_request =
       std::make_pair(scan_head->GetIpAddress(), request.Serialize(session_id));
@@ -368,6 +396,10 @@ void ScanManager::StartScanning(ScanHead *scan_head)
   std::vector<std::pair<uint32_t, Datagram>> requests;
   requests.reserve(1);
 
+  StopBurst();
+  scanned_heads = std::vector<ScanHead *>(1, scan_head);
+  stitcher.Flush();
+  StartStitching(scanned_heads);
   scan_head->Flush();
   receiver->Start();
 
@@ -376,6 +408,7 @@ void ScanManager::StartScanning(ScanHead *scan_head)
                       scan_head->GetId(), interval,
                       0xFFFFFFFF, // uint32_t max
                       scan_head->GetConfiguration());
+  request.SetExposureMode(scan_head->GetCameraExposureMode());
 
   requests.push_back(
     std::make_pair(scan_head->GetIpAddress(), request.Serialize(session_id)));
@@ -393,10 +426,190 @@ void ScanManager::StopScanning()
   }
 
   sender.ClearScanRequests();
+  StopBurst();
 
   state = SystemState::Connected;
 }
 
+void ScanManager::StartBurst(uint32_t num_scans)
+{
+  double scan_interval_us = (1.0 / scan_rate_hz) * 1e6;
+
+  if (IsScanning() && !(is_burst && IsBurstComplete())) {
+    std::string error_msg = "Already scanning.";
+    throw std::runtime_error(error_msg);
+  }
+
+  if (!IsConnected() && !IsScanning()) {
+    std::string error_msg = "Not connected.";
+    throw std::runtime_error(error_msg);
+  }
+
+  if ((0 == num_scans) || (0xFFFFFFFF == num_scans)) {
+    std::string error_msg = "Invalid number of scans.";
+    throw std::runtime_error(error_msg);
+  }
+
+  // profiles of a completed burst that a new one is chained to are kept for
+  // the application to read
+  bool is_chained = is_burst && IsBurstComplete();
+
+  sender.ClearScanRequests();
+
+  std::vector<ScanHead *> scan_heads;
+  for (auto const &pair : scanners_by_serial) {
+    scan_heads.push_back(pair.second);
+  }
+  scanned_heads = scan_heads;
+  if (!is_chained) {
+    stitcher.Flush();
+  }
+  StartStitching(scan_heads);
+
+  for (auto const &pair : scanners_by_serial) {
+    const uint32_t interval = static_cast<uint32_t>(scan_interval_us);
+    std::string serial = pair.first;
+    ScanHead *scan_head = pair.second;
+    ScanHeadReceiver *receiver = receivers_by_serial[serial];
+
+    // cameras exposing together each take a profile every scan
+    uint64_t num_profiles = num_scans;
+    if (JS_CAMERA_EXPOSURE_MODE_SIMULTANEOUS ==
+        scan_head->GetCameraExposureMode()) {
+      num_profiles *= JS_CAMERA_MAX;
+    }
+
+    if (!is_chained) {
+      scan_head->Flush();
+    }
+    receiver->Start();
+    scan_head->GetScanHeadShared().StartBurst(static_cast<uint32_t>(
+      std::min(num_profiles, static_cast<uint64_t>(UINT32_MAX))));
+
+    // the scan head stops on its own after the last scan, so the request is
+    // sent once rather than enqueued to be resent as a keep alive
+    ScanRequest request(scan_head->GetDataFormat(), 0, receiver->GetPort(),
+                        scan_head->GetId(), interval, num_scans,
+                        scan_head->GetConfiguration());
+    request.SetExposureMode(scan_head->GetCameraExposureMode());
+
+    sender.Send(request.Serialize(session_id), scan_head->GetIpAddress());
+  }
+
+  is_burst = true;
+  state = SystemState::Scanning;
+}
+
+std::vector<jsBurstStatus> ScanManager::WaitUntilBurstComplete(
+  uint32_t timeout_us)
+{
+  std::vector<jsBurstStatus> status;
+
+  if (!is_burst) {
+    std::string error_msg = "No burst started.";
+    throw std::runtime_error(error_msg);
+  }
+
+  // all scan heads share the one deadline so the wait is bounded by the
+  // timeout regardless of the number of scan heads
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(timeout_us);
+  for (auto const &pair : scanners_by_id) {
+    pair.second->GetScanHeadShared().WaitUntilBurstComplete(deadline);
+  }
+
+  for (auto const &pair : scanners_by_id) {
+    status.push_back(pair.second->GetScanHeadShared().GetBurstStatus());
+  }
+
+  if (IsScanning() && IsBurstComplete()) {
+    state = SystemState::Connected;
+  }
+
+  return status;
+}
+
+bool ScanManager::IsBurstComplete()
+{
+  if (!is_burst) {
+    return false;
+  }
+
+  for (auto const &pair : scanners_by_id) {
+    if (!pair.second->GetScanHeadShared().IsBurstComplete()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void ScanManager::StopBurst()
+{
+  for (auto const &pair : scanners_by_id) {
+    pair.second->GetScanHeadShared().StopBurst();
+  }
+
+  is_burst = false;
+}
+
+std::vector<std::shared_ptr<Profile>> ScanManager::GetProfiles(
+  uint32_t max_profiles)
+{
+  typedef std::pair<uint64_t, ScanHeadShared *> Head;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+  std::vector<std::shared_ptr<Profile>> profiles;
+  uint64_t watermark = UINT64_MAX;
+  uint64_t newest = 0;
+  uint64_t timestamp = 0;
+
+  if (scanned_heads.empty()) {
+    return profiles;
+  }
+
+  for (auto const &scan_head : scanned_heads) {
+    ScanHeadShared &shared = scan_head->GetScanHeadShared();
+    newest = std::max(newest, shared.GetWatermark());
+  }
+
+  // a scan head that stopped sending profiles, or never started to, would
+  // otherwise hold back the profiles of all others
+  uint64_t limit = (newest > kMaxWatermarkLagNs) ?
+                   newest - kMaxWatermarkLagNs : 0;
+  for (auto const &scan_head : scanned_heads) {
+    ScanHeadShared &shared = scan_head->GetScanHeadShared();
+    uint64_t head_watermark = shared.GetWatermark();
+    if (head_watermark >= limit) {
+      watermark = std::min(watermark, head_watermark);
+    }
+  }
+
+  // k-way merge keyed on the oldest profile buffered by each scan head; each
+  // scan head buffers its profiles in the order they were taken
+  for (auto const &scan_head : scanned_heads) {
+    ScanHeadShared &shared = scan_head->GetScanHeadShared();
+    if (shared.PeekTimestamp(&timestamp) && (timestamp <= watermark)) {
+      heads.push(std::make_pair(timestamp, &shared));
+    }
+  }
+
+  while (!heads.empty() && (profiles.size() < max_profiles)) {
+    ScanHeadShared *shared = heads.top().second;
+    heads.pop();
+
+    std::shared_ptr<Profile> profile = shared->PopProfile();
+    if (nullptr != profile) {
+      profiles.push_back(profile);
+    }
+
+    if (shared->PeekTimestamp(&timestamp) && (timestamp <= watermark)) {
+      heads.push(std::make_pair(timestamp, shared));
+    }
+  }
+
+  return profiles;
+}
+
 void ScanManager::SetScanRate(double rate_hz)
 {
   double max_rate_hz = GetMaxScanRate();
@@ -452,6 +665,38 @@ double ScanManager::GetMaxScanRate()
   return max_rate;
 }
 
+bool ScanManager::HasMappingTables()
+{
+  for (auto const &pair : scanners_by_serial) {
+    ScanHeadShared &shared = pair.second->GetScanHeadShared();
+
+    for (int c = 0; c < JS_CAMERA_MAX; c++) {
+      if (!shared.GetMappingTable(static_cast<jsCamera>(c)).IsLoaded()) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool ScanManager::HasUniformExposureMode()
+{
+  if (scanners_by_serial.empty()) {
+    return true;
+  }
+
+  jsCameraExposureMode mode =
+    scanners_by_serial.begin()->second->GetCameraExposureMode();
+  for (auto const &pair : scanners_by_serial) {
+    if (mode != pair.second->GetCameraExposureMode()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void ScanManager::SetRequestedDataFormat(jsDataFormat format)
 {
   for (auto const &m : scanners_by_id) {
@@ -459,6 +704,34 @@ void ScanManager::SetRequestedDataFormat(jsDataFormat format)
   }
 }
 
+ProfileStitcher &ScanManager::GetProfileStitcher()
+{
+  return stitcher;
+}
+
+SystemEvents &ScanManager::GetSystemEvents()
+{
+  return events;
+}
+
+void ScanManager::StartStitching(const std::vector<ScanHead *> &scan_heads)
+{
+  std::vector<std::pair<uint32_t, jsCamera>> sources;
+  // the scan heads share the exposure mode when stitching, see
+  // `HasUniformExposureMode`
+  jsCameraExposureMode mode = JS_CAMERA_EXPOSURE_MODE_INTERLEAVED;
+
+  for (auto const &scan_head : scan_heads) {
+    for (int n = 0; n < JS_CAMERA_MAX; n++) {
+      sources.push_back(
+        std::make_pair(scan_head->GetId(), static_cast<jsCamera>(n)));
+    }
+    mode = scan_head->GetCameraExposureMode();
+  }
+
+  stitcher.Start(sources, scan_rate_hz, mode);
+}
+
 void ScanManager::FillVersionInformation(VersionInformation &vi)
 {
   vi.major = std::stoi(VERSION_MAJOR);
@@ -569,6 +842,8 @@ std::map<std::string, ScanHead *> ScanManager::BroadcastConnect(
           auto scanner_version = msg.GetVersionInformation();
           if (!VersionParser::AreVersionsCompatible(client_version,
                                                     scanner_version)) {
+            events.Post(JS_SYSTEM_EVENT_VERSION_MISMATCH, scan_head->GetId(),
+                        scanner_version.major);
             throw VersionCompatibilityException(client_version,
                                                 scanner_version);
           }
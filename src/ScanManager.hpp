@@ -11,8 +11,10 @@
 #include "AlignmentParams.hpp"
 #include "PinchotConstants.hpp"
 #include "Profile.hpp"
+#include "ProfileStitcher.hpp"
 #include "ScanHeadReceiver.hpp"
 #include "ScanHeadSender.hpp"
+#include "SystemEvents.hpp"
 
 #include "joescan_pinchot.h"
 
@@ -132,6 +134,45 @@ class ScanManager {
    */
   void StopScanning();
 
+  /**
+   * @brief Starts a burst of a fixed number of scans on all `ScanHead`
+   * objects that were connected using the `Connect` function. The scan
+   * request is sent once and the scan heads stop on their own. May be called
+   * while scanning if the previous burst is complete.
+   *
+   * @param num_scans The number of scans for each scan head to take.
+   */
+  void StartBurst(uint32_t num_scans);
+
+  /**
+   * @brief Blocks until all scan heads completed the current burst or the
+   * timeout expires, leaving the scanning state if they all completed.
+   *
+   * @param timeout_us The maximum time to wait in microseconds.
+   * @return The progress of each scan head, in order of scan head ID.
+   */
+  std::vector<jsBurstStatus> WaitUntilBurstComplete(uint32_t timeout_us);
+
+  /**
+   * @brief Boolean state function used to determine if all scan heads have
+   * completed the current burst.
+   *
+   * @return Boolean `true` if a burst was started and all scan heads
+   * completed it, `false` otherwise.
+   */
+  bool IsBurstComplete();
+
+  /**
+   * @brief Reads profiles from all scan heads being scanned, merged in order
+   * of timestamp. Profiles newer than the newest profile received from any
+   * one of the scan heads are left in place, so a profile is only read once
+   * all scan heads have caught up to its time.
+   *
+   * @param max_profiles The maximum number of profiles to read.
+   * @return The profiles read, oldest first.
+   */
+  std::vector<std::shared_ptr<Profile>> GetProfiles(uint32_t max_profiles);
+
   /**
    * @brief Sets the rate at which new data is sent from the scan head.
    *
@@ -153,6 +194,23 @@ class ScanManager {
    */
   double GetMaxScanRate();
 
+  /**
+   * @brief Checks that every camera of every scan head has a mapping table,
+   * as needed to scan with the subpixel data formats.
+   *
+   * @return Boolean `true` if all mapping tables are set, `false` otherwise.
+   */
+  bool HasMappingTables();
+
+  /**
+   * @brief Checks that the cameras of all scan heads use the same exposure
+   * mode, as needed to stitch their profiles into frames of one length.
+   *
+   * @return Boolean `true` if all scan heads share the exposure mode, `false`
+   * otherwise.
+   */
+  bool HasUniformExposureMode();
+
   /**
    * @brief Configures the type of data and its resolution to be returned
    * from the scan head when performing a scan.
@@ -177,24 +235,49 @@ class ScanManager {
    */
   inline bool IsScanning() const;
 
+  /**
+   * @brief Obtains the stitcher combining the profiles of all scan heads.
+   *
+   * @return Reference to the profile stitcher.
+   */
+  ProfileStitcher &GetProfileStitcher();
+
+  /**
+   * Obtains the events of the scan system.
+   *
+   * @return Reference to the events.
+   */
+  SystemEvents &GetSystemEvents();
+
  private:
   enum SystemState { Disconnected, Connected, Scanning };
 
   std::map<std::string, ScanHead*> BroadcastConnect(uint32_t timeout_s);
   void FillVersionInformation(VersionInformation& vi);
+  void StartStitching(const std::vector<ScanHead*> &scan_heads);
+  void StopBurst();
 
   std::map<std::string, ScanHeadReceiver*> receivers_by_serial;
   std::map<std::string, ScanHeadShared*> shares_by_serial;
   std::map<std::string, ScanHead*> scanners_by_serial;
   std::map<uint32_t, ScanHead*> scanners_by_id;
+  // the scan heads commanded to scan by the last start of scanning
+  std::vector<ScanHead*> scanned_heads;
+  // constructed ahead of the sender and scan heads that post to it
+  SystemEvents events;
   ScanHeadSender sender;
+  ProfileStitcher stitcher;
 
   uint8_t session_id = 1;
   const double kScanRateHzMax = kPinchotConstantMaxScanRate;
   const double kScanRateHzMin = kPinchotConstantMinScanRate;
+  // how far the profiles of a scan head may lag those of the newest before
+  // `GetProfiles` no longer waits for it
+  static const uint64_t kMaxWatermarkLagNs = 1000000000;
   double scan_rate_hz = 0.0;
 
   SystemState state = SystemState::Disconnected;
+  bool is_burst = false;
 };
 
 inline bool ScanManager::IsConnected() const
@@ -7,12 +7,37 @@
 
 #include "ScanRequestMessage.hpp"
 #include "DataFormats.hpp"
-#include "TcpSerializationHelpers.hpp"
+#include "MessageSchema.hpp"
 #include "NetworkIncludes.hpp"
 #include <algorithm>
 
 using namespace joescan;
 
+#define FIELD(m) SCHEMA_FIELD(ScanRequest, m)
+#define WIRE_FIELD(m, w) SCHEMA_WIRE_FIELD(ScanRequest, m, w)
+
+struct ScanRequest::Layout {
+  // everything following the header up to the step of each data type
+  typedef MessageSchema<
+    FIELD(clientAddress), FIELD(clientPort), FIELD(requestSequence),
+    FIELD(scanHeadId), FIELD(cameraId), FIELD(laserId),
+    WIRE_FIELD(exposureMode, uint8_t), FIELD(flags),
+    FIELD(minimumLaserExposure), FIELD(defaultLaserExposure),
+    FIELD(maximumLaserExposure), FIELD(minimumCameraExposure),
+    FIELD(defaultCameraExposure), FIELD(maximumCameraExposure),
+    FIELD(laserDetectionThreshold), FIELD(saturationThreshold),
+    FIELD(saturationPercent), FIELD(averageImageIntensity),
+    FIELD(scanInterval), FIELD(scanOffset), FIELD(numberOfScans),
+    FIELD(dataTypes), FIELD(startCol), FIELD(endCol)>
+    Body;
+
+  static constexpr uint32_t kFixedSize = InfoHeaderSchema::kSize + Body::kSize;
+  static_assert(74 == kFixedSize, "Scan request layout changed");
+};
+
+#undef FIELD
+#undef WIRE_FIELD
+
 ScanRequest::ScanRequest(jsDataFormat format, uint32_t clientAddress,
                          int clientPort, int scanHeadId, uint32_t interval,
                          uint32_t scanCount,
@@ -48,94 +73,33 @@ ScanRequest::ScanRequest(jsDataFormat format, uint32_t clientAddress,
 
 ScanRequest::ScanRequest(const Datagram &datagram)
 {
-  if (datagram.size() < 76) {
-    // throw std::exception();
-  }
-  int index = 0;
-
-  magic = ntohs(*reinterpret_cast<const uint16_t *>(&datagram[index]));
-  if (magic != kCommandMagic) {
+  if (datagram.size() < Layout::kFixedSize) {
     throw std::exception();
   }
-  index += sizeof(uint16_t);
-
-  uint8_t size = datagram[index++];
-
-  requestType = UdpPacketType::_from_integral(datagram[index++]);
-
-  clientAddress =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  clientPort = ntohs(*(reinterpret_cast<const uint16_t *>(&datagram[index])));
-  index += sizeof(uint16_t);
-  requestSequence = datagram[index++];
-
-  scanHeadId = datagram[index++];
-  cameraId = datagram[index++];
-  laserId = datagram[index++];
-  exposureMode = CameraExposureMode::_from_integral(datagram[index++]);
-  flags = datagram[index++];
 
-  minimumLaserExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  defaultLaserExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  maximumLaserExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
+  const uint8_t *begin = datagram.data();
+  const uint8_t *end = begin + datagram.size();
+  InfoHeader hdr;
 
-  minimumCameraExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  defaultCameraExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  maximumCameraExposure =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-
-  laserDetectionThreshold =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  saturationThreshold =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  saturationPercent =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  averageImageIntensity =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-
-  scanInterval = ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  scanOffset = ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
-  numberOfScans =
-    ntohl(*(reinterpret_cast<const uint32_t *>(&datagram[index])));
-  index += sizeof(uint32_t);
+  const uint8_t *p = InfoHeaderSchema::Read(hdr, begin);
+  if (hdr.magic != kCommandMagic) {
+    throw std::exception();
+  }
+  magic = hdr.magic;
+  requestType = UdpPacketType::_from_integral(hdr.type);
 
-  dataTypes = ntohs(*(reinterpret_cast<const uint16_t *>(&datagram[index])));
-  index += sizeof(uint16_t);
-  startCol = ntohs(*(reinterpret_cast<const uint16_t *>(&datagram[index])));
-  index += sizeof(uint16_t);
-  endCol = ntohs(*(reinterpret_cast<const uint16_t *>(&datagram[index])));
-  index += sizeof(uint16_t);
+  p = Layout::Body::Read(*this, p);
 
+  steps.clear();
   for (int i = 1; i <= dataTypes; i <<= 1) {
     if (i & dataTypes) {
-      uint16_t stepVal =
-        ntohs(*(reinterpret_cast<const uint16_t *>(&datagram[index])));
-      steps.push_back(stepVal);
-      index += sizeof(uint16_t);
+      if (p + sizeof(uint16_t) > end) {
+        throw std::exception();
+      }
+      steps.push_back(LoadNetwork<uint16_t>(p));
+      p += sizeof(uint16_t);
     }
   }
-
-  if (size != Length()) {
-    // throw std::exception();
-  }
 }
 
 ScanRequest ScanRequest::Deserialize(const Datagram &datagram)
@@ -145,59 +109,23 @@ ScanRequest ScanRequest::Deserialize(const Datagram &datagram)
 
 Datagram ScanRequest::Serialize(uint8_t requestSequence)
 {
-  std::vector<uint8_t> scanRequestPacket;
-  scanRequestPacket.reserve(Length());
-
-  size_t index = 0;
-  index += SerializeIntegralToBytes(scanRequestPacket, &kCommandMagic);
-
-  scanRequestPacket.push_back(Length());
-  scanRequestPacket.push_back(requestType);
-  index += 2;
-
-  index += SerializeIntegralToBytes(scanRequestPacket, &clientAddress);
-  index += SerializeIntegralToBytes(scanRequestPacket, &clientPort);
-
-  scanRequestPacket.push_back(requestSequence);
-  scanRequestPacket.push_back(scanHeadId);
-  // TODO: This isn't needed now, but may be useful on multi-camera systems in
-  // the future
-  scanRequestPacket.push_back(cameraId);
-  // TODO: This also isn't needed now.
-  scanRequestPacket.push_back(laserId);
-  scanRequestPacket.push_back(exposureMode);
-  scanRequestPacket.push_back(flags);
-  index += 6;
-
-  index += SerializeIntegralToBytes(scanRequestPacket, &minimumLaserExposure);
-  index += SerializeIntegralToBytes(scanRequestPacket, &defaultLaserExposure);
-  index += SerializeIntegralToBytes(scanRequestPacket, &maximumLaserExposure);
-
-  index += SerializeIntegralToBytes(scanRequestPacket, &minimumCameraExposure);
-  index += SerializeIntegralToBytes(scanRequestPacket, &defaultCameraExposure);
-  index += SerializeIntegralToBytes(scanRequestPacket, &maximumCameraExposure);
+  Datagram scanRequestPacket(Length());
+  InfoHeader hdr;
 
-  index +=
-    SerializeIntegralToBytes(scanRequestPacket, &laserDetectionThreshold);
-  index += SerializeIntegralToBytes(scanRequestPacket, &saturationThreshold);
-  index += SerializeIntegralToBytes(scanRequestPacket, &saturationPercent);
-  index += SerializeIntegralToBytes(scanRequestPacket, &averageImageIntensity);
+  this->requestSequence = requestSequence;
+  hdr.magic = kCommandMagic;
+  hdr.size = static_cast<uint8_t>(Length());
+  hdr.type = requestType._to_integral();
 
-  index += SerializeIntegralToBytes(scanRequestPacket, &scanInterval);
-  index += SerializeIntegralToBytes(scanRequestPacket, &scanOffset);
-  index += SerializeIntegralToBytes(scanRequestPacket, &numberOfScans);
-
-  index += SerializeIntegralToBytes(scanRequestPacket, &dataTypes);
-  index += SerializeIntegralToBytes(scanRequestPacket, &startCol);
-  index += SerializeIntegralToBytes(scanRequestPacket, &endCol);
+  uint8_t *p = InfoHeaderSchema::Write(hdr, scanRequestPacket.data());
+  p = Layout::Body::Write(*this, p);
 
   // for each type, uint16 for step
   for (const auto &step : steps) {
-    index += SerializeIntegralToBytes(scanRequestPacket, &step);
+    StoreNetwork(p, step);
+    p += sizeof(uint16_t);
   }
 
-  // static_assert(index == Length());
-
   return scanRequestPacket;
 }
 
@@ -235,6 +163,15 @@ void ScanRequest::SetCameraExposure(uint32_t min, uint32_t def, uint32_t max)
   }
 }
 
+void ScanRequest::SetExposureMode(jsCameraExposureMode mode)
+{
+  if (JS_CAMERA_EXPOSURE_MODE_SIMULTANEOUS == mode) {
+    exposureMode = CameraExposureMode::Simultaneous;
+  } else {
+    exposureMode = CameraExposureMode::Interleaved;
+  }
+}
+
 bool ScanRequest::operator==(const ScanRequest &other) const
 {
   bool same = true;
@@ -68,12 +68,16 @@ class ScanRequest {
   void SetDataTypesAndSteps(DataType types, std::vector<uint16_t> steps);
   void SetLaserExposure(uint32_t min, uint32_t def, uint32_t max);
   void SetCameraExposure(uint32_t min, uint32_t def, uint32_t max);
+  void SetExposureMode(jsCameraExposureMode mode);
 
   bool operator==(const ScanRequest &other) const;
   bool operator!=(const ScanRequest &other) const;
 
  private:
-  uint16_t magic;
+  // the field layout of the message, defined with the serialization
+  struct Layout;
+
+  uint16_t magic = kCommandMagic;
   UdpPacketType requestType = UdpPacketType::StartScanning;
 
   uint8_t scanHeadId;
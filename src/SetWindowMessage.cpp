@@ -6,13 +6,36 @@
  */
 
 #include "SetWindowMessage.hpp"
-#include "TcpSerializationHelpers.hpp"
+#include "MessageSchema.hpp"
 #include "enum.h"
 
 #include <fstream>
 
 using namespace joescan;
 
+struct SetWindowMessage::Layout {
+  // the camera follows the header, padded to a multiple of four bytes
+  typedef MessageSchema<SCHEMA_FIELD(SetWindowMessage, camera),
+                        SchemaPadding<3>>
+    Body;
+
+  // each constraint is a line through two points, in 1/1000 inch
+  struct Constraint {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+  };
+
+  typedef MessageSchema<SCHEMA_FIELD(Constraint, x1),
+                        SCHEMA_FIELD(Constraint, y1),
+                        SCHEMA_FIELD(Constraint, x2),
+                        SCHEMA_FIELD(Constraint, y2)>
+    ConstraintSchema;
+
+  static constexpr uint32_t kFixedSize = InfoHeaderSchema::kSize + Body::kSize;
+};
+
 SetWindowMessage::SetWindowMessage(int camera)
 {
   this->camera = camera;
@@ -20,32 +43,30 @@ SetWindowMessage::SetWindowMessage(int camera)
 
 SetWindowMessage SetWindowMessage::Deserialize(std::vector<uint8_t> &message)
 {
-  int index = 0;
-  uint16_t magic = htons(*(reinterpret_cast<uint16_t *>(&(message[index]))));
-  index += sizeof(uint16_t);
-  if (magic != kCommandMagic) {
+  if (message.size() < Layout::kFixedSize) {
     throw std::exception();
   }
 
-  index++; // skip size
-  if (message[index++] != +UdpPacketType::SetWindow) {
+  const uint8_t *p = message.data();
+  const uint8_t *end = p + message.size();
+  InfoHeader hdr;
+
+  p = InfoHeaderSchema::Read(hdr, p);
+  if (hdr.magic != kCommandMagic) {
     throw std::exception();
   }
 
-  SetWindowMessage msg(-1);
-  msg.SetCamera(message[index++]);
-  index += 3; // skip unused bytes
+  if (hdr.type != +UdpPacketType::SetWindow) {
+    throw std::exception();
+  }
 
-  while ((index + (4 * sizeof(int32_t))) <= message.size()) {
-    int32_t *ptr = reinterpret_cast<int32_t *>(&message[index]);
-    // note, units are in 1/1000 inch
-    int32_t x1 = htonl(ptr[0]);
-    int32_t y1 = htonl(ptr[1]);
-    int32_t x2 = htonl(ptr[2]);
-    int32_t y2 = htonl(ptr[3]);
+  SetWindowMessage msg(-1);
+  p = Layout::Body::Read(msg, p);
 
-    msg.AddConstraint(x1, y1, x2, y2);
-    index += 4 * sizeof(int32_t);
+  while (p + Layout::ConstraintSchema::kSize <= end) {
+    Layout::Constraint c;
+    p = Layout::ConstraintSchema::Read(c, p);
+    msg.AddConstraint(c.x1, c.y1, c.x2, c.y2);
   }
 
   return msg;
@@ -53,40 +74,31 @@ SetWindowMessage SetWindowMessage::Deserialize(std::vector<uint8_t> &message)
 
 std::vector<uint8_t> SetWindowMessage::Serialize() const
 {
-  std::vector<uint8_t> message;
-  int constraint_size = 3 * sizeof(int32_t);
-  int message_size = 0;
-  {
-    // TODO: This needs to be better explained/documented. It's not really
-    // obvious as to how the `sizeof` calls relate to the message fields.
-    size_t sz = (constraints.size() * constraint_size) + (4 * sizeof(uint8_t)) +
-                sizeof(uint32_t);
-    message_size = static_cast<int>(sz);
-  }
-  message.reserve(message_size);
-
-  size_t index = 0;
-  index += SerializeIntegralToBytes(message, &kCommandMagic);
-  message.push_back(message_size);
-  UdpPacketType type = UdpPacketType::SetWindow;
-  message.push_back(type._to_integral());
-  message.push_back(camera);
-  message.push_back(0);
-  message.push_back(0);
-  message.push_back(0);
-  index += 6;
+  uint32_t num_constraints = static_cast<uint32_t>(constraints.size());
+  uint32_t message_size =
+    Layout::kFixedSize + num_constraints * Layout::ConstraintSchema::kSize;
+  std::vector<uint8_t> message(message_size);
+  InfoHeader hdr;
+
+  hdr.magic = kCommandMagic;
+  // the size field has always been sent counting three values per
+  // constraint rather than four; it is kept unchanged for the scan server
+  hdr.size = static_cast<uint8_t>(num_constraints * 3 * sizeof(int32_t) +
+                                  4 * sizeof(uint8_t) + sizeof(uint32_t));
+  hdr.type = UdpPacketType::SetWindow;
+
+  uint8_t *p = message.data();
+  p = InfoHeaderSchema::Write(hdr, p);
+  p = Layout::Body::Write(*this, p);
 
   for (auto &window_constraint : constraints) {
-    int32_t x, y;
+    Layout::Constraint c;
     // note, units are in 1/1000 inch
-    x = static_cast<int32_t>(window_constraint.constraints[0].x);
-    index += SerializeIntegralToBytes(message, &(x));
-    y = static_cast<int32_t>(window_constraint.constraints[0].y);
-    index += SerializeIntegralToBytes(message, &(y));
-    x = static_cast<int32_t>(window_constraint.constraints[1].x);
-    index += SerializeIntegralToBytes(message, &(x));
-    y = static_cast<int32_t>(window_constraint.constraints[1].y);
-    index += SerializeIntegralToBytes(message, &(y));
+    c.x1 = static_cast<int32_t>(window_constraint.constraints[0].x);
+    c.y1 = static_cast<int32_t>(window_constraint.constraints[0].y);
+    c.x2 = static_cast<int32_t>(window_constraint.constraints[1].x);
+    c.y2 = static_cast<int32_t>(window_constraint.constraints[1].y);
+    p = Layout::ConstraintSchema::Write(c, p);
   }
 
   return message;
@@ -33,6 +33,9 @@ class SetWindowMessage {
   std::vector<WindowConstraint> Constraints() const;
 
  private:
+  // the field layout of the message, defined with the serialization
+  struct Layout;
+
   std::vector<WindowConstraint> constraints;
   uint8_t camera = 0;
 };
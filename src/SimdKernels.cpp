@@ -0,0 +1,1070 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "SimdKernels.hpp"
+#include "SimdTarget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace joescan;
+
+/*
+ * Helpers shared by all of the kernels.
+ */
+
+static inline int16_t LoadBigEndian16(const uint8_t *p)
+{
+  return static_cast<int16_t>((p[0] << 8) | p[1]);
+}
+
+// This must perform the exact same sequence of operations as
+// `AlignmentParams::CameraToMill` so every variant produces identical output.
+static inline void CameraToMill(const CameraToMillCoefficients &c, double xd,
+                                double yd, jsProfileData *dst, float *dst_x,
+                                float *dst_y)
+{
+  double xm = (xd * c.cos_yaw * c.cos_roll) - (yd * c.sin_roll) + c.shift_x_1000;
+  double ym = (xd * c.cos_yaw * c.sin_roll) + (yd * c.cos_roll) + c.shift_y_1000;
+
+  dst->x = static_cast<int32_t>(xm);
+  dst->y = static_cast<int32_t>(ym);
+
+  if (nullptr != dst_x) {
+    *dst_x = static_cast<float>(xm * c.float_scale);
+    *dst_y = static_cast<float>(ym * c.float_scale);
+  }
+}
+
+/*
+ * Scalar kernels; these are used as is on CPUs without vector extensions and
+ * also to process the remainder of an array in the vectorized kernels.
+ */
+
+static uint32_t DecodeXYRange(const uint8_t *src, uint32_t start,
+                              uint32_t num_vals,
+                              const CameraToMillCoefficients &c,
+                              jsProfileData *dst, float *dst_x, float *dst_y,
+                              uint32_t dst_idx, uint32_t dst_stride,
+                              uint32_t dst_len, ProfileSummary &summary)
+{
+  uint32_t count = 0;
+
+  for (uint32_t j = start; j < num_vals; j++) {
+    int16_t x_raw = LoadBigEndian16(&src[j * 4]);
+    int16_t y_raw = LoadBigEndian16(&src[j * 4 + 2]);
+
+    if ((JS_PROFILE_DATA_INVALID_XY != x_raw) &&
+        (JS_PROFILE_DATA_INVALID_XY != y_raw)) {
+      uint32_t m = dst_idx + j * dst_stride;
+      if (m < dst_len) {
+        if (nullptr != dst_x) {
+          CameraToMill(c, x_raw, y_raw, &dst[m], &dst_x[m], &dst_y[m]);
+        } else {
+          CameraToMill(c, x_raw, y_raw, &dst[m], nullptr, nullptr);
+        }
+        summary.Add(dst[m].x, dst[m].y, m);
+        count++;
+      }
+    }
+  }
+
+  return count;
+}
+
+// The vectorized kernel must perform the exact same sequence of operations
+// on the subpixel row and the table entries.
+static uint32_t DecodeSubpixelRange(const uint8_t *src, uint32_t start,
+                                    uint32_t num_vals,
+                                    const MappingTableLookup &t,
+                                    const CameraToMillCoefficients &c,
+                                    jsProfileData *dst, float *dst_x,
+                                    float *dst_y, uint32_t dst_idx,
+                                    uint32_t dst_stride, uint32_t dst_len,
+                                    ProfileSummary &summary)
+{
+  uint32_t count = 0;
+
+  for (uint32_t j = start; j < num_vals; j++) {
+    uint16_t subpixel = static_cast<uint16_t>(LoadBigEndian16(&src[j * 2]));
+    uint32_t m = dst_idx + j * dst_stride;
+    if ((kInvalidSubpixel == subpixel) || (m >= dst_len) ||
+        (m >= t.num_columns)) {
+      continue;
+    }
+
+    float pos = static_cast<float>(subpixel) * t.row_scale;
+    uint32_t row = static_cast<uint32_t>(pos);
+    if ((row + 1) >= t.num_rows) {
+      continue;
+    }
+
+    float f = pos - static_cast<float>(row);
+    uint32_t k = row * t.num_columns + m;
+    uint32_t k1 = k + t.num_columns;
+    float x = t.x[k] + f * (t.x[k1] - t.x[k]);
+    float y = t.y[k] + f * (t.y[k1] - t.y[k]);
+    if ((x != x) || (y != y)) {
+      // outside of the calibrated area
+      continue;
+    }
+
+    if (nullptr != dst_x) {
+      CameraToMill(c, x, y, &dst[m], &dst_x[m], &dst_y[m]);
+    } else {
+      CameraToMill(c, x, y, &dst[m], nullptr, nullptr);
+    }
+    summary.Add(dst[m].x, dst[m].y, m);
+    count++;
+  }
+
+  return count;
+}
+
+static uint32_t DecodeBrightnessRange(const uint8_t *src, uint32_t start,
+                                      uint32_t num_vals, jsProfileData *dst,
+                                      uint32_t dst_idx, uint32_t dst_stride,
+                                      uint32_t dst_len)
+{
+  uint32_t count = 0;
+
+  for (uint32_t j = start; j < num_vals; j++) {
+    uint8_t brightness = src[j];
+    if (JS_PROFILE_DATA_INVALID_BRIGHTNESS != brightness) {
+      uint32_t m = dst_idx + j * dst_stride;
+      if (m < dst_len) {
+        dst[m].brightness = static_cast<int32_t>(brightness);
+        count++;
+      }
+    }
+  }
+
+  return count;
+}
+
+static uint32_t CopyValidRange(const jsProfileData *src, uint32_t start,
+                               uint32_t src_len, uint32_t stride,
+                               jsProfileData *dst)
+{
+  uint32_t count = 0;
+
+  for (uint32_t n = start; n < src_len; n += stride) {
+    // Note: Only need to check X/Y since we only support data types with
+    // X/Y coordinates alone or X/Y coordinates with brightness.
+    if ((JS_PROFILE_DATA_INVALID_XY != src[n].x) ||
+        (JS_PROFILE_DATA_INVALID_XY != src[n].y)) {
+      dst[count++] = src[n];
+    }
+  }
+
+  return count;
+}
+
+static void TemporalEMARange(jsProfileData *data, uint32_t start,
+                             uint32_t len, float *state, float alpha,
+                             int32_t reset_distance)
+{
+  const float invalid = static_cast<float>(JS_PROFILE_DATA_INVALID_XY);
+  const float limit = static_cast<float>(reset_distance);
+
+  for (uint32_t n = start; n < len; n++) {
+    int32_t y = data[n].y;
+    if (JS_PROFILE_DATA_INVALID_XY == y) {
+      state[n] = invalid;
+      continue;
+    }
+
+    float yf = static_cast<float>(y);
+    float s = state[n];
+    float d = yf - s;
+    if ((invalid == s) || ((0 < reset_distance) && (std::fabs(d) > limit))) {
+      s = yf;
+    } else {
+      s = s + alpha * d;
+    }
+
+    state[n] = s;
+    data[n].y = static_cast<int32_t>(std::lrint(s));
+  }
+}
+
+static void TemporalMedianRange(jsProfileData *data, uint32_t start,
+                                uint32_t len, int32_t *history,
+                                int32_t *filtered, uint32_t window,
+                                uint32_t newest, int32_t reset_distance)
+{
+  int32_t values[JS_TEMPORAL_FILTER_WINDOW_MAX];
+
+  for (uint32_t n = start; n < len; n++) {
+    int32_t y = data[n].y;
+    if (JS_PROFILE_DATA_INVALID_XY == y) {
+      filtered[n] = JS_PROFILE_DATA_INVALID_XY;
+      continue;
+    }
+
+    int32_t f = filtered[n];
+    int64_t d = static_cast<int64_t>(y) - f;
+    if ((JS_PROFILE_DATA_INVALID_XY == f) ||
+        ((0 < reset_distance) && (std::abs(d) > reset_distance))) {
+      for (uint32_t k = 0; k < window; k++) {
+        history[k * len + n] = y;
+      }
+      f = y;
+    } else {
+      history[newest * len + n] = y;
+      for (uint32_t k = 0; k < window; k++) {
+        values[k] = history[k * len + n];
+      }
+      std::nth_element(values, values + window / 2, values + window);
+      f = values[window / 2];
+    }
+
+    filtered[n] = f;
+    data[n].y = f;
+  }
+}
+
+static uint32_t DecodeXYScalar(const uint8_t *src, uint32_t num_vals,
+                               const CameraToMillCoefficients &c,
+                               jsProfileData *dst, float *dst_x, float *dst_y,
+                               uint32_t dst_idx, uint32_t dst_stride,
+                               uint32_t dst_len, ProfileSummary *summary)
+{
+  // accumulate locally, stores to `dst` could otherwise alias the summary
+  ProfileSummary s = *summary;
+  uint32_t count =
+    DecodeXYRange(src, 0, num_vals, c, dst, dst_x, dst_y, dst_idx, dst_stride,
+                  dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+static uint32_t DecodeSubpixelScalar(const uint8_t *src, uint32_t num_vals,
+                                     const MappingTableLookup &t,
+                                     const CameraToMillCoefficients &c,
+                                     jsProfileData *dst, float *dst_x,
+                                     float *dst_y, uint32_t dst_idx,
+                                     uint32_t dst_stride, uint32_t dst_len,
+                                     ProfileSummary *summary)
+{
+  ProfileSummary s = *summary;
+  uint32_t count =
+    DecodeSubpixelRange(src, 0, num_vals, t, c, dst, dst_x, dst_y, dst_idx,
+                        dst_stride, dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+static uint32_t DecodeBrightnessScalar(const uint8_t *src, uint32_t num_vals,
+                                       jsProfileData *dst, uint32_t dst_idx,
+                                       uint32_t dst_stride, uint32_t dst_len)
+{
+  return DecodeBrightnessRange(src, 0, num_vals, dst, dst_idx, dst_stride,
+                               dst_len);
+}
+
+static uint32_t CopyValidScalar(const jsProfileData *src, uint32_t src_len,
+                                uint32_t stride, jsProfileData *dst)
+{
+  return CopyValidRange(src, 0, src_len, stride, dst);
+}
+
+static void TemporalEMAScalar(jsProfileData *data, uint32_t len,
+                              float *state, float alpha,
+                              int32_t reset_distance)
+{
+  TemporalEMARange(data, 0, len, state, alpha, reset_distance);
+}
+
+static void TemporalMedianScalar(jsProfileData *data, uint32_t len,
+                                 int32_t *history, int32_t *filtered,
+                                 uint32_t window, uint32_t newest,
+                                 int32_t reset_distance)
+{
+  TemporalMedianRange(data, 0, len, history, filtered, window, newest,
+                      reset_distance);
+}
+
+#ifdef JS_SIMD_X86
+/*
+ * SSE4.2 kernels, 4 X/Y points or 16 brightness values per iteration.
+ */
+
+JS_SIMD_TARGET("sse4.2")
+static uint32_t DecodeXYSSE42(const uint8_t *src, uint32_t num_vals,
+                              const CameraToMillCoefficients &c,
+                              jsProfileData *dst, float *dst_x, float *dst_y,
+                              uint32_t dst_idx, uint32_t dst_stride,
+                              uint32_t dst_len, ProfileSummary *summary)
+{
+  const __m128i swap =
+    _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  const __m128i invalid = _mm_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m128d cos_yaw = _mm_set1_pd(c.cos_yaw);
+  const __m128d cos_roll = _mm_set1_pd(c.cos_roll);
+  const __m128d sin_roll = _mm_set1_pd(c.sin_roll);
+  const __m128d shift_x = _mm_set1_pd(c.shift_x_1000);
+  const __m128d shift_y = _mm_set1_pd(c.shift_y_1000);
+  const __m128d scale = _mm_set1_pd(c.float_scale);
+  int32_t xs[4];
+  int32_t ys[4];
+  float xfs[4];
+  float yfs[4];
+  ProfileSummary s = *summary;
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 4) <= num_vals; j += 4) {
+    __m128i raw =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[j * 4]));
+    // swap to little endian; each 32 bit lane then holds X in the low half
+    // and Y in the high half, sign extend both to 32 bits
+    raw = _mm_shuffle_epi8(raw, swap);
+    __m128i x = _mm_srai_epi32(_mm_slli_epi32(raw, 16), 16);
+    __m128i y = _mm_srai_epi32(raw, 16);
+
+    __m128i bad =
+      _mm_or_si128(_mm_cmpeq_epi32(x, invalid), _mm_cmpeq_epi32(y, invalid));
+    uint32_t valid = ~_mm_movemask_ps(_mm_castsi128_ps(bad)) & 0xF;
+    if (0 == valid) {
+      continue;
+    }
+
+    for (int h = 0; h < 2; h++) {
+      __m128d xd = _mm_cvtepi32_pd(x);
+      __m128d yd = _mm_cvtepi32_pd(y);
+      __m128d xc = _mm_mul_pd(xd, cos_yaw);
+      __m128d xm = _mm_add_pd(
+        _mm_sub_pd(_mm_mul_pd(xc, cos_roll), _mm_mul_pd(yd, sin_roll)),
+        shift_x);
+      __m128d ym = _mm_add_pd(
+        _mm_add_pd(_mm_mul_pd(xc, sin_roll), _mm_mul_pd(yd, cos_roll)),
+        shift_y);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(&xs[h * 2]),
+                       _mm_cvttpd_epi32(xm));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(&ys[h * 2]),
+                       _mm_cvttpd_epi32(ym));
+      if (nullptr != dst_x) {
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&xfs[h * 2]),
+                      _mm_cvtpd_ps(_mm_mul_pd(xm, scale)));
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&yfs[h * 2]),
+                      _mm_cvtpd_ps(_mm_mul_pd(ym, scale)));
+      }
+      x = _mm_srli_si128(x, 8);
+      y = _mm_srli_si128(y, 8);
+    }
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].x = xs[k];
+        dst[m].y = ys[k];
+        if (nullptr != dst_x) {
+          dst_x[m] = xfs[k];
+          dst_y[m] = yfs[k];
+        }
+        s.Add(xs[k], ys[k], m);
+        count++;
+      }
+    }
+  }
+
+  count += DecodeXYRange(src, j, num_vals, c, dst, dst_x, dst_y, dst_idx,
+                         dst_stride, dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+JS_SIMD_TARGET("sse4.2")
+static uint32_t DecodeBrightnessSSE42(const uint8_t *src, uint32_t num_vals,
+                                      jsProfileData *dst, uint32_t dst_idx,
+                                      uint32_t dst_stride, uint32_t dst_len)
+{
+  const __m128i zero = _mm_setzero_si128();
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 16) <= num_vals; j += 16) {
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[j]));
+    uint32_t valid = ~_mm_movemask_epi8(_mm_cmpeq_epi8(b, zero)) & 0xFFFF;
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].brightness = static_cast<int32_t>(src[j + k]);
+        count++;
+      }
+    }
+  }
+
+  count +=
+    DecodeBrightnessRange(src, j, num_vals, dst, dst_idx, dst_stride, dst_len);
+
+  return count;
+}
+
+/*
+ * AVX2 kernels, 8 X/Y points or 32 brightness values per iteration.
+ */
+
+JS_SIMD_TARGET("avx2")
+static uint32_t DecodeXYAVX2(const uint8_t *src, uint32_t num_vals,
+                             const CameraToMillCoefficients &c,
+                             jsProfileData *dst, float *dst_x, float *dst_y,
+                             uint32_t dst_idx, uint32_t dst_stride,
+                             uint32_t dst_len, ProfileSummary *summary)
+{
+  const __m256i swap =
+    _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1,
+                     0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  const __m256i invalid = _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m256d cos_yaw = _mm256_set1_pd(c.cos_yaw);
+  const __m256d cos_roll = _mm256_set1_pd(c.cos_roll);
+  const __m256d sin_roll = _mm256_set1_pd(c.sin_roll);
+  const __m256d shift_x = _mm256_set1_pd(c.shift_x_1000);
+  const __m256d shift_y = _mm256_set1_pd(c.shift_y_1000);
+  const __m256d scale = _mm256_set1_pd(c.float_scale);
+  int32_t xs[8];
+  int32_t ys[8];
+  float xfs[8];
+  float yfs[8];
+  ProfileSummary s = *summary;
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 8) <= num_vals; j += 8) {
+    __m256i raw =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[j * 4]));
+    raw = _mm256_shuffle_epi8(raw, swap);
+    __m256i x = _mm256_srai_epi32(_mm256_slli_epi32(raw, 16), 16);
+    __m256i y = _mm256_srai_epi32(raw, 16);
+
+    __m256i bad = _mm256_or_si256(_mm256_cmpeq_epi32(x, invalid),
+                                  _mm256_cmpeq_epi32(y, invalid));
+    uint32_t valid = ~_mm256_movemask_ps(_mm256_castsi256_ps(bad)) & 0xFF;
+    if (0 == valid) {
+      continue;
+    }
+
+    for (int h = 0; h < 2; h++) {
+      __m128i xh = (0 == h) ? _mm256_castsi256_si128(x)
+                            : _mm256_extracti128_si256(x, 1);
+      __m128i yh = (0 == h) ? _mm256_castsi256_si128(y)
+                            : _mm256_extracti128_si256(y, 1);
+      __m256d xd = _mm256_cvtepi32_pd(xh);
+      __m256d yd = _mm256_cvtepi32_pd(yh);
+      __m256d xc = _mm256_mul_pd(xd, cos_yaw);
+      __m256d xm = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(xc, cos_roll),
+                                               _mm256_mul_pd(yd, sin_roll)),
+                                 shift_x);
+      __m256d ym = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(xc, sin_roll),
+                                               _mm256_mul_pd(yd, cos_roll)),
+                                 shift_y);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&xs[h * 4]),
+                       _mm256_cvttpd_epi32(xm));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&ys[h * 4]),
+                       _mm256_cvttpd_epi32(ym));
+      if (nullptr != dst_x) {
+        _mm_storeu_ps(&xfs[h * 4], _mm256_cvtpd_ps(_mm256_mul_pd(xm, scale)));
+        _mm_storeu_ps(&yfs[h * 4], _mm256_cvtpd_ps(_mm256_mul_pd(ym, scale)));
+      }
+    }
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].x = xs[k];
+        dst[m].y = ys[k];
+        if (nullptr != dst_x) {
+          dst_x[m] = xfs[k];
+          dst_y[m] = yfs[k];
+        }
+        s.Add(xs[k], ys[k], m);
+        count++;
+      }
+    }
+  }
+
+  count += DecodeXYRange(src, j, num_vals, c, dst, dst_x, dst_y, dst_idx,
+                         dst_stride, dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+// The table lookups are gathered, 8 rows per iteration; lanes that are
+// invalid before the lookup are masked off so their indices are never read.
+JS_SIMD_TARGET("avx2")
+static uint32_t DecodeSubpixelAVX2(const uint8_t *src, uint32_t num_vals,
+                                   const MappingTableLookup &t,
+                                   const CameraToMillCoefficients &c,
+                                   jsProfileData *dst, float *dst_x,
+                                   float *dst_y, uint32_t dst_idx,
+                                   uint32_t dst_stride, uint32_t dst_len,
+                                   ProfileSummary *summary)
+{
+  const __m128i swap =
+    _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  const __m256i invalid = _mm256_set1_epi32(kInvalidSubpixel);
+  const __m256i offsets = _mm256_mullo_epi32(
+    _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(dst_stride));
+  const __m256i columns =
+    _mm256_set1_epi32(static_cast<int32_t>(std::min(dst_len, t.num_columns)));
+  const __m256i num_columns = _mm256_set1_epi32(t.num_columns);
+  const __m256i last_row = _mm256_set1_epi32(t.num_rows - 1);
+  const __m256 row_scale = _mm256_set1_ps(t.row_scale);
+  const __m256d cos_yaw = _mm256_set1_pd(c.cos_yaw);
+  const __m256d cos_roll = _mm256_set1_pd(c.cos_roll);
+  const __m256d sin_roll = _mm256_set1_pd(c.sin_roll);
+  const __m256d shift_x = _mm256_set1_pd(c.shift_x_1000);
+  const __m256d shift_y = _mm256_set1_pd(c.shift_y_1000);
+  const __m256d scale = _mm256_set1_pd(c.float_scale);
+  int32_t xs[8];
+  int32_t ys[8];
+  float xfs[8];
+  float yfs[8];
+  ProfileSummary s = *summary;
+  uint32_t num_vector = num_vals;
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  // the columns are compared as signed integers
+  if (INT32_MAX < (dst_idx + static_cast<uint64_t>(num_vals) * dst_stride)) {
+    num_vector = 0;
+  }
+
+  for (; (j + 8) <= num_vector; j += 8) {
+    __m128i raw =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[j * 2]));
+    __m256i subpixel = _mm256_cvtepu16_epi32(_mm_shuffle_epi8(raw, swap));
+    __m256i m =
+      _mm256_add_epi32(_mm256_set1_epi32(dst_idx + j * dst_stride), offsets);
+    __m256 pos = _mm256_mul_ps(_mm256_cvtepi32_ps(subpixel), row_scale);
+    __m256i row = _mm256_cvttps_epi32(pos);
+
+    __m256i ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(subpixel, invalid),
+                                     _mm256_cmpgt_epi32(columns, m));
+    ok = _mm256_and_si256(ok, _mm256_cmpgt_epi32(last_row, row));
+    if (0 == _mm256_movemask_ps(_mm256_castsi256_ps(ok))) {
+      continue;
+    }
+
+    __m256 f = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(row));
+    __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(row, num_columns), m);
+    __m256 mask = _mm256_castsi256_ps(ok);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 x0 = _mm256_mask_i32gather_ps(zero, t.x, idx, mask, 4);
+    __m256 x1 = _mm256_mask_i32gather_ps(zero, t.x + t.num_columns, idx, mask, 4);
+    __m256 y0 = _mm256_mask_i32gather_ps(zero, t.y, idx, mask, 4);
+    __m256 y1 = _mm256_mask_i32gather_ps(zero, t.y + t.num_columns, idx, mask, 4);
+    __m256 x = _mm256_add_ps(x0, _mm256_mul_ps(f, _mm256_sub_ps(x1, x0)));
+    __m256 y = _mm256_add_ps(y0, _mm256_mul_ps(f, _mm256_sub_ps(y1, y0)));
+
+    // outside of the calibrated area
+    mask = _mm256_and_ps(mask, _mm256_cmp_ps(x, x, _CMP_ORD_Q));
+    mask = _mm256_and_ps(mask, _mm256_cmp_ps(y, y, _CMP_ORD_Q));
+    uint32_t valid = _mm256_movemask_ps(mask);
+    if (0 == valid) {
+      continue;
+    }
+
+    for (int h = 0; h < 2; h++) {
+      __m128 xh = (0 == h) ? _mm256_castps256_ps128(x)
+                           : _mm256_extractf128_ps(x, 1);
+      __m128 yh = (0 == h) ? _mm256_castps256_ps128(y)
+                           : _mm256_extractf128_ps(y, 1);
+      __m256d xd = _mm256_cvtps_pd(xh);
+      __m256d yd = _mm256_cvtps_pd(yh);
+      __m256d xc = _mm256_mul_pd(xd, cos_yaw);
+      __m256d xm = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(xc, cos_roll),
+                                               _mm256_mul_pd(yd, sin_roll)),
+                                 shift_x);
+      __m256d ym = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(xc, sin_roll),
+                                               _mm256_mul_pd(yd, cos_roll)),
+                                 shift_y);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&xs[h * 4]),
+                       _mm256_cvttpd_epi32(xm));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&ys[h * 4]),
+                       _mm256_cvttpd_epi32(ym));
+      if (nullptr != dst_x) {
+        _mm_storeu_ps(&xfs[h * 4], _mm256_cvtpd_ps(_mm256_mul_pd(xm, scale)));
+        _mm_storeu_ps(&yfs[h * 4], _mm256_cvtpd_ps(_mm256_mul_pd(ym, scale)));
+      }
+    }
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t n = dst_idx + (j + k) * dst_stride;
+      dst[n].x = xs[k];
+      dst[n].y = ys[k];
+      if (nullptr != dst_x) {
+        dst_x[n] = xfs[k];
+        dst_y[n] = yfs[k];
+      }
+      s.Add(xs[k], ys[k], n);
+      count++;
+    }
+  }
+
+  count += DecodeSubpixelRange(src, j, num_vals, t, c, dst, dst_x, dst_y,
+                               dst_idx, dst_stride, dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t DecodeBrightnessAVX2(const uint8_t *src, uint32_t num_vals,
+                                     jsProfileData *dst, uint32_t dst_idx,
+                                     uint32_t dst_stride, uint32_t dst_len)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 32) <= num_vals; j += 32) {
+    __m256i b =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[j]));
+    uint32_t valid =
+      ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, zero)));
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].brightness = static_cast<int32_t>(src[j + k]);
+        count++;
+      }
+    }
+  }
+
+  count +=
+    DecodeBrightnessRange(src, j, num_vals, dst, dst_idx, dst_stride, dst_len);
+
+  return count;
+}
+
+JS_SIMD_TARGET("avx2")
+static uint32_t CopyValidAVX2(const jsProfileData *src, uint32_t src_len,
+                              uint32_t stride, jsProfileData *dst)
+{
+  // `jsProfileData` is three packed 32 bit integers, gather the X and Y
+  // values of 8 entries at a time to test their validity together
+  const int32_t *base = reinterpret_cast<const int32_t *>(src);
+  const __m256i invalid = _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m256i offsets =
+    _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                       _mm256_set1_epi32(static_cast<int32_t>(stride) * 3));
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 7 * stride) < src_len; n += 8 * stride) {
+    __m256i x = _mm256_i32gather_epi32(&base[n * 3], offsets, 4);
+    __m256i y = _mm256_i32gather_epi32(&base[n * 3 + 1], offsets, 4);
+    __m256i bad = _mm256_and_si256(_mm256_cmpeq_epi32(x, invalid),
+                                   _mm256_cmpeq_epi32(y, invalid));
+    uint32_t valid = ~_mm256_movemask_ps(_mm256_castsi256_ps(bad)) & 0xFF;
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      dst[count++] = src[n + k * stride];
+    }
+  }
+
+  count += CopyValidRange(src, n, src_len, stride, &dst[count]);
+
+  return count;
+}
+
+JS_SIMD_TARGET("avx2")
+static void TemporalEMAAVX2(jsProfileData *data, uint32_t len, float *state,
+                            float alpha, int32_t reset_distance)
+{
+  int32_t *base = reinterpret_cast<int32_t *>(data);
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  const __m256i invalid = _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m256 invalid_f =
+    _mm256_set1_ps(static_cast<float>(JS_PROFILE_DATA_INVALID_XY));
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 a = _mm256_set1_ps(alpha);
+  const __m256 limit = _mm256_set1_ps(static_cast<float>(reset_distance));
+  int32_t ys[8];
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    __m256i y = _mm256_i32gather_epi32(&base[n * 3 + 1], offsets, 4);
+    __m256 yf = _mm256_cvtepi32_ps(y);
+    __m256 s = _mm256_loadu_ps(&state[n]);
+    __m256 d = _mm256_sub_ps(yf, s);
+
+    // the average is computed for all lanes, then replaced by the new value
+    // where the column starts over and by the invalid value where it has no
+    // point; same order of operations as the scalar kernel
+    __m256 prime = _mm256_cmp_ps(s, invalid_f, _CMP_EQ_OQ);
+    if (0 < reset_distance) {
+      __m256 dist = _mm256_andnot_ps(sign, d);
+      prime = _mm256_or_ps(prime, _mm256_cmp_ps(dist, limit, _CMP_GT_OQ));
+    }
+    s = _mm256_blendv_ps(_mm256_add_ps(s, _mm256_mul_ps(a, d)), yf, prime);
+    s = _mm256_blendv_ps(
+      s, invalid_f, _mm256_castsi256_ps(_mm256_cmpeq_epi32(y, invalid)));
+    _mm256_storeu_ps(&state[n], s);
+
+    // an inactive state converts to the invalid value, so invalid entries
+    // are written back unchanged
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ys),
+                        _mm256_cvtps_epi32(s));
+    for (int k = 0; k < 8; k++) {
+      data[n + k].y = ys[k];
+    }
+  }
+
+  TemporalEMARange(data, n, len, state, alpha, reset_distance);
+}
+
+JS_SIMD_TARGET("avx2")
+static void TemporalMedianAVX2(jsProfileData *data, uint32_t len,
+                               int32_t *history, int32_t *filtered,
+                               uint32_t window, uint32_t newest,
+                               int32_t reset_distance)
+{
+  int32_t *base = reinterpret_cast<int32_t *>(data);
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  const __m256i invalid = _mm256_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m256i limit = _mm256_set1_epi32(reset_distance);
+  __m256i v[JS_TEMPORAL_FILTER_WINDOW_MAX];
+  int32_t ys[8];
+  uint32_t n = 0;
+
+  for (; (n + 8) <= len; n += 8) {
+    __m256i y = _mm256_i32gather_epi32(&base[n * 3 + 1], offsets, 4);
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<__m256i *>(&filtered[n]));
+    __m256i bad = _mm256_cmpeq_epi32(y, invalid);
+    __m256i valid = _mm256_xor_si256(bad, _mm256_set1_epi32(-1));
+    __m256i prime = _mm256_cmpeq_epi32(f, invalid);
+    if (0 < reset_distance) {
+      __m256i dist = _mm256_abs_epi32(_mm256_sub_epi32(y, f));
+      prime = _mm256_or_si256(prime, _mm256_cmpgt_epi32(dist, limit));
+    }
+    // invalid entries leave their history alone
+    prime = _mm256_and_si256(valid, prime);
+
+    for (uint32_t k = 0; k < window; k++) {
+      __m256i *row = reinterpret_cast<__m256i *>(&history[k * len + n]);
+      __m256i h = _mm256_loadu_si256(row);
+      h = _mm256_blendv_epi8(h, y, (k == newest) ? valid : prime);
+      _mm256_storeu_si256(row, h);
+      v[k] = h;
+    }
+
+    // odd-even transposition sort of the history of 8 columns at once, the
+    // median ends up in the middle row
+    for (uint32_t pass = 0; pass < window; pass++) {
+      for (uint32_t k = pass & 1; (k + 1) < window; k += 2) {
+        __m256i lo = _mm256_min_epi32(v[k], v[k + 1]);
+        v[k + 1] = _mm256_max_epi32(v[k], v[k + 1]);
+        v[k] = lo;
+      }
+    }
+
+    __m256i m = _mm256_blendv_epi8(v[window / 2], invalid, bad);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&filtered[n]), m);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ys), m);
+    for (int k = 0; k < 8; k++) {
+      data[n + k].y = ys[k];
+    }
+  }
+
+  TemporalMedianRange(data, n, len, history, filtered, window, newest,
+                      reset_distance);
+}
+
+/*
+ * AVX-512 kernels, 16 X/Y points or 64 brightness values per iteration.
+ */
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t DecodeXYAVX512(const uint8_t *src, uint32_t num_vals,
+                               const CameraToMillCoefficients &c,
+                               jsProfileData *dst, float *dst_x, float *dst_y,
+                               uint32_t dst_idx, uint32_t dst_stride,
+                               uint32_t dst_len, ProfileSummary *summary)
+{
+  const __m512i swap = _mm512_set_epi64(
+    0x0e0f0c0d0a0b0809, 0x0607040502030001, 0x0e0f0c0d0a0b0809,
+    0x0607040502030001, 0x0e0f0c0d0a0b0809, 0x0607040502030001,
+    0x0e0f0c0d0a0b0809, 0x0607040502030001);
+  const __m512i invalid = _mm512_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m512d cos_yaw = _mm512_set1_pd(c.cos_yaw);
+  const __m512d cos_roll = _mm512_set1_pd(c.cos_roll);
+  const __m512d sin_roll = _mm512_set1_pd(c.sin_roll);
+  const __m512d shift_x = _mm512_set1_pd(c.shift_x_1000);
+  const __m512d shift_y = _mm512_set1_pd(c.shift_y_1000);
+  const __m512d scale = _mm512_set1_pd(c.float_scale);
+  int32_t xs[16];
+  int32_t ys[16];
+  float xfs[16];
+  float yfs[16];
+  ProfileSummary s = *summary;
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 16) <= num_vals; j += 16) {
+    __m512i raw = _mm512_loadu_si512(&src[j * 4]);
+    raw = _mm512_shuffle_epi8(raw, swap);
+    __m512i x = _mm512_srai_epi32(_mm512_slli_epi32(raw, 16), 16);
+    __m512i y = _mm512_srai_epi32(raw, 16);
+
+    uint32_t valid = _mm512_cmpneq_epi32_mask(x, invalid) &
+                     _mm512_cmpneq_epi32_mask(y, invalid);
+    if (0 == valid) {
+      continue;
+    }
+
+    for (int h = 0; h < 2; h++) {
+      __m256i xh = (0 == h) ? _mm512_castsi512_si256(x)
+                            : _mm512_extracti64x4_epi64(x, 1);
+      __m256i yh = (0 == h) ? _mm512_castsi512_si256(y)
+                            : _mm512_extracti64x4_epi64(y, 1);
+      __m512d xd = _mm512_cvtepi32_pd(xh);
+      __m512d yd = _mm512_cvtepi32_pd(yh);
+      __m512d xc = _mm512_mul_pd(xd, cos_yaw);
+      __m512d xm = _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(xc, cos_roll),
+                                               _mm512_mul_pd(yd, sin_roll)),
+                                 shift_x);
+      __m512d ym = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(xc, sin_roll),
+                                               _mm512_mul_pd(yd, cos_roll)),
+                                 shift_y);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(&xs[h * 8]),
+                          _mm512_cvttpd_epi32(xm));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(&ys[h * 8]),
+                          _mm512_cvttpd_epi32(ym));
+      if (nullptr != dst_x) {
+        _mm256_storeu_ps(&xfs[h * 8],
+                         _mm512_cvtpd_ps(_mm512_mul_pd(xm, scale)));
+        _mm256_storeu_ps(&yfs[h * 8],
+                         _mm512_cvtpd_ps(_mm512_mul_pd(ym, scale)));
+      }
+    }
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].x = xs[k];
+        dst[m].y = ys[k];
+        if (nullptr != dst_x) {
+          dst_x[m] = xfs[k];
+          dst_y[m] = yfs[k];
+        }
+        s.Add(xs[k], ys[k], m);
+        count++;
+      }
+    }
+  }
+
+  count += DecodeXYRange(src, j, num_vals, c, dst, dst_x, dst_y, dst_idx,
+                         dst_stride, dst_len, s);
+  *summary = s;
+
+  return count;
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t DecodeBrightnessAVX512(const uint8_t *src, uint32_t num_vals,
+                                       jsProfileData *dst, uint32_t dst_idx,
+                                       uint32_t dst_stride, uint32_t dst_len)
+{
+  const __m512i zero = _mm512_setzero_si512();
+  uint32_t count = 0;
+  uint32_t j = 0;
+
+  for (; (j + 64) <= num_vals; j += 64) {
+    __m512i b = _mm512_loadu_si512(&src[j]);
+    uint64_t valid = _mm512_cmpneq_epi8_mask(b, zero);
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      uint32_t m = dst_idx + (j + k) * dst_stride;
+      if (m < dst_len) {
+        dst[m].brightness = static_cast<int32_t>(src[j + k]);
+        count++;
+      }
+    }
+  }
+
+  count +=
+    DecodeBrightnessRange(src, j, num_vals, dst, dst_idx, dst_stride, dst_len);
+
+  return count;
+}
+
+JS_SIMD_TARGET("avx512f,avx512bw")
+static uint32_t CopyValidAVX512(const jsProfileData *src, uint32_t src_len,
+                                uint32_t stride, jsProfileData *dst)
+{
+  const int32_t *base = reinterpret_cast<const int32_t *>(src);
+  const __m512i invalid = _mm512_set1_epi32(JS_PROFILE_DATA_INVALID_XY);
+  const __m512i offsets = _mm512_mullo_epi32(
+    _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+    _mm512_set1_epi32(static_cast<int32_t>(stride) * 3));
+  uint32_t count = 0;
+  uint32_t n = 0;
+
+  for (; (n + 15 * stride) < src_len; n += 16 * stride) {
+    __m512i x = _mm512_i32gather_epi32(offsets, &base[n * 3], 4);
+    __m512i y = _mm512_i32gather_epi32(offsets, &base[n * 3 + 1], 4);
+    uint32_t valid = _mm512_cmpneq_epi32_mask(x, invalid) |
+                     _mm512_cmpneq_epi32_mask(y, invalid);
+
+    while (0 != valid) {
+      int k = CountTrailingZeros(valid);
+      valid &= valid - 1;
+      dst[count++] = src[n + k * stride];
+    }
+  }
+
+  count += CopyValidRange(src, n, src_len, stride, &dst[count]);
+
+  return count;
+}
+
+/*
+ * Runtime detection of the instruction sets supported by the CPU.
+ */
+
+#if defined(_MSC_VER)
+static bool IsSupported(jsSimdVariant variant)
+{
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const bool sse42 = (0 != (info[2] & (1 << 20)));
+  const bool osxsave = (0 != (info[2] & (1 << 27)));
+  // the OS must save the AVX (and AVX-512) register state on context switch
+  const uint64_t xcr0 = (osxsave) ? _xgetbv(0) : 0;
+  const bool os_avx = (0x6 == (xcr0 & 0x6));
+  const bool os_avx512 = (0xE6 == (xcr0 & 0xE6));
+
+  bool avx2 = false;
+  bool avx512 = false;
+  if (7 <= max_leaf) {
+    __cpuidex(info, 7, 0);
+    avx2 = os_avx && (0 != (info[1] & (1 << 5)));
+    avx512 = os_avx512 && (0 != (info[1] & (1 << 16))) &&
+             (0 != (info[1] & (1 << 30)));
+  }
+
+  switch (variant) {
+    case JS_SIMD_VARIANT_SSE42:
+      return sse42;
+    case JS_SIMD_VARIANT_AVX2:
+      return avx2;
+    case JS_SIMD_VARIANT_AVX512:
+      return avx512;
+    default:
+      return true;
+  }
+}
+#else
+static bool IsSupported(jsSimdVariant variant)
+{
+  __builtin_cpu_init();
+
+  switch (variant) {
+    case JS_SIMD_VARIANT_SSE42:
+      return __builtin_cpu_supports("sse4.2");
+    case JS_SIMD_VARIANT_AVX2:
+      return __builtin_cpu_supports("avx2");
+    case JS_SIMD_VARIANT_AVX512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512bw");
+    default:
+      return true;
+  }
+}
+#endif
+#else
+static bool IsSupported(jsSimdVariant variant)
+{
+  return (JS_SIMD_VARIANT_SCALAR == variant);
+}
+#endif // JS_SIMD_X86
+
+// Ordered from least to most preferred.
+static const SimdKernels kSimdKernels[] = {
+  {JS_SIMD_VARIANT_SCALAR, "scalar", DecodeXYScalar, DecodeSubpixelScalar,
+   DecodeBrightnessScalar, CopyValidScalar, TemporalEMAScalar,
+   TemporalMedianScalar},
+#ifdef JS_SIMD_X86
+  // the gather instructions needed to vectorize `copy_valid`, the mapping
+  // table lookups and the temporal filters were introduced with AVX2, the
+  // scalar versions are used for SSE4.2
+  {JS_SIMD_VARIANT_SSE42, "sse4.2", DecodeXYSSE42, DecodeSubpixelScalar,
+   DecodeBrightnessSSE42, CopyValidScalar, TemporalEMAScalar,
+   TemporalMedianScalar},
+  {JS_SIMD_VARIANT_AVX2, "avx2", DecodeXYAVX2, DecodeSubpixelAVX2,
+   DecodeBrightnessAVX2, CopyValidAVX2, TemporalEMAAVX2, TemporalMedianAVX2},
+  // the mapping table lookups and the temporal filters are bound by their
+  // gathers and scattered stores, wider vectors gain nothing over the AVX2
+  // versions
+  {JS_SIMD_VARIANT_AVX512, "avx512", DecodeXYAVX512, DecodeSubpixelAVX2,
+   DecodeBrightnessAVX512, CopyValidAVX512, TemporalEMAAVX2,
+   TemporalMedianAVX2},
+#endif
+};
+
+static const int kNumSimdKernels =
+  sizeof(kSimdKernels) / sizeof(kSimdKernels[0]);
+
+static const SimdKernels &SelectSimdKernels()
+{
+  int selected = 0;
+
+  for (int n = 0; n < kNumSimdKernels; n++) {
+    if (IsSupported(kSimdKernels[n].variant)) {
+      selected = n;
+    }
+  }
+
+  return kSimdKernels[selected];
+}
+
+const SimdKernels &joescan::GetSimdKernels()
+{
+  // initialization of function local statics is thread safe in C++11
+  static const SimdKernels &kernels = SelectSimdKernels();
+  return kernels;
+}
+
+const SimdKernels *joescan::GetSimdKernels(jsSimdVariant variant)
+{
+  for (int n = 0; n < kNumSimdKernels; n++) {
+    if ((variant == kSimdKernels[n].variant) && IsSupported(variant)) {
+      return &kSimdKernels[n];
+    }
+  }
+
+  return nullptr;
+}
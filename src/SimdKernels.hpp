@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_SIMD_KERNELS_H
+#define JOESCAN_SIMD_KERNELS_H
+
+#include <cstdint>
+
+#include "AlignmentParams.hpp"
+#include "MappingTable.hpp"
+#include "ProfileSummary.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Table of the hot path kernels used to decode profile data out of
+ * data packets and to copy it out to the end user. The library is built for
+ * the baseline instruction set of the target, so each kernel is compiled
+ * multiple times for different instruction sets and the best table for the
+ * CPU is chosen once at runtime.
+ */
+struct SimdKernels {
+  /** @brief The instruction set this table of kernels was built for. */
+  jsSimdVariant variant;
+  /** @brief Human readable name of the instruction set. */
+  const char *name;
+
+  /**
+   * Decodes the big endian X/Y pairs of a data packet fragment, converts the
+   * valid points from camera to mill coordinates and stores them in the
+   * destination array at `dst_idx + n * dst_stride`. Points that would be
+   * placed at or beyond `dst_len` are discarded. If float arrays are given,
+   * the mill coordinates are also scaled by `c.float_scale` and stored there
+   * at the same index, rounded to float rather than truncated.
+   *
+   * @param src Pointer to the first X/Y pair in the data packet.
+   * @param num_vals The number of X/Y pairs in the fragment.
+   * @param c The camera to mill transform coefficients.
+   * @param dst The profile data array to fill in.
+   * @param dst_x The float X array to fill in, `nullptr` for none.
+   * @param dst_y The float Y array to fill in, `nullptr` for none.
+   * @param dst_idx The destination index of the first X/Y pair.
+   * @param dst_stride The destination index increment between X/Y pairs.
+   * @param dst_len The length of the destination array.
+   * @param summary The summary of the profile, each stored point is added.
+   * @return The number of valid points stored.
+   */
+  uint32_t (*decode_xy)(const uint8_t *src, uint32_t num_vals,
+                        const CameraToMillCoefficients &c, jsProfileData *dst,
+                        float *dst_x, float *dst_y, uint32_t dst_idx,
+                        uint32_t dst_stride, uint32_t dst_len,
+                        ProfileSummary *summary);
+
+  /**
+   * Decodes the big endian subpixel rows of a data packet fragment, looks up
+   * the camera coordinates of each in the mapping table of its column,
+   * converts them from camera to mill coordinates and stores them as
+   * `decode_xy` does. A subpixel row is invalid if it is beyond the last row
+   * of the table or either table entry it lies between is NaN.
+   *
+   * @param src Pointer to the first subpixel row in the data packet.
+   * @param num_vals The number of subpixel rows in the fragment.
+   * @param t The mapping table of the camera.
+   * @param c The camera to mill transform coefficients.
+   * @param dst The profile data array to fill in.
+   * @param dst_x The float X array to fill in, `nullptr` for none.
+   * @param dst_y The float Y array to fill in, `nullptr` for none.
+   * @param dst_idx The destination index, and column, of the first row.
+   * @param dst_stride The destination index increment between rows.
+   * @param dst_len The length of the destination array.
+   * @param summary The summary of the profile, each stored point is added.
+   * @return The number of valid points stored.
+   */
+  uint32_t (*decode_subpixel)(const uint8_t *src, uint32_t num_vals,
+                              const MappingTableLookup &t,
+                              const CameraToMillCoefficients &c,
+                              jsProfileData *dst, float *dst_x, float *dst_y,
+                              uint32_t dst_idx, uint32_t dst_stride,
+                              uint32_t dst_len, ProfileSummary *summary);
+
+  /**
+   * Decodes the brightness values of a data packet fragment, storing the
+   * valid values in the destination array at `dst_idx + n * dst_stride`.
+   *
+   * @param src Pointer to the first brightness value in the data packet.
+   * @param num_vals The number of brightness values in the fragment.
+   * @param dst The profile data array to fill in.
+   * @param dst_idx The destination index of the first brightness value.
+   * @param dst_stride The destination index increment between values.
+   * @param dst_len The length of the destination array.
+   * @return The number of valid brightness values stored.
+   */
+  uint32_t (*decode_brightness)(const uint8_t *src, uint32_t num_vals,
+                                jsProfileData *dst, uint32_t dst_idx,
+                                uint32_t dst_stride, uint32_t dst_len);
+
+  /**
+   * Copies every `stride` entry of the source array holding a valid X/Y
+   * point into the destination array, packing them at its beginning.
+   *
+   * @param src The profile data array to copy from.
+   * @param src_len The length of the source array.
+   * @param stride The index increment between entries to inspect.
+   * @param dst The array to copy valid points to; must be able to hold
+   * `src_len / stride` rounded up entries.
+   * @return The number of points copied.
+   */
+  uint32_t (*copy_valid)(const jsProfileData *src, uint32_t src_len,
+                         uint32_t stride, jsProfileData *dst);
+
+  /**
+   * Smooths the Y value of each entry of a profile with an exponential
+   * moving average over successive profiles. An entry whose state is
+   * inactive, or whose value differs from its state by more than the reset
+   * distance, starts over from its value; an invalid entry makes its state
+   * inactive.
+   *
+   * @param data The profile data array, its Y values are replaced.
+   * @param len The length of the profile data array.
+   * @param state The average of each entry, `JS_PROFILE_DATA_INVALID_XY`
+   * if inactive; updated.
+   * @param alpha The weight of the new value.
+   * @param reset_distance The largest change that is smoothed, `0` for any.
+   */
+  void (*temporal_ema)(jsProfileData *data, uint32_t len, float *state,
+                       float alpha, int32_t reset_distance);
+
+  /**
+   * Smooths the Y value of each entry of a profile with the median of its
+   * values over successive profiles. An entry whose last filtered value is
+   * inactive, or differs from its value by more than the reset distance,
+   * fills its history with its value; an invalid entry becomes inactive.
+   *
+   * @param data The profile data array, its Y values are replaced.
+   * @param len The length of the profile data array.
+   * @param history `window` rows of `len` values, the history of each entry
+   * is a column; updated.
+   * @param filtered The last filtered value of each entry,
+   * `JS_PROFILE_DATA_INVALID_XY` if inactive; updated.
+   * @param window The odd number of values to take the median of.
+   * @param newest The row of the history to store the values in.
+   * @param reset_distance The largest change that is smoothed, `0` for any.
+   */
+  void (*temporal_median)(jsProfileData *data, uint32_t len,
+                          int32_t *history, int32_t *filtered,
+                          uint32_t window, uint32_t newest,
+                          int32_t reset_distance);
+};
+
+/**
+ * Obtains the kernels best suited for the CPU the library is running on. The
+ * selection is made the first time this function is called and is fixed for
+ * the lifetime of the process.
+ *
+ * @return Reference to the selected kernel table.
+ */
+const SimdKernels &GetSimdKernels();
+
+/**
+ * Obtains the kernels built for a specific instruction set, irrespective of
+ * which was selected. This is intended for validating and benchmarking the
+ * variants against each other.
+ *
+ * @param variant The instruction set of the kernels.
+ * @return Pointer to the kernel table, `nullptr` if the variant was not built
+ * or is not supported by the CPU.
+ */
+const SimdKernels *GetSimdKernels(jsSimdVariant variant);
+} // namespace joescan
+
+#endif // JOESCAN_SIMD_KERNELS_H
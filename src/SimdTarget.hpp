@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_SIMD_TARGET_H
+#define JOESCAN_SIMD_TARGET_H
+
+/*
+ * Common definitions for source files implementing kernels for multiple
+ * instruction sets. This is only meant to be included by such source files,
+ * never by other headers.
+ */
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+  defined(_M_IX86)
+#define JS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(JS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+// GCC and Clang only allow intrinsics to be used within functions that are
+// explicitly built for the instruction set they belong to.
+#define JS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#elif defined(JS_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#define JS_SIMD_TARGET(isa)
+#else
+// Not an x86 target, only the scalar kernels are built.
+#undef JS_SIMD_X86
+#endif
+
+namespace joescan {
+inline int CountTrailingZeros(uint64_t v)
+{
+#if defined(_MSC_VER)
+  unsigned long idx = 0;
+#if defined(_M_X64)
+  _BitScanForward64(&idx, v);
+#else
+  if (0 != static_cast<uint32_t>(v)) {
+    _BitScanForward(&idx, static_cast<uint32_t>(v));
+  } else {
+    _BitScanForward(&idx, static_cast<uint32_t>(v >> 32));
+    idx += 32;
+  }
+#endif
+  return static_cast<int>(idx);
+#else
+  return __builtin_ctzll(v);
+#endif
+}
+
+inline int PopCount(uint32_t v)
+{
+  // portable bit count, avoids requiring the POPCNT instruction
+  v = v - ((v >> 1) & 0x55555555);
+  v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+  return static_cast<int>((((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
+} // namespace joescan
+
+#endif // JOESCAN_SIMD_TARGET_H
@@ -7,11 +7,39 @@
 
 #include "StatusMessage.hpp"
 #include "Enums.hpp"
-#include "TcpSerializationHelpers.hpp"
+#include "MessageSchema.hpp"
 #include "VersionParser.hpp"
 
 using namespace joescan;
 
+#define FIELD(m) SCHEMA_FIELD(StatusMessage::StatusMessagePacket, m)
+
+struct StatusMessage::Layout {
+  // the fields following the version information that are always sent
+  typedef MessageSchema<FIELD(serial_number), FIELD(max_scan_rate),
+                        FIELD(scan_head_ip), FIELD(client_ip),
+                        FIELD(client_port), FIELD(scan_sync_id),
+                        FIELD(global_time), FIELD(num_packets_sent),
+                        FIELD(num_profiles_sent), FIELD(valid_encoders),
+                        FIELD(valid_cameras)>
+    Static;
+
+  static constexpr uint32_t kFixedSize =
+    InfoHeaderSchema::kSize + VersionInformationSchema::kSize + Static::kSize;
+
+  /**
+   * @return The size of the message, including the encoder and camera
+   * values its counts call for.
+   */
+  static uint32_t GetSize(const StatusMessagePacket &pkt)
+  {
+    return kFixedSize + pkt.valid_encoders * sizeof(uint64_t) +
+           pkt.valid_cameras * 2 * sizeof(int32_t);
+  }
+};
+
+#undef FIELD
+
 StatusMessage::StatusMessage()
 {
   packet.header.magic = kResponseMagic;
@@ -36,97 +64,75 @@ StatusMessage::StatusMessage(uint8_t *bytes, uint32_t num_bytes)
     throw std::runtime_error("Invalid number of status bytes");
   }
 
-  uint8_t *idx_p = bytes;
+  const uint8_t *idx_p = bytes;
 
-  // InfoHeader
-  idx_p += ExtractFromNetworkBuffer(packet.header.magic, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.header.size, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.header.type, idx_p);
+  idx_p = InfoHeaderSchema::Read(packet.header, idx_p);
   ValidatePacketHeader(packet.header);
 
-  // VersionInformation
-  idx_p += VersionParser::Deserialize(packet.version, idx_p);
+  idx_p = VersionInformationSchema::Read(packet.version, idx_p);
   ValidatePacketVersion(packet.version);
 
-  // Static Data
-  idx_p += ExtractFromNetworkBuffer(packet.serial_number, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.max_scan_rate, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.scan_head_ip, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.client_ip, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.client_port, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.scan_sync_id, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.global_time, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.num_packets_sent, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.num_profiles_sent, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.valid_encoders, idx_p);
-  idx_p += ExtractFromNetworkBuffer(packet.valid_cameras, idx_p);
+  if (num_bytes < Layout::kFixedSize) {
+    throw std::runtime_error("Invalid number of status bytes");
+  }
+
+  idx_p = Layout::Static::Read(packet, idx_p);
   ValidatePacketData(packet);
 
+  if ((Layout::GetSize(packet) != packet.header.size) ||
+      (packet.header.size > num_bytes)) {
+    throw std::runtime_error("Failed to extract the status message");
+  }
+
   // Variable Data
   for (int i = 0; i < packet.valid_encoders; i++) {
-    idx_p += ExtractFromNetworkBuffer(packet.encoders[i], idx_p);
+    packet.encoders[i] = LoadNetwork<uint64_t>(idx_p);
+    idx_p += sizeof(uint64_t);
   }
 
   for (int i = 0; i < packet.valid_cameras; i++) {
-    idx_p += ExtractFromNetworkBuffer(packet.pixels_in_window[i], idx_p);
+    packet.pixels_in_window[i] = LoadNetwork<int32_t>(idx_p);
+    idx_p += sizeof(int32_t);
   }
 
   for (int i = 0; i < packet.valid_cameras; i++) {
-    idx_p += ExtractFromNetworkBuffer(packet.camera_temp[i], idx_p);
-  }
-
-  if (idx_p != (bytes + packet.header.size)) {
-    throw std::runtime_error("Failed to extract the status message");
+    packet.camera_temp[i] = LoadNetwork<int32_t>(idx_p);
+    idx_p += sizeof(int32_t);
   }
 }
 
 std::vector<uint8_t> StatusMessage::Serialize() const
 {
-  std::vector<uint8_t> message;
-  message.reserve(kMaxStatusMessageSize);
-
   ValidatePacketHeader(packet.header);
   ValidatePacketData(packet);
 
-  // InfoHeader
-  SerializeIntegralToBytes(message, &packet.header.magic);
-  SerializeIntegralToBytes(message, &packet.header.size);
-  SerializeIntegralToBytes(message, &packet.header.type);
-
-  // VersionInformation
-  VersionParser::Serialize(message, packet.version);
-
-  // Static Data
-  SerializeIntegralToBytes(message, &packet.serial_number);
-  SerializeIntegralToBytes(message, &packet.max_scan_rate);
-  SerializeIntegralToBytes(message, &packet.scan_head_ip);
-  SerializeIntegralToBytes(message, &packet.client_ip);
-  SerializeIntegralToBytes(message, &packet.client_port);
-  SerializeIntegralToBytes(message, &packet.scan_sync_id);
-  SerializeIntegralToBytes(message, &packet.global_time);
-  SerializeIntegralToBytes(message, &packet.num_packets_sent);
-  SerializeIntegralToBytes(message, &packet.num_profiles_sent);
-  SerializeIntegralToBytes(message, &packet.valid_encoders);
-  SerializeIntegralToBytes(message, &packet.valid_cameras);
+  // the size field is the only one not known until the counts are
+  InfoHeader hdr = packet.header;
+  hdr.size = static_cast<uint8_t>(Layout::GetSize(packet));
+
+  std::vector<uint8_t> message(hdr.size);
+  uint8_t *idx_p = message.data();
+
+  idx_p = InfoHeaderSchema::Write(hdr, idx_p);
+  idx_p = VersionInformationSchema::Write(packet.version, idx_p);
+  idx_p = Layout::Static::Write(packet, idx_p);
 
   // Variable Data
   for (int i = 0; i < packet.valid_encoders; i++) {
-    SerializeIntegralToBytes(message, &packet.encoders[i]);
+    StoreNetwork(idx_p, packet.encoders[i]);
+    idx_p += sizeof(uint64_t);
   }
 
   for (int i = 0; i < packet.valid_cameras; i++) {
-    SerializeIntegralToBytes(message, &packet.pixels_in_window[i]);
+    StoreNetwork(idx_p, packet.pixels_in_window[i]);
+    idx_p += sizeof(int32_t);
   }
 
   for (int i = 0; i < packet.valid_cameras; i++) {
-    SerializeIntegralToBytes(message, &packet.camera_temp[i]);
+    StoreNetwork(idx_p, packet.camera_temp[i]);
+    idx_p += sizeof(int32_t);
   }
 
-  // We don't know the size of the message until this point, so
-  // update the size field in the serialized message
-  InfoHeader *hdr = reinterpret_cast<InfoHeader *>(message.data());
-  hdr->size = static_cast<uint8_t>(message.size());
-
   return message;
 }
 
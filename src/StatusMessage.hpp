@@ -275,6 +275,9 @@ class StatusMessage {
   };
 #pragma pack(pop)
 
+  // the field layout of the message, defined with the serialization
+  struct Layout;
+
   StatusMessagePacket packet;
   static const int kMaxStatusMessageSize = sizeof(StatusMessagePacket);
   static const int kMinStatusMessageSize =
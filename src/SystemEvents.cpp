@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "SystemEvents.hpp"
+#include "ClockModel.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace joescan;
+
+// posting never takes the lock a waiting thread sleeps under, so a wakeup
+// can slip in between its check and its wait; waits are cut into slices to
+// bound how long such an event goes unnoticed
+static const std::chrono::microseconds kWaitSlice(10000);
+
+SystemEvents::SystemEvents()
+  : head(0),
+    tail(0),
+    num_dropped(0),
+    num_waiting(0)
+{
+  for (uint32_t n = 0; n < kCapacity; n++) {
+    slots[n].sequence.store(n, std::memory_order_relaxed);
+  }
+}
+
+void SystemEvents::Post(jsSystemEventType type, uint32_t scan_head_id,
+                        int64_t value)
+{
+  uint64_t pos = tail.load(std::memory_order_relaxed);
+  Slot *slot = nullptr;
+
+  for (;;) {
+    slot = &slots[pos & (kCapacity - 1)];
+    uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - pos);
+
+    if (0 == diff) {
+      if (tail.compare_exchange_weak(pos, pos + 1,
+                                     std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (0 > diff) {
+      // the oldest event has not been read yet
+      num_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->event.type = type;
+  slot->event.scan_head_id = scan_head_id;
+  slot->event.timestamp_ns = GetHostTimeNs();
+  slot->event.value = value;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+
+  if (0 < num_waiting.load()) {
+    wait_cond.notify_all();
+  }
+}
+
+uint32_t SystemEvents::Pop(jsSystemEvent *events, uint32_t max_events)
+{
+  uint32_t n = 0;
+
+  while ((n < max_events) && TryPop(&events[n])) {
+    n++;
+  }
+
+  // the count of events lost is reported once the queue has room again
+  if (n < max_events) {
+    uint64_t dropped = num_dropped.exchange(0, std::memory_order_relaxed);
+    if (0 < dropped) {
+      events[n].type = JS_SYSTEM_EVENT_EVENTS_DROPPED;
+      events[n].scan_head_id = UINT32_MAX;
+      events[n].timestamp_ns = GetHostTimeNs();
+      events[n].value = static_cast<int64_t>(dropped);
+      n++;
+    }
+  }
+
+  return n;
+}
+
+uint32_t SystemEvents::Available() const
+{
+  uint64_t h = head.load(std::memory_order_relaxed);
+  uint64_t t = tail.load(std::memory_order_relaxed);
+  uint64_t n = (t > h) ? std::min(t - h, static_cast<uint64_t>(kCapacity)) : 0;
+
+  if (0 < num_dropped.load(std::memory_order_relaxed)) {
+    n++;
+  }
+
+  return static_cast<uint32_t>(n);
+}
+
+uint32_t SystemEvents::WaitUntilAvailable(uint32_t timeout_us)
+{
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(timeout_us);
+  std::unique_lock<std::mutex> lock(wait_lock);
+
+  num_waiting++;
+  while (0 == Available()) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      break;
+    }
+
+    auto remaining =
+      std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+    wait_cond.wait_for(lock, std::min(remaining, kWaitSlice));
+  }
+  num_waiting--;
+
+  return Available();
+}
+
+bool SystemEvents::TryPop(jsSystemEvent *event)
+{
+  uint64_t pos = head.load(std::memory_order_relaxed);
+  Slot *slot = nullptr;
+
+  for (;;) {
+    slot = &slots[pos & (kCapacity - 1)];
+    uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+
+    if (0 == diff) {
+      if (head.compare_exchange_weak(pos, pos + 1,
+                                     std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (0 > diff) {
+      // empty, or the next event is still being written
+      return false;
+    } else {
+      pos = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  *event = slot->event;
+  slot->sequence.store(pos + kCapacity, std::memory_order_release);
+
+  return true;
+}
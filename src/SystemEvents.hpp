@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_SYSTEM_EVENTS_H
+#define JOESCAN_SYSTEM_EVENTS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Delivers the events of a scan system to the application. Events
+ * are posted from the receiver and sender threads as well as the API, so the
+ * queue is a bounded multi-producer multi-consumer ring where each slot
+ * carries a sequence number; posting claims a slot with a single compare and
+ * swap and never blocks or allocates. Events posted while the queue is full
+ * are counted and reported by one event once the queue has been read out.
+ */
+class SystemEvents {
+ public:
+  SystemEvents();
+
+  /**
+   * Adds an event, timestamped with the host time; never blocks.
+   *
+   * @param type The type of the event.
+   * @param scan_head_id The ID of the scan head the event concerns.
+   * @param value The value of the event, its meaning depends on the type.
+   */
+  void Post(jsSystemEventType type, uint32_t scan_head_id, int64_t value);
+
+  /**
+   * Removes the oldest events.
+   *
+   * @param events Array to be filled with events.
+   * @param max_events The maximum number of events to remove.
+   * @return The number of events removed.
+   */
+  uint32_t Pop(jsSystemEvent *events, uint32_t max_events);
+
+  /**
+   * @return The number of events waiting to be removed.
+   */
+  uint32_t Available() const;
+
+  /**
+   * Blocks until an event is waiting to be removed or the timeout expires.
+   *
+   * @param timeout_us The maximum time to wait in microseconds.
+   * @return The number of events waiting to be removed.
+   */
+  uint32_t WaitUntilAvailable(uint32_t timeout_us);
+
+ private:
+  static const uint32_t kCapacity = JS_SYSTEM_EVENTS_MAX;
+  static_assert(0 == (kCapacity & (kCapacity - 1)),
+                "Capacity must be a power of two");
+
+  struct Slot {
+    // equals the position of the next post to the slot when free, one past
+    // the position of the event it holds when full
+    std::atomic<uint64_t> sequence;
+    jsSystemEvent event;
+  };
+
+  bool TryPop(jsSystemEvent *event);
+
+  Slot slots[kCapacity];
+  std::atomic<uint64_t> head;
+  std::atomic<uint64_t> tail;
+  std::atomic<uint64_t> num_dropped;
+
+  std::atomic<uint32_t> num_waiting;
+  std::mutex wait_lock;
+  std::condition_variable wait_cond;
+};
+} // namespace joescan
+
+#endif // JOESCAN_SYSTEM_EVENTS_H
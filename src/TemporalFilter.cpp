@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "TemporalFilter.hpp"
+#include "SimdKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace joescan;
+
+static int _source_index(jsCamera camera, jsLaser laser)
+{
+  return static_cast<int>(camera) * JS_LASER_MAX + static_cast<int>(laser);
+}
+
+TemporalFilter::TemporalFilter() : is_enabled(false)
+{
+  memset(&config, 0, sizeof(config));
+  Reset();
+}
+
+void TemporalFilter::Enable(const jsTemporalFilterConfig &config)
+{
+  this->config = config;
+
+  if (JS_TEMPORAL_FILTER_EMA == config.type) {
+    ema.resize(kMaxSources * kLen);
+    std::vector<int32_t>().swap(filtered);
+    std::vector<int32_t>().swap(history);
+  } else {
+    std::vector<float>().swap(ema);
+    filtered.resize(kMaxSources * kLen);
+    history.resize(kMaxSources * config.window * kLen);
+  }
+
+  Reset();
+  is_enabled = true;
+}
+
+void TemporalFilter::Disable()
+{
+  is_enabled = false;
+  std::vector<float>().swap(ema);
+  std::vector<int32_t>().swap(filtered);
+  std::vector<int32_t>().swap(history);
+}
+
+bool TemporalFilter::IsEnabled() const
+{
+  return is_enabled;
+}
+
+void TemporalFilter::Reset()
+{
+  for (int n = 0; n < kMaxSources; n++) {
+    ResetSource(n);
+  }
+}
+
+void TemporalFilter::Apply(Profile &profile)
+{
+  jsCamera camera = profile.GetCamera();
+  jsLaser laser = profile.GetLaser();
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return;
+  } else if (kLen != profile.GetDataLength()) {
+    // profiles holding only an image have no data to filter
+    return;
+  }
+
+  int source = _source_index(camera, laser);
+  if (profile.GetPieceId() != piece_id[source]) {
+    ResetSource(source);
+    piece_id[source] = profile.GetPieceId();
+  }
+
+  const SimdKernels &kernels = GetSimdKernels();
+  jsProfileData *data = profile.GetDataPointer();
+  const uint32_t len = kLen;
+
+  if (JS_TEMPORAL_FILTER_EMA == config.type) {
+    kernels.temporal_ema(data, len, &ema[source * kLen],
+                         static_cast<float>(config.alpha),
+                         config.reset_distance);
+  } else {
+    // the history rows are used round robin, oldest values first
+    uint32_t window = config.window;
+    newest[source] = (newest[source] + 1) % window;
+    kernels.temporal_median(data, len, &history[source * window * kLen],
+                            &filtered[source * kLen], window, newest[source],
+                            config.reset_distance);
+  }
+
+  // the summary gathered while decoding describes the unfiltered values
+  profile.RebuildSummary();
+}
+
+void TemporalFilter::ResetSource(int source)
+{
+  piece_id[source] = 0;
+  newest[source] = 0;
+
+  // the kernels start a column over when its state is the invalid value
+  if (!ema.empty()) {
+    std::fill(ema.begin() + source * kLen, ema.begin() + (source + 1) * kLen,
+              static_cast<float>(JS_PROFILE_DATA_INVALID_XY));
+  }
+  if (!filtered.empty()) {
+    std::fill(filtered.begin() + source * kLen,
+              filtered.begin() + (source + 1) * kLen,
+              static_cast<int32_t>(JS_PROFILE_DATA_INVALID_XY));
+  }
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_TEMPORAL_FILTER_H
+#define JOESCAN_TEMPORAL_FILTER_H
+
+#include <atomic>
+#include <vector>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Smooths the Y values of each camera column over successive profiles
+ * of the same camera and laser, with an exponential moving average or the
+ * median of the last few profiles. The state of every column is updated at
+ * once by the vectorized kernels; a source starts over whenever the piece of
+ * its profiles changes. Runs on the receiver thread as profiles are buffered,
+ * after presence detection has assigned their pieces.
+ */
+class TemporalFilter {
+ public:
+  TemporalFilter();
+
+  /**
+   * Enables filtering and clears the state; must not be called while
+   * scanning.
+   *
+   * @param config The filter and its settings.
+   */
+  void Enable(const jsTemporalFilterConfig &config);
+
+  /**
+   * Disables filtering and releases the state; must not be called while
+   * scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if filtering is enabled, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * Clears the state of all sources, to be called before scanning starts.
+   */
+  void Reset();
+
+  /**
+   * Filters the Y values of the next profile of its source in place and
+   * updates its summary to match.
+   *
+   * @param profile The profile to filter.
+   */
+  void Apply(Profile &profile);
+
+ private:
+  static const int kMaxSources = JS_CAMERA_MAX * JS_LASER_MAX;
+  static const uint32_t kLen = JS_PROFILE_DATA_LEN;
+
+  void ResetSource(int source);
+
+  std::atomic<bool> is_enabled;
+  jsTemporalFilterConfig config;
+  // the piece of the last profile of each source and the history row its
+  // values went to
+  uint64_t piece_id[kMaxSources];
+  uint32_t newest[kMaxSources];
+  // by source, then column
+  std::vector<float> ema;
+  std::vector<int32_t> filtered;
+  // by source, then history row, then column
+  std::vector<int32_t> history;
+};
+} // namespace joescan
+
+#endif // JOESCAN_TEMPORAL_FILTER_H
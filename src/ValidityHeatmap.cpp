@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "ValidityHeatmap.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace joescan;
+
+ValidityHeatmap::ValidityHeatmap()
+  : is_enabled(false),
+    num_x_bins(0),
+    num_y_bins(0)
+{
+  memset(&config, 0, sizeof(config));
+  Clear();
+}
+
+void ValidityHeatmap::Enable(const jsValidityHeatmapConfig &config)
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  this->config = config;
+  // the region is inclusive, a partial bin at its end is kept
+  int64_t w = static_cast<int64_t>(config.region.x_max) - config.region.x_min;
+  int64_t h = static_cast<int64_t>(config.region.y_max) - config.region.y_min;
+  num_x_bins = static_cast<uint32_t>(w / config.bin_size + 1);
+  num_y_bins = static_cast<uint32_t>(h / config.bin_size + 1);
+
+  column_valid.resize(JS_CAMERA_MAX * kMaxColumns);
+  bin_valid.resize(num_x_bins * num_y_bins);
+  Clear();
+  is_enabled = true;
+}
+
+void ValidityHeatmap::Disable()
+{
+  std::lock_guard<std::mutex> lk(lock);
+
+  is_enabled = false;
+  std::vector<uint64_t>().swap(column_valid);
+  std::vector<uint64_t>().swap(bin_valid);
+  num_x_bins = 0;
+  num_y_bins = 0;
+  Clear();
+}
+
+bool ValidityHeatmap::IsEnabled() const
+{
+  return is_enabled;
+}
+
+jsValidityHeatmapConfig ValidityHeatmap::GetConfig() const
+{
+  return config;
+}
+
+void ValidityHeatmap::Add(const Profile &profile)
+{
+  jsCamera camera = profile.GetCamera();
+  if (JS_CAMERA_MAX <= camera) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lk(lock);
+  const jsProfileData *data = profile.GetDataPointer();
+  uint32_t len = std::min(profile.GetDataLength(),
+                          static_cast<uint32_t>(kMaxColumns));
+  const jsRegion &region = config.region;
+  const int32_t bin_size = config.bin_size;
+  uint64_t *columns = &column_valid[camera * kMaxColumns];
+
+  // the data is indexed by camera column, so the column of a point is its
+  // index; data formats skipping columns leave those counts at zero
+  for (uint32_t n = 0; n < len; n++) {
+    int32_t x = data[n].x;
+    int32_t y = data[n].y;
+
+    if (JS_PROFILE_DATA_INVALID_XY == x) {
+      continue;
+    }
+
+    columns[n]++;
+
+    if ((x >= region.x_min) && (x <= region.x_max) && (y >= region.y_min) &&
+        (y <= region.y_max)) {
+      uint32_t i = static_cast<uint32_t>((static_cast<int64_t>(x) -
+                                          region.x_min) / bin_size);
+      uint32_t j = static_cast<uint32_t>((static_cast<int64_t>(y) -
+                                          region.y_min) / bin_size);
+      bin_valid[j * num_x_bins + i]++;
+    }
+  }
+
+  uint64_t timestamp = profile.GetTimestamp();
+  if ((0 == first_timestamp_ns) || (timestamp < first_timestamp_ns)) {
+    first_timestamp_ns = timestamp;
+  }
+  last_timestamp_ns = std::max(last_timestamp_ns, timestamp);
+  num_profiles[camera]++;
+}
+
+uint32_t ValidityHeatmap::Get(jsValidityHeatmap *heatmap, uint64_t *bins,
+                              uint32_t max_bins, bool reset)
+{
+  std::lock_guard<std::mutex> lk(lock);
+  uint32_t n = std::min(max_bins, static_cast<uint32_t>(bin_valid.size()));
+
+  heatmap->first_timestamp_ns = first_timestamp_ns;
+  heatmap->last_timestamp_ns = last_timestamp_ns;
+  heatmap->num_x_bins = num_x_bins;
+  heatmap->num_y_bins = num_y_bins;
+  memset(heatmap->column_valid, 0, sizeof(heatmap->column_valid));
+  for (int c = 0; c < JS_CAMERA_MAX; c++) {
+    heatmap->num_profiles[c] = num_profiles[c];
+    if (!column_valid.empty()) {
+      std::copy(column_valid.begin() + c * kMaxColumns,
+                column_valid.begin() + (c + 1) * kMaxColumns,
+                heatmap->column_valid[c]);
+    }
+  }
+  std::copy(bin_valid.begin(), bin_valid.begin() + n, bins);
+
+  if (reset) {
+    Clear();
+  }
+
+  return n;
+}
+
+void ValidityHeatmap::Clear()
+{
+  first_timestamp_ns = 0;
+  last_timestamp_ns = 0;
+  std::fill(num_profiles, num_profiles + JS_CAMERA_MAX, 0);
+  std::fill(column_valid.begin(), column_valid.end(), 0);
+  std::fill(bin_valid.begin(), bin_valid.end(), 0);
+}
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_VALIDITY_HEATMAP_H
+#define JOESCAN_VALIDITY_HEATMAP_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Profile.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * @brief Counts the valid X/Y points of a scan head by camera column and by
+ * bin of the mill coordinate system, to show which parts of the windows and
+ * of the mill see anything over a long run. Each profile costs one pass over
+ * its data on the receiver thread and the counts are not cleared when
+ * scanning starts, so they can span many scans.
+ */
+class ValidityHeatmap {
+ public:
+  ValidityHeatmap();
+
+  /**
+   * Enables counting and clears the counts; must not be called while
+   * scanning.
+   *
+   * @param config The bins of the mill coordinate system.
+   */
+  void Enable(const jsValidityHeatmapConfig &config);
+
+  /**
+   * Disables counting and releases the counts; must not be called while
+   * scanning.
+   */
+  void Disable();
+
+  /**
+   * @return Boolean `true` if valid points are counted, `false` otherwise.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * @return The bins of the mill coordinate system.
+   */
+  jsValidityHeatmapConfig GetConfig() const;
+
+  /**
+   * Counts the valid points of a profile.
+   *
+   * @param profile The profile to count.
+   */
+  void Add(const Profile &profile);
+
+  /**
+   * Copies the counts, optionally clearing them in the same step so no
+   * profile is missed between snapshots.
+   *
+   * @param heatmap Updated with the counts by camera column.
+   * @param bins Array updated with the counts by bin.
+   * @param max_bins The maximum number of entries of `bins` to update.
+   * @param reset Set to `true` to clear the counts after copying them.
+   * @return The number of entries of `bins` updated.
+   */
+  uint32_t Get(jsValidityHeatmap *heatmap, uint64_t *bins, uint32_t max_bins,
+               bool reset);
+
+ private:
+  static const int kMaxColumns = JS_CAMERA_IMAGE_DATA_MAX_WIDTH;
+
+  void Clear();
+
+  std::atomic<bool> is_enabled;
+  jsValidityHeatmapConfig config;
+  uint32_t num_x_bins;
+  uint32_t num_y_bins;
+
+  std::mutex lock;
+  uint64_t first_timestamp_ns;
+  uint64_t last_timestamp_ns;
+  uint64_t num_profiles[JS_CAMERA_MAX];
+  // counts by camera, then column
+  std::vector<uint64_t> column_valid;
+  // counts by bin row, then bin column
+  std::vector<uint64_t> bin_valid;
+};
+} // namespace joescan
+
+#endif // JOESCAN_VALIDITY_HEATMAP_H
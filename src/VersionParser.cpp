@@ -6,7 +6,6 @@
  */
 
 #include "VersionParser.hpp"
-#include "TcpSerializationHelpers.hpp"
 
 #include <sstream>
 
@@ -41,26 +40,15 @@ bool VersionParser::AreVersionsCompatible(const VersionInformation &v1,
 void VersionParser::Serialize(std::vector<uint8_t> &message,
                               const VersionInformation &vi)
 {
-  SerializeIntegralToBytes(message, &vi.major);
-  SerializeIntegralToBytes(message, &vi.minor);
-  SerializeIntegralToBytes(message, &vi.patch);
-  SerializeIntegralToBytes(message, &vi.commit);
-  SerializeIntegralToBytes(message, &vi.hwid);
-  SerializeIntegralToBytes(message, &vi.flags);
+  size_t n = message.size();
+
+  message.resize(n + VersionInformationSchema::kSize);
+  VersionInformationSchema::Write(vi, message.data() + n);
 }
 
 int VersionParser::Deserialize(VersionInformation &vi, uint8_t *data)
 {
-  uint8_t *idx_p = data;
-
-  idx_p += ExtractFromNetworkBuffer(vi.major, idx_p);
-  idx_p += ExtractFromNetworkBuffer(vi.minor, idx_p);
-  idx_p += ExtractFromNetworkBuffer(vi.patch, idx_p);
-  idx_p += ExtractFromNetworkBuffer(vi.commit, idx_p);
-  idx_p += ExtractFromNetworkBuffer(vi.hwid, idx_p);
-  idx_p += ExtractFromNetworkBuffer(vi.flags, idx_p);
-
-  int bytes_deserialized = static_cast<int>(idx_p - data);
+  VersionInformationSchema::Read(vi, data);
 
-  return bytes_deserialized;
+  return static_cast<int>(VersionInformationSchema::kSize);
 }
@@ -8,12 +8,21 @@
 #ifndef JOESCAN_VERSION_PARSER_H
 #define JOESCAN_VERSION_PARSER_H
 
+#include "MessageSchema.hpp"
 #include "VersionInformation.hpp"
 
 #include <string>
 #include <vector>
 
 namespace joescan {
+/// The layout of the version information sent by the scan head.
+typedef MessageSchema<SCHEMA_FIELD(VersionInformation, major),
+                      SCHEMA_FIELD(VersionInformation, minor),
+                      SCHEMA_FIELD(VersionInformation, patch),
+                      SCHEMA_FIELD(VersionInformation, commit),
+                      SCHEMA_FIELD(VersionInformation, hwid),
+                      SCHEMA_FIELD(VersionInformation, flags)>
+  VersionInformationSchema;
 
 class VersionParser {
  public:
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#include "WindowOptimizer.hpp"
+#include "DataFormats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace joescan;
+
+/**
+ * Finds the narrowest range of an array of counts that drops at most
+ * `allowed` counts off of each end, returning `false` if all counts are zero.
+ */
+static bool _trim(const uint64_t *counts, uint32_t len, uint64_t allowed,
+                  uint32_t *first, uint32_t *last)
+{
+  uint64_t dropped = 0;
+  uint32_t lo = 0;
+  uint32_t hi = len;
+
+  while ((lo < len) && (dropped + counts[lo] <= allowed)) {
+    dropped += counts[lo++];
+  }
+
+  if (lo == len) {
+    return false;
+  }
+
+  dropped = 0;
+  while ((hi - 1 > lo) && (dropped + counts[hi - 1] <= allowed)) {
+    dropped += counts[--hi];
+  }
+
+  *first = lo;
+  *last = hi - 1;
+  return true;
+}
+
+bool joescan::ProposeWindow(const jsValidityHeatmapConfig &heatmap_config,
+                            const jsValidityHeatmap &heatmap,
+                            const uint64_t *bins,
+                            const jsWindowProposalConfig &config,
+                            jsWindowProposal *proposal)
+{
+  const uint32_t nx = heatmap.num_x_bins;
+  const uint32_t ny = heatmap.num_y_bins;
+  std::vector<uint64_t> x_counts(nx, 0);
+  std::vector<uint64_t> y_counts(ny, 0);
+  uint64_t total = 0;
+
+  for (uint32_t j = 0; j < ny; j++) {
+    for (uint32_t i = 0; i < nx; i++) {
+      uint64_t n = bins[j * nx + i];
+      x_counts[i] += n;
+      y_counts[j] += n;
+      total += n;
+    }
+  }
+
+  // the four sides share what may fall outside of the window
+  uint64_t allowed =
+    static_cast<uint64_t>(std::floor(total * (1.0 - config.coverage) / 4.0));
+  uint32_t i0 = 0;
+  uint32_t i1 = 0;
+  uint32_t j0 = 0;
+  uint32_t j1 = 0;
+
+  if (!_trim(x_counts.data(), nx, allowed, &i0, &i1) ||
+      !_trim(y_counts.data(), ny, allowed, &j0, &j1)) {
+    return false;
+  }
+
+  uint64_t inside = 0;
+  for (uint32_t j = j0; j <= j1; j++) {
+    for (uint32_t i = i0; i <= i1; i++) {
+      inside += bins[j * nx + i];
+    }
+  }
+
+  const jsRegion &region = heatmap_config.region;
+  const double bin = static_cast<double>(heatmap_config.bin_size);
+  proposal->window_left = ((region.x_min + i0 * bin) / 1000.0) -
+                          config.margin_inches;
+  proposal->window_right = ((region.x_min + (i1 + 1) * bin) / 1000.0) +
+                           config.margin_inches;
+  proposal->window_bottom = ((region.y_min + j0 * bin) / 1000.0) -
+                            config.margin_inches;
+  proposal->window_top = ((region.y_min + (j1 + 1) * bin) / 1000.0) +
+                         config.margin_inches;
+  proposal->coverage = static_cast<double>(inside) / total;
+
+  const uint32_t kMaxColumns = JS_CAMERA_IMAGE_DATA_MAX_WIDTH;
+  for (int c = 0; c < JS_CAMERA_MAX; c++) {
+    const uint64_t *columns = heatmap.column_valid[c];
+    uint64_t sum = 0;
+    for (uint32_t n = 0; n < kMaxColumns; n++) {
+      sum += columns[n];
+    }
+
+    uint64_t drop =
+      static_cast<uint64_t>(std::floor(sum * (1.0 - config.coverage) / 2.0));
+    uint32_t first = 0;
+    uint32_t last = kMaxColumns - 1;
+    if (_trim(columns, kMaxColumns, drop, &first, &last)) {
+      first = (first > config.margin_columns) ? first - config.margin_columns
+                                              : 0;
+      last = std::min(last + config.margin_columns, kMaxColumns - 1);
+    }
+    proposal->column_start[c] = first;
+    proposal->column_end[c] = last;
+  }
+
+  return true;
+}
+
+double joescan::EstimateScanRate(const ScanWindow &current, double max_rate_hz,
+                                 double limit_hz,
+                                 const jsWindowProposal &proposal)
+{
+  int64_t y_min = INT64_MAX;
+  int64_t y_max = INT64_MIN;
+
+  for (auto const &c : current.Constraints()) {
+    for (int n = 0; n < 2; n++) {
+      y_min = std::min(y_min, c.constraints[n].y);
+      y_max = std::max(y_max, c.constraints[n].y);
+    }
+  }
+
+  double height = (proposal.window_top - proposal.window_bottom) * 1000.0;
+  if ((0.0 >= max_rate_hz) || (y_max <= y_min) || (0.0 >= height)) {
+    return 0.0;
+  }
+
+  double rate_hz = max_rate_hz * static_cast<double>(y_max - y_min) / height;
+  return std::min(rate_hz, limit_hz);
+}
+
+double joescan::EstimateBandwidth(jsDataFormat format, double rate_hz,
+                                  const jsWindowProposal &proposal)
+{
+  DataType mask = DataFormats::GetDataType(format);
+  std::vector<uint16_t> steps = DataFormats::GetStep(format);
+  double bytes_per_column = 0.0;
+  uint32_t n = 0;
+
+  // the steps are listed in order of the data type bits
+  for (uint16_t bit = 1; (0 != bit) && (n < steps.size()); bit <<= 1) {
+    if (mask & bit) {
+      DataType type = static_cast<DataType>(bit);
+      bytes_per_column += static_cast<double>(GetSizeFor(type)) / steps[n++];
+    }
+  }
+
+  double bytes = 0.0;
+  for (int c = 0; c < JS_CAMERA_MAX; c++) {
+    uint32_t columns = proposal.column_end[c] - proposal.column_start[c] + 1;
+    bytes += columns * bytes_per_column;
+  }
+
+  return bytes * rate_hz;
+}
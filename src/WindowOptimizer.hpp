@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) JoeScan Inc. All Rights Reserved.
+ *
+ * Licensed under the BSD 3 Clause License. See LICENSE.txt in the project
+ * root for license information.
+ */
+
+#ifndef JOESCAN_WINDOW_OPTIMIZER_H
+#define JOESCAN_WINDOW_OPTIMIZER_H
+
+#include <cstdint>
+
+#include "ScanWindow.hpp"
+#include "joescan_pinchot.h"
+
+namespace joescan {
+/**
+ * Proposes the smallest rectangular window and column ranges covering the
+ * valid points of a validity heatmap. The window is trimmed on each side
+ * independently, dropping at most a quarter of the points allowed outside of
+ * it from each, so the coverage of the window is never less than requested.
+ *
+ * @param heatmap_config The bins of the heatmap.
+ * @param heatmap The counts by camera column.
+ * @param bins The counts by bin, by row of Y then column of X.
+ * @param config The coverage and margins of the proposal.
+ * @param proposal Updated with the window, column ranges and coverage.
+ * @return Boolean `true` if a window was proposed, `false` if no points in
+ * the region were counted.
+ */
+bool ProposeWindow(const jsValidityHeatmapConfig &heatmap_config,
+                   const jsValidityHeatmap &heatmap, const uint64_t *bins,
+                   const jsWindowProposalConfig &config,
+                   jsWindowProposal *proposal);
+
+/**
+ * Estimates the maximum scan rate with a proposed window. The rows a camera
+ * reads out grow with the height of the window, so the rate the scan head
+ * reports for its current window is scaled by the ratio of the heights.
+ *
+ * @param current The window the scan head reported its rate for.
+ * @param max_rate_hz The maximum scan rate reported by the scan head.
+ * @param limit_hz The maximum scan rate allowed regardless of window.
+ * @param proposal The proposed window.
+ * @return The estimated maximum scan rate, `0` if none was reported.
+ */
+double EstimateScanRate(const ScanWindow &current, double max_rate_hz,
+                        double limit_hz, const jsWindowProposal &proposal);
+
+/**
+ * Estimates the profile data sent per second if only the proposed column
+ * ranges were sent, excluding packet headers.
+ *
+ * @param format The data format of the profiles.
+ * @param rate_hz The scan rate.
+ * @param proposal The proposed column ranges.
+ * @return The estimated bytes per second.
+ */
+double EstimateBandwidth(jsDataFormat format, double rate_hz,
+                         const jsWindowProposal &proposal);
+} // namespace joescan
+
+#endif // JOESCAN_WINDOW_OPTIMIZER_H
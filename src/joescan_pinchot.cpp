@@ -6,16 +6,25 @@
  */
 
 #include "joescan_pinchot.h"
+#include "ClockModel.hpp"
+#include "CrossSection.hpp"
+#include "LineFitting.hpp"
+#include "MissingColumns.hpp"
 #include "NetworkInterface.hpp"
 #include "PinchotConstants.hpp"
 #include "ScanHead.hpp"
+#include "ReductionKernels.hpp"
 #include "ScanManager.hpp"
+#include "SimdKernels.hpp"
 #include "VersionCompatibilityException.hpp"
+#include "WindowOptimizer.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <string>
 
 // TODO: This should probably be placed in a header?
@@ -32,6 +41,23 @@
 
 using namespace joescan;
 
+// `summary` and `piece_id` took the place of reserved fields, the layout of
+// the structs presented to the end user must not change
+static_assert(sizeof(jsProfileSummary) == 5 * sizeof(uint64_t),
+              "jsProfileSummary size changed");
+static_assert(offsetof(jsProfile, piece_id) ==
+                offsetof(jsProfile, summary) + sizeof(jsProfileSummary),
+              "jsProfile layout changed");
+static_assert(offsetof(jsRawProfile, piece_id) ==
+                offsetof(jsRawProfile, summary) + sizeof(jsProfileSummary),
+              "jsRawProfile layout changed");
+static_assert(offsetof(jsProfile, data) ==
+                offsetof(jsProfile, piece_id) + sizeof(uint64_t),
+              "jsProfile layout changed");
+static_assert(offsetof(jsRawProfile, data) ==
+                offsetof(jsRawProfile, piece_id) + sizeof(uint64_t),
+              "jsRawProfile layout changed");
+
 static int _network_init_count = 0;
 
 static unsigned int _data_format_to_stride(jsDataFormat fmt)
@@ -52,6 +78,8 @@ static unsigned int _data_format_to_stride(jsDataFormat fmt)
       stride = 4;
       break;
     case JS_DATA_FORMAT_CAMERA_IMAGE_FULL:
+    case JS_DATA_FORMAT_SUBPIXEL_FULL_LM_FULL:
+    case JS_DATA_FORMAT_SUBPIXEL_FULL:
       stride = 1;
       break;
   }
@@ -59,6 +87,378 @@ static unsigned int _data_format_to_stride(jsDataFormat fmt)
   return stride;
 }
 
+static bool _data_format_has_brightness(jsDataFormat fmt)
+{
+  return (JS_DATA_FORMAT_XY_FULL_LM_FULL == fmt) ||
+         (JS_DATA_FORMAT_XY_HALF_LM_HALF == fmt) ||
+         (JS_DATA_FORMAT_XY_QUARTER_LM_QUARTER == fmt) ||
+         (JS_DATA_FORMAT_SUBPIXEL_FULL_LM_FULL == fmt);
+}
+
+static bool _data_format_is_subpixel(jsDataFormat fmt)
+{
+  return (JS_DATA_FORMAT_SUBPIXEL_FULL_LM_FULL == fmt) ||
+         (JS_DATA_FORMAT_SUBPIXEL_FULL == fmt);
+}
+
+/*
+ * Helpers for the profile reduction functions. The reduction kernels operate
+ * on arrays of valid points only; `jsProfile` data already is, `jsRawProfile`
+ * data is compacted into a scratch buffer first.
+ */
+
+static const jsProfileData *_profile_points(const jsProfile &profile,
+                                            jsProfileData *scratch,
+                                            uint32_t *len)
+{
+  (void)scratch;
+  *len = std::min(profile.data_len, static_cast<uint32_t>(JS_PROFILE_DATA_LEN));
+  return profile.data;
+}
+
+static const jsProfileData *_profile_points(const jsRawProfile &profile,
+                                            jsProfileData *scratch,
+                                            uint32_t *len)
+{
+  uint32_t data_len =
+    std::min(profile.data_len, static_cast<uint32_t>(JS_RAW_PROFILE_DATA_LEN));
+  *len = GetSimdKernels().copy_valid(profile.data, data_len, 1, scratch);
+  return scratch;
+}
+
+static int32_t _check_region(const jsRegion *region)
+{
+  if (nullptr == region) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((region->x_min > region->x_max) ||
+             (region->y_min > region->y_max)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  return 0;
+}
+
+template <typename T>
+static int32_t _profiles_get_extreme(const T *profiles, uint32_t num_profiles,
+                                     const jsRegion *region,
+                                     jsProfileData *points, bool highest)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == points)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      uint32_t n = kernels.find_extreme(data, len, *region, highest);
+
+      if (n < len) {
+        points[m] = data[n];
+      } else {
+        points[m].x = JS_PROFILE_DATA_INVALID_XY;
+        points[m].y = JS_PROFILE_DATA_INVALID_XY;
+        points[m].brightness = JS_PROFILE_DATA_INVALID_BRIGHTNESS;
+      }
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+template <typename T>
+static int32_t _profiles_get_point_count(const T *profiles,
+                                         uint32_t num_profiles,
+                                         const jsRegion *region,
+                                         uint32_t *counts)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == counts)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      counts[m] = kernels.count(data, len, *region);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+template <typename T>
+static int32_t _profiles_get_centroid(const T *profiles, uint32_t num_profiles,
+                                      const jsRegion *region,
+                                      double *centroid_x, double *centroid_y)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == centroid_x) ||
+             (nullptr == centroid_y)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      bool weighted = _data_format_has_brightness(profiles[m].format);
+      int64_t sums[3] = {0, 0, 0};
+
+      kernels.sum_weighted(data, len, *region, weighted, sums);
+      if (0 < sums[2]) {
+        centroid_x[m] = static_cast<double>(sums[0]) / sums[2];
+        centroid_y[m] = static_cast<double>(sums[1]) / sums[2];
+      } else {
+        centroid_x[m] = std::numeric_limits<double>::quiet_NaN();
+        centroid_y[m] = std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+template <typename T>
+static int32_t _profiles_get_area(const T *profiles, uint32_t num_profiles,
+                                  const jsRegion *region, double slope,
+                                  double intercept, double *areas)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == areas)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(slope) || INVALID_DOUBLE(intercept)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      areas[m] = kernels.area(data, len, *region, slope, intercept);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+/**
+ * Copies the points within a region to another array, which may be the same
+ * as the source array.
+ */
+static uint32_t _points_in_region(const jsProfileData *data, uint32_t len,
+                                  const jsRegion &region, jsProfileData *dst)
+{
+  uint32_t count = 0;
+
+  for (uint32_t n = 0; n < len; n++) {
+    if ((data[n].x >= region.x_min) && (data[n].x <= region.x_max) &&
+        (data[n].y >= region.y_min) && (data[n].y <= region.y_max)) {
+      dst[count++] = data[n];
+    }
+  }
+
+  return count;
+}
+
+template <typename T>
+static int32_t _profiles_fit_line(const T *profiles, uint32_t num_profiles,
+                                  const jsRegion *region, jsLineSegment *lines)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == lines)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      FitLine(kernels, data, len, *region, &lines[m]);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+template <typename T>
+static int32_t _profiles_fit_segments(const T *profiles, uint32_t num_profiles,
+                                      const jsRegion *region, double tolerance,
+                                      jsLineSegment *segments,
+                                      uint32_t max_segments,
+                                      uint32_t *num_segments)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == segments) ||
+             (nullptr == num_segments)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(tolerance) || (0.0 > tolerance) ||
+             (0 == max_segments)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      len = _points_in_region(data, len, *region, scratch.data());
+      num_segments[m] =
+        FitSegments(kernels, scratch.data(), len, tolerance,
+                    &segments[static_cast<size_t>(m) * max_segments],
+                    max_segments);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+template <typename T>
+static int32_t _profiles_find_line(const T *profiles, uint32_t num_profiles,
+                                   const jsRegion *region, double tolerance,
+                                   uint32_t iterations, jsLineSegment *lines)
+{
+  int32_t r = _check_region(region);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == lines)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(tolerance) || (0.0 > tolerance) ||
+             (0 == iterations)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      len = _points_in_region(data, len, *region, scratch.data());
+      FindLine(kernels, scratch.data(), len, tolerance, iterations, &lines[m]);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+static int32_t _check_resample_config(const jsResampleConfig *config)
+{
+  if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((0 >= config->x_step) || (0 == config->num_points) ||
+             (JS_PROFILE_DATA_LEN < config->num_points) ||
+             (0 > config->max_gap)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  int64_t x_end = static_cast<int64_t>(config->x_start) +
+                  static_cast<int64_t>(config->num_points - 1) * config->x_step;
+  if (std::numeric_limits<int32_t>::max() < x_end) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  return 0;
+}
+
+template <typename T>
+static int32_t _profiles_resample(const T *profiles, uint32_t num_profiles,
+                                  const jsResampleConfig *config,
+                                  jsProfileData *points)
+{
+  int32_t r = _check_resample_config(config);
+
+  if (0 != r) {
+    return r;
+  } else if ((nullptr == profiles) || (nullptr == points)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    const ReductionKernels &kernels = GetReductionKernels();
+    std::vector<jsProfileData> scratch(JS_RAW_PROFILE_DATA_LEN);
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = 0;
+      const jsProfileData *data =
+        _profile_points(profiles[m], scratch.data(), &len);
+      kernels.resample(data, len, *config, &points[m * config->num_points]);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
 EXPORTED
 void jsGetAPIVersion(const char **version_str)
 {
@@ -79,6 +479,25 @@ void jsGetAPISemanticVersion(uint32_t *major, uint32_t *minor, uint32_t *patch)
   }
 }
 
+EXPORTED
+void jsGetSimdVariant(jsSimdVariant *variant, const char **variant_str)
+{
+  const SimdKernels &kernels = GetSimdKernels();
+
+  if (nullptr != variant) {
+    *variant = kernels.variant;
+  }
+  if (nullptr != variant_str) {
+    *variant_str = kernels.name;
+  }
+}
+
+EXPORTED
+uint64_t jsGetHostTime(void)
+{
+  return GetHostTimeNs();
+}
+
 EXPORTED
 void jsGetError(int32_t return_code, const char **error_str)
 {
@@ -167,6 +586,9 @@ jsScanSystem jsScanSystemCreate(void)
       _network_init_count++;
     }
 
+    // select the decode kernels up front rather than on the first packet
+    GetSimdKernels();
+
     ScanManager *manager = new ScanManager();
     scan_system = static_cast<jsScanSystem>(manager);
   } catch (std::exception &e) {
@@ -518,11 +940,23 @@ int32_t jsScanSystemStartScanning(jsScanSystem scan_system, double rate_hz,
 
   try {
     double rate_hz_max = manager->GetMaxScanRate();
+    uint32_t num_sources = manager->GetNumberScanners() * JS50WX_NUM_CAMERAS;
     if (rate_hz > rate_hz_max) {
       r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (manager->GetProfileStitcher().IsEnabled() &&
+               (JS_STITCHED_PROFILE_SOURCES_MAX < num_sources)) {
+      // too many sources to fit in a `jsStitchedProfile`
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (manager->GetProfileStitcher().IsEnabled() &&
+               !manager->HasUniformExposureMode()) {
+      // frames of one length can't hold the profiles of all scan heads
+      r = JS_ERROR_INVALID_ARGUMENT;
     } else if (JS_DATA_FORMAT_CAMERA_IMAGE_FULL == fmt) {
       // we don't support continuous scans of image data
       r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (_data_format_is_subpixel(fmt) && !manager->HasMappingTables()) {
+      // the geometry can not be computed without the mapping tables
+      r = JS_ERROR_INVALID_ARGUMENT;
     } else {
       manager->SetScanRate(rate_hz);
       manager->SetRequestedDataFormat(fmt);
@@ -559,79 +993,276 @@ int32_t jsScanSystemStopScanning(jsScanSystem scan_system)
 }
 
 EXPORTED
-bool jsScanSystemIsScanning(jsScanSystem scan_system)
+int32_t jsScanSystemStartBurst(jsScanSystem scan_system, double rate_hz,
+                               jsDataFormat fmt, uint32_t num_scans)
 {
-  bool is_scanning = false;
+  ScanManager *manager = static_cast<ScanManager *>(scan_system);
+  int32_t r = 0;
 
   if (nullptr == scan_system) {
-    return false;
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(rate_hz)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if ((0 == num_scans) || (0xFFFFFFFF == num_scans)) {
+    return JS_ERROR_INVALID_ARGUMENT;
   }
 
   try {
-    ScanManager *manager = static_cast<ScanManager *>(scan_system);
-    is_scanning = manager->IsScanning();
+    double rate_hz_max = manager->GetMaxScanRate();
+    uint32_t num_sources = manager->GetNumberScanners() * JS50WX_NUM_CAMERAS;
+    if (manager->IsScanning() && !manager->IsBurstComplete()) {
+      r = JS_ERROR_SCANNING;
+    } else if (!manager->IsScanning() && !manager->IsConnected()) {
+      r = JS_ERROR_NOT_CONNECTED;
+    } else if (rate_hz > rate_hz_max) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (manager->GetProfileStitcher().IsEnabled() &&
+               (JS_STITCHED_PROFILE_SOURCES_MAX < num_sources)) {
+      // too many sources to fit in a `jsStitchedProfile`
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (manager->GetProfileStitcher().IsEnabled() &&
+               !manager->HasUniformExposureMode()) {
+      // frames of one length can't hold the profiles of all scan heads
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (JS_DATA_FORMAT_CAMERA_IMAGE_FULL == fmt) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (_data_format_is_subpixel(fmt) && !manager->HasMappingTables()) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else {
+      manager->SetScanRate(rate_hz);
+      manager->SetRequestedDataFormat(fmt);
+      manager->StartBurst(num_scans);
+    }
   } catch (std::exception &e) {
     (void)e;
-    is_scanning = false;
+    r = JS_ERROR_INTERNAL;
   }
 
-  return is_scanning;
+  return r;
 }
 
 EXPORTED
-uint32_t jsScanHeadGetId(jsScanHead scan_head)
+int32_t jsScanSystemWaitUntilBurstComplete(jsScanSystem scan_system,
+                                           uint32_t timeout_us,
+                                           jsBurstStatus *status,
+                                           uint32_t max_status)
 {
-  uint32_t id = 0;
+  ScanManager *manager = static_cast<ScanManager *>(scan_system);
+  int32_t r = 0;
 
-  if (nullptr == scan_head) {
-    // make it super obvious that the ID is invalid
-    return 0xFFFFFFFF;
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((nullptr == status) && (0 != max_status)) {
+    return JS_ERROR_NULL_ARGUMENT;
   }
 
   try {
-    ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    id = sh->GetId();
+    std::vector<jsBurstStatus> s = manager->WaitUntilBurstComplete(timeout_us);
+    uint32_t n = std::min(max_status, static_cast<uint32_t>(s.size()));
+    std::copy(s.begin(), s.begin() + n, status);
+    for (auto const &b : s) {
+      if (b.is_complete) {
+        r++;
+      }
+    }
   } catch (std::exception &e) {
     (void)e;
-    id = 0xFFFFFFFF;
+    r = JS_ERROR_INTERNAL;
   }
 
-  return id;
+  return r;
 }
 
 EXPORTED
-uint32_t jsScanHeadGetSerial(jsScanHead scan_head)
+bool jsScanSystemIsScanning(jsScanSystem scan_system)
 {
-  uint32_t serial = 0;
+  bool is_scanning = false;
 
-  if (nullptr == scan_head) {
-    // make it super obvious that the serial is invalid
-    return 0xFFFFFFFF;
+  if (nullptr == scan_system) {
+    return false;
   }
 
   try {
-    ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    std::string serial_str = sh->GetSerialNumber();
-    int convert = std::stoi(serial_str);
-    if (convert < 0) {
-      throw std::runtime_error("invalid serial number");
-    }
-    serial = static_cast<uint32_t>(convert);
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    is_scanning = manager->IsScanning();
   } catch (std::exception &e) {
     (void)e;
-    serial = 0xFFFFFFFF;
+    is_scanning = false;
   }
 
-  return serial;
+  return is_scanning;
 }
 
 EXPORTED
-int32_t jsScanHeadConfigure(jsScanHead scan_head,
-                            jsScanHeadConfiguration *config)
+int32_t jsScanSystemEnableStitching(jsScanSystem scan_system,
+                                    jsStitchOverlapRule rule)
 {
   int32_t r = 0;
 
-  if (nullptr == scan_head) {
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_STITCH_OVERLAP_KEEP_ALL != rule) &&
+             (JS_STITCH_OVERLAP_MIDPOINT != rule) &&
+             (JS_STITCH_OVERLAP_PRIORITY != rule)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if (jsScanSystemIsScanning(scan_system)) {
+    return JS_ERROR_SCANNING;
+  }
+
+  try {
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    manager->GetProfileStitcher().Enable(rule);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanSystemDisableStitching(jsScanSystem scan_system)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (jsScanSystemIsScanning(scan_system)) {
+    return JS_ERROR_SCANNING;
+  }
+
+  try {
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    manager->GetProfileStitcher().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanSystemGetStitchedProfilesAvailable(jsScanSystem scan_system)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    uint32_t count = manager->GetProfileStitcher().AvailableProfiles();
+    r = static_cast<int32_t>(count);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanSystemGetStitchedProfiles(jsScanSystem scan_system,
+                                        jsStitchedProfile *profiles,
+                                        uint32_t max_profiles)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profiles) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    auto p = manager->GetProfileStitcher().PopProfiles(max_profiles);
+    uint32_t total = static_cast<uint32_t>(p.size());
+
+    for (uint32_t m = 0; m < total; m++) {
+      profiles[m].timestamp_ns = p[m]->timestamp_ns;
+
+      memset(profiles[m].encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
+      std::vector<int64_t> &e = p[m]->encoder_values;
+      std::copy(e.begin(), e.end(), profiles[m].encoder_values);
+      profiles[m].num_encoder_values = static_cast<uint32_t>(e.size());
+      assert(profiles[m].num_encoder_values < JS_ENCODER_MAX);
+
+      profiles[m].num_sources = static_cast<uint32_t>(p[m]->sources.size());
+      profiles[m].num_sources_received = p[m]->num_sources_received;
+      std::copy(p[m]->sources.begin(), p[m]->sources.end(),
+                profiles[m].sources);
+
+      profiles[m].data_len = static_cast<uint32_t>(p[m]->data.size());
+      memcpy(profiles[m].data, p[m]->data.data(),
+             sizeof(jsStitchedProfileData) * profiles[m].data_len);
+    }
+    // return number of profiles copied
+    r = static_cast<int32_t>(total);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+uint32_t jsScanHeadGetId(jsScanHead scan_head)
+{
+  uint32_t id = 0;
+
+  if (nullptr == scan_head) {
+    // make it super obvious that the ID is invalid
+    return 0xFFFFFFFF;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    id = sh->GetId();
+  } catch (std::exception &e) {
+    (void)e;
+    id = 0xFFFFFFFF;
+  }
+
+  return id;
+}
+
+EXPORTED
+uint32_t jsScanHeadGetSerial(jsScanHead scan_head)
+{
+  uint32_t serial = 0;
+
+  if (nullptr == scan_head) {
+    // make it super obvious that the serial is invalid
+    return 0xFFFFFFFF;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    std::string serial_str = sh->GetSerialNumber();
+    int convert = std::stoi(serial_str);
+    if (convert < 0) {
+      throw std::runtime_error("invalid serial number");
+    }
+    serial = static_cast<uint32_t>(convert);
+  } catch (std::exception &e) {
+    (void)e;
+    serial = 0xFFFFFFFF;
+  }
+
+  return serial;
+}
+
+EXPORTED
+int32_t jsScanHeadConfigure(jsScanHead scan_head,
+                            jsScanHeadConfiguration *config)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
     return JS_ERROR_NULL_ARGUMENT;
   } else if (nullptr == config) {
     return JS_ERROR_NULL_ARGUMENT;
@@ -769,33 +1400,1315 @@ int32_t jsScanHeadSetWindowRectangular(jsScanHead scan_head, double window_top,
 }
 
 EXPORTED
-bool jsScanHeadIsConnected(jsScanHead scan_head)
+int32_t jsScanHeadSetCameraExposureMode(jsScanHead scan_head,
+                                        jsCameraExposureMode mode)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_CAMERA_EXPOSURE_MODE_INTERLEAVED != mode) &&
+             (JS_CAMERA_EXPOSURE_MODE_SIMULTANEOUS != mode)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->SetCameraExposureMode(mode);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetCameraExposureMode(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    r = static_cast<int32_t>(sh->GetCameraExposureMode());
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+bool jsScanHeadIsConnected(jsScanHead scan_head)
+{
+  bool is_connected = false;
+
+  if (nullptr == scan_head) {
+    return false;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &mgr = sh->GetScanManager();
+
+    StatusMessage message = sh->GetStatusMessage();
+    auto timestamp = message.GetGlobalTime();
+    if ((mgr.IsConnected()) && (0 != timestamp)) {
+      is_connected = true;
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    is_connected = false;
+  }
+
+  return is_connected;
+}
+
+EXPORTED
+int32_t jsScanHeadGetProfilesAvailable(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    uint32_t count = sh->AvailableProfiles();
+    r = static_cast<int32_t>(count);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadWaitUntilProfilesAvailable(jsScanHead scan_head,
+                                             uint32_t count,
+                                             uint32_t timeout_us)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (JS_SCAN_HEAD_PROFILES_MAX < count) {
+    count = JS_SCAN_HEAD_PROFILES_MAX;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    r = sh->WaitUntilAvailableProfiles(count, timeout_us);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+/**
+ * Copies a profile to the raw profile presented to the end user.
+ */
+static void _copy_profile(Profile &src, jsDataFormat format,
+                          jsRawProfile *dst)
+{
+  src.CopyTo(dst);
+  dst->format = format;
+}
+
+/**
+ * Copies the fields describing a profile, other than its data, to one of the
+ * profile types presented to the end user.
+ */
+template <typename T>
+static void _copy_profile_header(Profile &src, jsDataFormat format, T *dst)
+{
+  dst->scan_head_id = src.GetScanHeadId();
+  dst->camera = src.GetCamera();
+  dst->laser = src.GetLaser();
+  dst->timestamp_ns = src.GetTimestamp();
+  dst->laser_on_time_us = src.GetLaserOnTime();
+  dst->format = format;
+
+  std::pair<uint32_t, uint32_t> pkt_info = src.GetUDPPacketInfo();
+  dst->udp_packets_received = pkt_info.first;
+  dst->udp_packets_expected = pkt_info.second;
+
+  memset(dst->encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
+  std::vector<int64_t> e = src.GetEncoderValues();
+  std::copy(e.begin(), e.end(), dst->encoder_values);
+  dst->num_encoder_values = static_cast<uint32_t>(e.size());
+  assert(dst->num_encoder_values < JS_ENCODER_MAX);
+
+  dst->piece_id = src.GetPieceId();
+}
+
+/**
+ * Copies a profile to the profile presented to the end user, keeping only the
+ * valid points.
+ */
+static void _copy_profile(Profile &src, jsDataFormat format, jsProfile *dst)
+{
+  const SimdKernels &kernels = GetSimdKernels();
+
+  _copy_profile_header(src, format, dst);
+
+  unsigned int stride = _data_format_to_stride(format);
+  dst->data_len = kernels.copy_valid(src.GetDataPointer(), src.GetDataLength(),
+                                     stride, dst->data);
+  dst->summary = src.GetSummary();
+}
+
+/**
+ * Copies a profile to the float profile presented to the end user, keeping
+ * only the valid points.
+ */
+static void _copy_profile(Profile &src, jsDataFormat format,
+                          jsFloatProfile *dst)
+{
+  uint32_t count = 0;
+
+  _copy_profile_header(src, format, dst);
+
+  if (src.HasFloatData()) {
+    const jsProfileData *data = src.GetDataPointer();
+    const float *x = src.GetFloatXPointer();
+    const float *y = src.GetFloatYPointer();
+    uint32_t len = std::min(src.GetDataLength(),
+                            static_cast<uint32_t>(JS_PROFILE_DATA_LEN));
+    unsigned int stride = _data_format_to_stride(format);
+
+    for (uint32_t n = 0; n < len; n += stride) {
+      // the integer data is invalid wherever the float data is
+      if (JS_PROFILE_DATA_INVALID_XY != data[n].x) {
+        dst->data[count].x = x[n];
+        dst->data[count].y = y[n];
+        dst->data[count].brightness = data[n].brightness;
+        count++;
+      }
+    }
+  }
+
+  dst->data_len = count;
+}
+
+/**
+ * Copies a profile to the arrays of the float profile presented to the end
+ * user, keeping the layout of the profile data array.
+ */
+static void _copy_profile(Profile &src, jsDataFormat format,
+                          jsFloatProfileArrays *dst)
+{
+  uint32_t len = std::min(src.GetDataLength(),
+                          static_cast<uint32_t>(JS_RAW_PROFILE_DATA_LEN));
+
+  _copy_profile_header(src, format, dst);
+
+  if (src.HasFloatData()) {
+    memcpy(dst->x, src.GetFloatXPointer(), sizeof(float) * len);
+    memcpy(dst->y, src.GetFloatYPointer(), sizeof(float) * len);
+    dst->data_valid_xy = src.GetNumberValidGeometry();
+  } else {
+    std::fill(dst->x, dst->x + len, std::numeric_limits<float>::quiet_NaN());
+    std::fill(dst->y, dst->y + len, std::numeric_limits<float>::quiet_NaN());
+    dst->data_valid_xy = 0;
+  }
+
+  if (nullptr != dst->brightness) {
+    const jsProfileData *data = src.GetDataPointer();
+    for (uint32_t n = 0; n < len; n++) {
+      dst->brightness[n] = data[n].brightness;
+    }
+  }
+
+  dst->data_len = len;
+}
+
+/**
+ * Copies a raw profile to the profile presented to the end user, keeping only
+ * the valid points.
+ */
+static void _copy_profile(const jsRawProfile &src, jsProfile *dst)
+{
+  const SimdKernels &kernels = GetSimdKernels();
+
+  dst->scan_head_id = src.scan_head_id;
+  dst->camera = src.camera;
+  dst->laser = src.laser;
+  dst->timestamp_ns = src.timestamp_ns;
+  dst->laser_on_time_us = src.laser_on_time_us;
+  dst->format = src.format;
+  dst->udp_packets_received = src.udp_packets_received;
+  dst->udp_packets_expected = src.udp_packets_expected;
+  memcpy(dst->encoder_values, src.encoder_values,
+         sizeof(int64_t) * JS_ENCODER_MAX);
+  dst->num_encoder_values = src.num_encoder_values;
+
+  unsigned int stride = _data_format_to_stride(src.format);
+  dst->data_len = kernels.copy_valid(src.data, src.data_len, stride,
+                                     dst->data);
+  dst->summary = src.summary;
+  dst->piece_id = src.piece_id;
+}
+
+/**
+ * Reads profiles and, if `kinematics` or `missing` is not null, their encoder
+ * kinematics or missing columns; shared by the functions reading profiles and
+ * raw profiles. Profiles from
+ * all camera and laser pairs are read if `camera` is `JS_CAMERA_MAX`.
+ */
+template <typename T>
+static int32_t _scan_head_get_profiles(jsScanHead scan_head, jsCamera camera,
+                                       jsLaser laser, T *profiles,
+                                       jsEncoderKinematics *kinematics,
+                                       jsMissingColumns *missing,
+                                       uint32_t max_profiles)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profiles) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    jsDataFormat format = sh->GetDataFormat();
+    // TODO: FKS-219
+    // We should retool the internal C++ code to make this whole process less
+    // labor intensive. Ideally we could just do a straight memcpy.
+    auto p = (JS_CAMERA_MAX == camera)
+               ? sh->GetProfiles(static_cast<int>(max_profiles))
+               : sh->GetProfiles(camera, laser, static_cast<int>(max_profiles));
+    uint32_t total = (max_profiles < static_cast<uint32_t>(p.size()))
+                       ? max_profiles
+                       : static_cast<uint32_t>(p.size());
+
+    for (uint32_t m = 0; m < total; m++) {
+      _copy_profile(*p[m], format, &profiles[m]);
+
+      if (nullptr != kinematics) {
+        kinematics[m] = p[m]->GetKinematics();
+      }
+
+      if (nullptr != missing) {
+        p[m]->GetMissingColumns(&missing[m]);
+      }
+    }
+    // return number of profiles copied
+    r = static_cast<int32_t>(total);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+/**
+ * Reads retained profiles within a range of time or of encoder values;
+ * shared by the functions reading the profile history.
+ */
+template <typename T>
+static int32_t _scan_head_get_history(jsScanHead scan_head, bool by_encoder,
+                                      jsEncoder encoder, int64_t min_value,
+                                      int64_t max_value, T *profiles,
+                                      uint32_t max_profiles)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profiles) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (by_encoder && ((0 > encoder) || (JS_ENCODER_MAX <= encoder))) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ProfileHistory &history = sh->GetScanHeadShared().GetProfileHistory();
+    jsDataFormat format = sh->GetDataFormat();
+    std::vector<std::shared_ptr<Profile>> p;
+
+    if (by_encoder) {
+      p = history.GetByEncoder(encoder, min_value, max_value, max_profiles);
+    } else {
+      p = history.GetByTime(static_cast<uint64_t>(min_value),
+                            static_cast<uint64_t>(max_value), max_profiles);
+    }
+
+    for (uint32_t m = 0; m < p.size(); m++) {
+      _copy_profile(*p[m], format, &profiles[m]);
+    }
+    r = static_cast<int32_t>(p.size());
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+/**
+ * Reads profiles from all scan heads merged in timestamp order; shared by the
+ * functions reading profiles and raw profiles from the scan system.
+ */
+template <typename T>
+static int32_t _scan_system_get_profiles(jsScanSystem scan_system,
+                                         T *profiles, uint32_t max_profiles)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profiles) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanManager *manager = static_cast<ScanManager *>(scan_system);
+    auto p = manager->GetProfiles(max_profiles);
+
+    for (uint32_t m = 0; m < p.size(); m++) {
+      ScanHead *sh = manager->GetScanner(p[m]->GetScanHeadId());
+      _copy_profile(*p[m], sh->GetDataFormat(), &profiles[m]);
+    }
+    r = static_cast<int32_t>(p.size());
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawProfiles(jsScanHead scan_head, jsRawProfile *profiles,
+                                 uint32_t max_profiles)
+{
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, nullptr, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetProfiles(jsScanHead scan_head, jsProfile *profiles,
+                              uint32_t max_profiles)
+{
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, nullptr, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetFloatProfiles(jsScanHead scan_head,
+                                   jsFloatProfile *profiles,
+                                   uint32_t max_profiles)
+{
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, nullptr, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetFloatProfileArrays(jsScanHead scan_head,
+                                        jsFloatProfileArrays *profiles,
+                                        uint32_t max_profiles)
+{
+  if (nullptr == profiles) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  // checked up front, profiles read out can not be put back
+  for (uint32_t m = 0; m < max_profiles; m++) {
+    if ((nullptr == profiles[m].x) || (nullptr == profiles[m].y)) {
+      return JS_ERROR_NULL_ARGUMENT;
+    }
+  }
+
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, nullptr, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetMappingTable(jsScanHead scan_head, jsCamera camera,
+                                  jsMappingTable *table, float *x, float *y,
+                                  uint32_t max_entries)
+{
+  int32_t r = 0;
+
+  if ((nullptr == scan_head) || (nullptr == table)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((0 < max_entries) && ((nullptr == x) || (nullptr == y))) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (JS_CAMERA_MAX <= camera) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    MappingTable &mapping = sh->GetScanHeadShared().GetMappingTable(camera);
+
+    *table = mapping.GetInfo();
+    r = static_cast<int32_t>(mapping.Get(x, y, max_entries));
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadSetMappingTable(jsScanHead scan_head, jsCamera camera,
+                                  const jsMappingTable *table, const float *x,
+                                  const float *y)
+{
+  int32_t r = 0;
+
+  if ((nullptr == scan_head) || (nullptr == table)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((nullptr == x) || (nullptr == y)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (JS_CAMERA_MAX <= camera) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if (!MappingTable::IsValid(*table)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetMappingTable(camera).Set(*table, x, y);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetSourceProfilesAvailable(jsScanHead scan_head,
+                                             jsCamera camera, jsLaser laser)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    uint32_t count = sh->AvailableProfiles(camera, laser);
+    r = static_cast<int32_t>(count);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadWaitUntilSourceProfilesAvailable(jsScanHead scan_head,
+                                                   jsCamera camera,
+                                                   jsLaser laser,
+                                                   uint32_t count,
+                                                   uint32_t timeout_us)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if (JS_SCAN_HEAD_PROFILES_MAX < count) {
+    count = JS_SCAN_HEAD_PROFILES_MAX;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    r = sh->WaitUntilAvailableProfiles(camera, laser, count, timeout_us);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetSourceProfiles(jsScanHead scan_head, jsCamera camera,
+                                    jsLaser laser, jsProfile *profiles,
+                                    uint32_t max_profiles)
+{
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  return _scan_head_get_profiles(scan_head, camera, laser, profiles, nullptr,
+                                 nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetSourceRawProfiles(jsScanHead scan_head, jsCamera camera,
+                                       jsLaser laser, jsRawProfile *profiles,
+                                       uint32_t max_profiles)
+{
+  if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  return _scan_head_get_profiles(scan_head, camera, laser, profiles, nullptr,
+                                 nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanSystemGetProfiles(jsScanSystem scan_system, jsProfile *profiles,
+                                uint32_t max_profiles)
+{
+  return _scan_system_get_profiles(scan_system, profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanSystemGetRawProfiles(jsScanSystem scan_system,
+                                   jsRawProfile *profiles,
+                                   uint32_t max_profiles)
+{
+  return _scan_system_get_profiles(scan_system, profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanSystemGetEventsAvailable(jsScanSystem scan_system)
+{
+  ScanManager *manager = static_cast<ScanManager *>(scan_system);
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    r = static_cast<int32_t>(manager->GetSystemEvents().Available());
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanSystemWaitUntilEventsAvailable(jsScanSystem scan_system,
+                                             uint32_t timeout_us)
+{
+  ScanManager *manager = static_cast<ScanManager *>(scan_system);
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    SystemEvents &events = manager->GetSystemEvents();
+    r = static_cast<int32_t>(events.WaitUntilAvailable(timeout_us));
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanSystemGetEvents(jsScanSystem scan_system, jsSystemEvent *events,
+                              uint32_t max_events)
+{
+  ScanManager *manager = static_cast<ScanManager *>(scan_system);
+  int32_t r = 0;
+
+  if (nullptr == scan_system) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == events) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    SystemEvents &system_events = manager->GetSystemEvents();
+    r = static_cast<int32_t>(system_events.Pop(events, max_events));
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadEnableEncoderKinematics(
+  jsScanHead scan_head, const jsEncoderKinematicsConfig *config)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(config->time_constant_s) ||
+             (0.0 > config->time_constant_s)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if ((2 > config->counter_bits) || (64 < config->counter_bits)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetEncoderKinematics().Enable(*config);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadDisableEncoderKinematics(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetEncoderKinematics().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetProfilesKinematics(jsScanHead scan_head,
+                                        jsProfile *profiles,
+                                        jsEncoderKinematics *kinematics,
+                                        uint32_t max_profiles)
+{
+  if (nullptr == kinematics) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, kinematics, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawProfilesKinematics(jsScanHead scan_head,
+                                           jsRawProfile *profiles,
+                                           jsEncoderKinematics *kinematics,
+                                           uint32_t max_profiles)
+{
+  if (nullptr == kinematics) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, kinematics, nullptr, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawProfilesMissingColumns(jsScanHead scan_head,
+                                               jsRawProfile *profiles,
+                                               jsMissingColumns *missing,
+                                               uint32_t max_profiles)
+{
+  if (nullptr == missing) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  return _scan_head_get_profiles(scan_head, JS_CAMERA_MAX, JS_LASER_MAX,
+                                 profiles, nullptr, missing, max_profiles);
+}
+
+EXPORTED
+int32_t jsRawProfileInterpolateMissingColumns(jsRawProfile *profile,
+                                              const jsMissingColumns *missing,
+                                              uint32_t max_gap)
+{
+  int32_t r = 0;
+
+  if (nullptr == profile) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == missing) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    uint32_t stride = _data_format_to_stride(profile->format);
+    if (0 == stride) {
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+
+    r = static_cast<int32_t>(
+      InterpolateMissingColumns(profile, *missing, stride, max_gap));
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadEnablePresenceDetection(jsScanHead scan_head,
+                                          const jsPresenceConfig *config)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((0 == config->start_count) || (0 == config->end_count)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if ((0 != config->min_region_points) &&
+             (0 != _check_region(&config->region))) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetPresenceDetector().Enable(*config);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadDisablePresenceDetection(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetPresenceDetector().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetPieceEvents(jsScanHead scan_head, jsPieceEvent *events,
+                                 uint32_t max_events)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == events) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    PresenceDetector &detector = sh->GetScanHeadShared().GetPresenceDetector();
+    r = static_cast<int32_t>(detector.PopEvents(events, max_events));
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadEnableHistory(jsScanHead scan_head,
+                                const jsHistoryConfig *config)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (0 == config->max_profiles) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetProfileHistory().Enable(*config);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadDisableHistory(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetProfileHistory().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetHistoryByTime(jsScanHead scan_head,
+                                   uint64_t min_timestamp_ns,
+                                   uint64_t max_timestamp_ns,
+                                   jsProfile *profiles, uint32_t max_profiles)
+{
+  return _scan_head_get_history(scan_head, false, JS_ENCODER_0,
+                                static_cast<int64_t>(min_timestamp_ns),
+                                static_cast<int64_t>(max_timestamp_ns),
+                                profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawHistoryByTime(jsScanHead scan_head,
+                                      uint64_t min_timestamp_ns,
+                                      uint64_t max_timestamp_ns,
+                                      jsRawProfile *profiles,
+                                      uint32_t max_profiles)
+{
+  return _scan_head_get_history(scan_head, false, JS_ENCODER_0,
+                                static_cast<int64_t>(min_timestamp_ns),
+                                static_cast<int64_t>(max_timestamp_ns),
+                                profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetHistoryByEncoder(jsScanHead scan_head, jsEncoder encoder,
+                                      int64_t min_value, int64_t max_value,
+                                      jsProfile *profiles,
+                                      uint32_t max_profiles)
+{
+  return _scan_head_get_history(scan_head, true, encoder, min_value,
+                                max_value, profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawHistoryByEncoder(jsScanHead scan_head,
+                                         jsEncoder encoder, int64_t min_value,
+                                         int64_t max_value,
+                                         jsRawProfile *profiles,
+                                         uint32_t max_profiles)
+{
+  return _scan_head_get_history(scan_head, true, encoder, min_value,
+                                max_value, profiles, max_profiles);
+}
+
+EXPORTED
+int32_t jsScanHeadEnableLatestProfile(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetLatestProfile().Enable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadDisableLatestProfile(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetLatestProfile().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetLatestProfile(jsScanHead scan_head, jsCamera camera,
+                                   jsLaser laser, jsProfile *profile)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profile) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    LatestProfile &latest = sh->GetScanHeadShared().GetLatestProfile();
+    jsRawProfile raw;
+
+    if (!latest.IsEnabled()) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (latest.Load(camera, laser, &raw)) {
+      raw.format = sh->GetDataFormat();
+      _copy_profile(raw, profile);
+      r = 1;
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetRawLatestProfile(jsScanHead scan_head, jsCamera camera,
+                                      jsLaser laser, jsRawProfile *profile)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == profile) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((JS_CAMERA_MAX <= camera) || (JS_LASER_MAX <= laser)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    LatestProfile &latest = sh->GetScanHeadShared().GetLatestProfile();
+
+    if (!latest.IsEnabled()) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else if (latest.Load(camera, laser, profile)) {
+      profile->format = sh->GetDataFormat();
+      r = 1;
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadEnableValidityHeatmap(jsScanHead scan_head,
+                                        const jsValidityHeatmapConfig *config)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (0 >= config->bin_size) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if ((config->region.x_min > config->region.x_max) ||
+             (config->region.y_min > config->region.y_max)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  const jsRegion &region = config->region;
+  int64_t w = static_cast<int64_t>(region.x_max) - region.x_min;
+  int64_t h = static_cast<int64_t>(region.y_max) - region.y_min;
+  int64_t num_bins = (w / config->bin_size + 1) * (h / config->bin_size + 1);
+  if (JS_VALIDITY_HEATMAP_BINS_MAX < num_bins) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetValidityHeatmap().Enable(*config);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadDisableValidityHeatmap(jsScanHead scan_head)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetValidityHeatmap().Disable();
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadGetValidityHeatmap(jsScanHead scan_head,
+                                     jsValidityHeatmap *heatmap,
+                                     uint64_t *bins, uint32_t max_bins,
+                                     bool reset)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == heatmap) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((nullptr == bins) && (0 != max_bins)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ValidityHeatmap &map = sh->GetScanHeadShared().GetValidityHeatmap();
+
+    if (!map.IsEnabled()) {
+      r = JS_ERROR_INVALID_ARGUMENT;
+    } else {
+      r = static_cast<int32_t>(map.Get(heatmap, bins, max_bins, reset));
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadProposeWindow(jsScanHead scan_head,
+                                const jsWindowProposalConfig *config,
+                                jsWindowProposal *proposal)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((nullptr == config) || (nullptr == proposal)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(config->coverage) ||
+             INVALID_DOUBLE(config->margin_inches)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  } else if ((0.0 >= config->coverage) || (1.0 < config->coverage) ||
+             (0.0 > config->margin_inches)) {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ValidityHeatmap &map = sh->GetScanHeadShared().GetValidityHeatmap();
+
+    if (!map.IsEnabled()) {
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+
+    // the column counts alone are too large to keep on the stack
+    std::unique_ptr<jsValidityHeatmap> heatmap(new jsValidityHeatmap);
+    std::vector<uint64_t> bins(JS_VALIDITY_HEATMAP_BINS_MAX);
+    map.Get(heatmap.get(), bins.data(), JS_VALIDITY_HEATMAP_BINS_MAX, false);
+
+    if (!ProposeWindow(map.GetConfig(), *heatmap, bins.data(), *config,
+                       proposal)) {
+      // nothing seen yet to propose a window around
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+
+    ScanHeadConfiguration cfg = sh->GetConfiguration();
+    double max_rate_hz = sh->GetStatusMessage().GetMaxScanRate();
+    double limit_hz = std::min(
+      kPinchotConstantMaxScanRate,
+      1000000.0 / static_cast<double>(cfg.GetMaxLaserOn()));
+
+    proposal->scan_rate_hz = EstimateScanRate(cfg.GetScanWindow(),
+                                              max_rate_hz, limit_hz,
+                                              *proposal);
+    proposal->bandwidth_bytes_per_s = EstimateBandwidth(
+      sh->GetDataFormat(), proposal->scan_rate_hz, *proposal);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadEnableTemporalFilter(jsScanHead scan_head,
+                                       const jsTemporalFilterConfig *config)
 {
-  bool is_connected = false;
+  int32_t r = 0;
 
   if (nullptr == scan_head) {
-    return false;
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == config) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  if (JS_TEMPORAL_FILTER_EMA == config->type) {
+    if ((0.0 >= config->alpha) || (1.0 < config->alpha)) {
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+  } else if (JS_TEMPORAL_FILTER_MEDIAN == config->type) {
+    if ((0 == (config->window & 1)) ||
+        (JS_TEMPORAL_FILTER_WINDOW_MAX < config->window)) {
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+  } else {
+    return JS_ERROR_INVALID_ARGUMENT;
+  }
+
+  if (0 > config->reset_distance) {
+    return JS_ERROR_INVALID_ARGUMENT;
   }
 
   try {
     ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    ScanManager &mgr = sh->GetScanManager();
+    ScanManager &manager = sh->GetScanManager();
 
-    StatusMessage message = sh->GetStatusMessage();
-    auto timestamp = message.GetGlobalTime();
-    if ((mgr.IsConnected()) && (0 != timestamp)) {
-      is_connected = true;
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    } else if (0.0 != sh->GetScanHeadShared().GetFloatOutput()) {
+      return JS_ERROR_INVALID_ARGUMENT;
     }
+
+    sh->GetScanHeadShared().GetTemporalFilter().Enable(*config);
   } catch (std::exception &e) {
     (void)e;
-    is_connected = false;
+    r = JS_ERROR_INTERNAL;
   }
 
-  return is_connected;
+  return r;
 }
 
 EXPORTED
-int32_t jsScanHeadGetProfilesAvailable(jsScanHead scan_head)
+int32_t jsScanHeadDisableTemporalFilter(jsScanHead scan_head)
 {
   int32_t r = 0;
 
@@ -805,8 +2718,13 @@ int32_t jsScanHeadGetProfilesAvailable(jsScanHead scan_head)
 
   try {
     ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    uint32_t count = sh->AvailableProfiles();
-    r = static_cast<int32_t>(count);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    }
+
+    sh->GetScanHeadShared().GetTemporalFilter().Disable();
   } catch (std::exception &e) {
     (void)e;
     r = JS_ERROR_INTERNAL;
@@ -816,21 +2734,31 @@ int32_t jsScanHeadGetProfilesAvailable(jsScanHead scan_head)
 }
 
 EXPORTED
-int32_t jsScanHeadWaitUntilProfilesAvailable(jsScanHead scan_head,
-                                             uint32_t count,
-                                             uint32_t timeout_us)
+int32_t jsScanHeadEnableResampling(jsScanHead scan_head,
+                                   const jsResampleConfig *config)
 {
   int32_t r = 0;
 
   if (nullptr == scan_head) {
     return JS_ERROR_NULL_ARGUMENT;
-  } else if (JS_SCAN_HEAD_PROFILES_MAX < count) {
-    count = JS_SCAN_HEAD_PROFILES_MAX;
+  }
+
+  r = _check_resample_config(config);
+  if (0 != r) {
+    return r;
   }
 
   try {
     ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    r = sh->WaitUntilAvailableProfiles(count, timeout_us);
+    ScanManager &manager = sh->GetScanManager();
+
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    } else if (0.0 != sh->GetScanHeadShared().GetFloatOutput()) {
+      return JS_ERROR_INVALID_ARGUMENT;
+    }
+
+    sh->GetScanHeadShared().GetProfileResampler().Enable(*config);
   } catch (std::exception &e) {
     (void)e;
     r = JS_ERROR_INTERNAL;
@@ -840,55 +2768,23 @@ int32_t jsScanHeadWaitUntilProfilesAvailable(jsScanHead scan_head,
 }
 
 EXPORTED
-int32_t jsScanHeadGetRawProfiles(jsScanHead scan_head, jsRawProfile *profiles,
-                                 uint32_t max_profiles)
+int32_t jsScanHeadDisableResampling(jsScanHead scan_head)
 {
   int32_t r = 0;
 
   if (nullptr == scan_head) {
     return JS_ERROR_NULL_ARGUMENT;
-  } else if (nullptr == profiles) {
-    return JS_ERROR_NULL_ARGUMENT;
   }
 
   try {
     ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    // TODO: FKS-219
-    // We should retool the internal C++ code to make this whole process less
-    // labor intensive. Ideally we could just do a straight memcpy.
-    auto p = sh->GetProfiles(static_cast<int>(max_profiles));
-    uint32_t total = (max_profiles < static_cast<uint32_t>(p.size()))
-                       ? max_profiles
-                       : static_cast<uint32_t>(p.size());
-
-    for (uint32_t m = 0; m < total; m++) {
-      profiles[m].scan_head_id = p[m]->GetScanHeadId();
-      profiles[m].camera = p[m]->GetCamera();
-      profiles[m].laser = p[m]->GetLaser();
-      profiles[m].timestamp_ns = p[m]->GetTimestamp();
-      profiles[m].laser_on_time_us = p[m]->GetLaserOnTime();
-      profiles[m].format = sh->GetDataFormat();
-
-      std::pair<uint32_t, uint32_t> pkt_info = p[m]->GetUDPPacketInfo();
-      profiles[m].udp_packets_received = pkt_info.first;
-      profiles[m].udp_packets_expected = pkt_info.second;
-
-      memset(profiles[m].encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
-      std::vector<int64_t> e = p[m]->GetEncoderValues();
-      std::copy(e.begin(), e.end(), profiles[m].encoder_values);
-      profiles[m].num_encoder_values = static_cast<uint32_t>(e.size());
-      assert(profiles[m].num_encoder_values < JS_ENCODER_MAX);
+    ScanManager &manager = sh->GetScanManager();
 
-      std::vector<jsProfileData> data = p[m]->Data();
-      // TODO: We shouldn't need to do this, but for now check to be safe.
-      assert(data.size() == JS_RAW_PROFILE_DATA_LEN);
-      copy(data.begin(), data.end(), profiles[m].data);
-      profiles[m].data_len = static_cast<uint32_t>(data.size());
-      profiles[m].data_valid_brightness = p[m]->GetNumberValidBrightness();
-      profiles[m].data_valid_xy = p[m]->GetNumberValidGeometry();
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
     }
-    // return number of profiles copied
-    r = static_cast<int32_t>(total);
+
+    sh->GetScanHeadShared().GetProfileResampler().Disable();
   } catch (std::exception &e) {
     (void)e;
     r = JS_ERROR_INTERNAL;
@@ -898,60 +2794,30 @@ int32_t jsScanHeadGetRawProfiles(jsScanHead scan_head, jsRawProfile *profiles,
 }
 
 EXPORTED
-int32_t jsScanHeadGetProfiles(jsScanHead scan_head, jsProfile *profiles,
-                              uint32_t max_profiles)
+int32_t jsScanHeadSetFloatOutput(jsScanHead scan_head, double units_per_inch)
 {
   int32_t r = 0;
 
   if (nullptr == scan_head) {
     return JS_ERROR_NULL_ARGUMENT;
-  } else if (nullptr == profiles) {
-    return JS_ERROR_NULL_ARGUMENT;
+  } else if (INVALID_DOUBLE(units_per_inch) || (0.0 > units_per_inch)) {
+    return JS_ERROR_INVALID_ARGUMENT;
   }
 
   try {
     ScanHead *sh = static_cast<ScanHead *>(scan_head);
-    // TODO: FKS-219
-    // We should retool the internal C++ code to make this whole process less
-    // labor intensive. Ideally we could just do a straight memcpy.
-    auto p = sh->GetProfiles(static_cast<int>(max_profiles));
-    uint32_t total = (max_profiles < static_cast<uint32_t>(p.size()))
-                       ? max_profiles
-                       : static_cast<uint32_t>(p.size());
-
-    for (uint32_t m = 0; m < total; m++) {
-      profiles[m].scan_head_id = p[m]->GetScanHeadId();
-      profiles[m].camera = p[m]->GetCamera();
-      profiles[m].laser = p[m]->GetLaser();
-      profiles[m].timestamp_ns = p[m]->GetTimestamp();
-      profiles[m].laser_on_time_us = p[m]->GetLaserOnTime();
-      profiles[m].format = sh->GetDataFormat();
-
-      std::pair<uint32_t, uint32_t> pkt_info = p[m]->GetUDPPacketInfo();
-      profiles[m].udp_packets_received = pkt_info.first;
-      profiles[m].udp_packets_expected = pkt_info.second;
-
-      memset(profiles[m].encoder_values, 0, sizeof(int64_t) * JS_ENCODER_MAX);
-      std::vector<int64_t> e = p[m]->GetEncoderValues();
-      std::copy(e.begin(), e.end(), profiles[m].encoder_values);
-      profiles[m].num_encoder_values = static_cast<uint32_t>(e.size());
-      assert(profiles[m].num_encoder_values < JS_ENCODER_MAX);
+    ScanManager &manager = sh->GetScanManager();
+    ScanHeadShared &shared = sh->GetScanHeadShared();
 
-      std::vector<jsProfileData> data = p[m]->Data();
-      unsigned int stride = _data_format_to_stride(profiles[m].format);
-      unsigned int p = 0;
-      for (unsigned int n = 0; n < data.size(); n += stride) {
-        if ((JS_PROFILE_DATA_INVALID_XY != data[n].x) ||
-            (JS_PROFILE_DATA_INVALID_XY != data[n].y)) {
-          // Note: Only need to check X/Y since we only support data types with
-          // X/Y coordinates alone or X/Y coordinates with brightness.
-          profiles[m].data[p++] = data[n];
-        }
-      }
-      profiles[m].data_len = p;
+    if (true == manager.IsScanning()) {
+      return JS_ERROR_SCANNING;
+    } else if ((0.0 != units_per_inch) &&
+               (shared.GetTemporalFilter().IsEnabled() ||
+                shared.GetProfileResampler().IsEnabled())) {
+      return JS_ERROR_INVALID_ARGUMENT;
     }
-    // return number of profiles copied
-    r = static_cast<int32_t>(total);
+
+    shared.SetFloatOutput(units_per_inch);
   } catch (std::exception &e) {
     (void)e;
     r = JS_ERROR_INTERNAL;
@@ -1125,3 +2991,282 @@ int32_t jsScanHeadGetStatus(jsScanHead scan_head, jsScanHeadStatus *status)
 
   return r;
 }
+
+EXPORTED
+int32_t jsScanHeadGetClock(jsScanHead scan_head, jsScanHeadClock *clock)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if (nullptr == clock) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    sh->GetScanHeadShared().GetClockModel().GetClock(clock);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsScanHeadConvertTimestamp(jsScanHead scan_head, uint64_t timestamp_ns,
+                                   uint64_t *host_time_ns, uint64_t *error_ns)
+{
+  int32_t r = 0;
+
+  if (nullptr == scan_head) {
+    return JS_ERROR_NULL_ARGUMENT;
+  } else if ((nullptr == host_time_ns) || (nullptr == error_ns)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    ScanHead *sh = static_cast<ScanHead *>(scan_head);
+    ClockModel &model = sh->GetScanHeadShared().GetClockModel();
+
+    if (!model.Convert(timestamp_ns, host_time_ns, error_ns)) {
+      r = JS_ERROR_NOT_CONNECTED;
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsProfilesGetHighestPoint(const jsProfile *profiles,
+                                  uint32_t num_profiles,
+                                  const jsRegion *region, jsProfileData *points)
+{
+  return _profiles_get_extreme(profiles, num_profiles, region, points, true);
+}
+
+EXPORTED
+int32_t jsProfilesGetLowestPoint(const jsProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 jsProfileData *points)
+{
+  return _profiles_get_extreme(profiles, num_profiles, region, points, false);
+}
+
+EXPORTED
+int32_t jsProfilesGetPointCount(const jsProfile *profiles,
+                                uint32_t num_profiles, const jsRegion *region,
+                                uint32_t *counts)
+{
+  return _profiles_get_point_count(profiles, num_profiles, region, counts);
+}
+
+EXPORTED
+int32_t jsProfilesGetCentroid(const jsProfile *profiles, uint32_t num_profiles,
+                              const jsRegion *region, double *centroid_x,
+                              double *centroid_y)
+{
+  return _profiles_get_centroid(profiles, num_profiles, region, centroid_x,
+                                centroid_y);
+}
+
+EXPORTED
+int32_t jsProfilesGetArea(const jsProfile *profiles, uint32_t num_profiles,
+                          const jsRegion *region, double slope,
+                          double intercept, double *areas)
+{
+  return _profiles_get_area(profiles, num_profiles, region, slope, intercept,
+                            areas);
+}
+
+EXPORTED
+int32_t jsRawProfilesGetHighestPoint(const jsRawProfile *profiles,
+                                     uint32_t num_profiles,
+                                     const jsRegion *region,
+                                     jsProfileData *points)
+{
+  return _profiles_get_extreme(profiles, num_profiles, region, points, true);
+}
+
+EXPORTED
+int32_t jsRawProfilesGetLowestPoint(const jsRawProfile *profiles,
+                                    uint32_t num_profiles,
+                                    const jsRegion *region,
+                                    jsProfileData *points)
+{
+  return _profiles_get_extreme(profiles, num_profiles, region, points, false);
+}
+
+EXPORTED
+int32_t jsRawProfilesGetPointCount(const jsRawProfile *profiles,
+                                   uint32_t num_profiles,
+                                   const jsRegion *region, uint32_t *counts)
+{
+  return _profiles_get_point_count(profiles, num_profiles, region, counts);
+}
+
+EXPORTED
+int32_t jsRawProfilesGetCentroid(const jsRawProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 double *centroid_x, double *centroid_y)
+{
+  return _profiles_get_centroid(profiles, num_profiles, region, centroid_x,
+                                centroid_y);
+}
+
+EXPORTED
+int32_t jsRawProfilesGetArea(const jsRawProfile *profiles,
+                             uint32_t num_profiles, const jsRegion *region,
+                             double slope, double intercept, double *areas)
+{
+  return _profiles_get_area(profiles, num_profiles, region, slope, intercept,
+                            areas);
+}
+
+EXPORTED
+int32_t jsProfilesFitLine(const jsProfile *profiles, uint32_t num_profiles,
+                          const jsRegion *region, jsLineSegment *lines)
+{
+  return _profiles_fit_line(profiles, num_profiles, region, lines);
+}
+
+EXPORTED
+int32_t jsProfilesFitSegments(const jsProfile *profiles,
+                              uint32_t num_profiles, const jsRegion *region,
+                              double tolerance, jsLineSegment *segments,
+                              uint32_t max_segments, uint32_t *num_segments)
+{
+  return _profiles_fit_segments(profiles, num_profiles, region, tolerance,
+                                segments, max_segments, num_segments);
+}
+
+EXPORTED
+int32_t jsProfilesFindLine(const jsProfile *profiles, uint32_t num_profiles,
+                           const jsRegion *region, double tolerance,
+                           uint32_t iterations, jsLineSegment *lines)
+{
+  return _profiles_find_line(profiles, num_profiles, region, tolerance,
+                             iterations, lines);
+}
+
+EXPORTED
+int32_t jsRawProfilesFitLine(const jsRawProfile *profiles,
+                             uint32_t num_profiles, const jsRegion *region,
+                             jsLineSegment *lines)
+{
+  return _profiles_fit_line(profiles, num_profiles, region, lines);
+}
+
+EXPORTED
+int32_t jsRawProfilesFitSegments(const jsRawProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 double tolerance, jsLineSegment *segments,
+                                 uint32_t max_segments,
+                                 uint32_t *num_segments)
+{
+  return _profiles_fit_segments(profiles, num_profiles, region, tolerance,
+                                segments, max_segments, num_segments);
+}
+
+EXPORTED
+int32_t jsRawProfilesFindLine(const jsRawProfile *profiles,
+                              uint32_t num_profiles, const jsRegion *region,
+                              double tolerance, uint32_t iterations,
+                              jsLineSegment *lines)
+{
+  return _profiles_find_line(profiles, num_profiles, region, tolerance,
+                             iterations, lines);
+}
+
+EXPORTED
+int32_t jsStitchedProfilesGetCrossSection(const jsStitchedProfile *profiles,
+                                          uint32_t num_profiles,
+                                          jsCrossSection *sections)
+{
+  int32_t r = 0;
+
+  if ((nullptr == profiles) || (nullptr == sections)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    CrossSection cross_section(GetReductionKernels());
+    std::vector<Point2D<int64_t>> points;
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len =
+        std::min(profiles[m].data_len,
+                 static_cast<uint32_t>(JS_STITCHED_PROFILE_DATA_LEN));
+      // stitched profiles are already ordered by X
+      points.resize(len);
+      for (uint32_t n = 0; n < len; n++) {
+        points[n].x = profiles[m].data[n].x;
+        points[n].y = profiles[m].data[n].y;
+      }
+      cross_section.Compute(points, &sections[m]);
+    }
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsProfilesGetFrameCrossSection(const jsProfile *profiles,
+                                       uint32_t num_profiles,
+                                       jsCrossSection *section)
+{
+  int32_t r = 0;
+
+  if ((nullptr == profiles) || (nullptr == section)) {
+    return JS_ERROR_NULL_ARGUMENT;
+  }
+
+  try {
+    CrossSection cross_section(GetReductionKernels());
+    std::vector<Point2D<int64_t>> points;
+
+    for (uint32_t m = 0; m < num_profiles; m++) {
+      uint32_t len = std::min(profiles[m].data_len,
+                              static_cast<uint32_t>(JS_PROFILE_DATA_LEN));
+      for (uint32_t n = 0; n < len; n++) {
+        points.push_back(
+          Point2D<int64_t>(profiles[m].data[n].x, profiles[m].data[n].y));
+      }
+    }
+
+    std::sort(points.begin(), points.end(),
+              [](const Point2D<int64_t> &a, const Point2D<int64_t> &b) {
+                return (a.x < b.x) || ((a.x == b.x) && (a.y < b.y));
+              });
+    cross_section.Compute(points, section);
+  } catch (std::exception &e) {
+    (void)e;
+    r = JS_ERROR_INTERNAL;
+  }
+
+  return r;
+}
+
+EXPORTED
+int32_t jsProfilesResample(const jsProfile *profiles, uint32_t num_profiles,
+                           const jsResampleConfig *config,
+                           jsProfileData *points)
+{
+  return _profiles_resample(profiles, num_profiles, config, points);
+}
+
+EXPORTED
+int32_t jsRawProfilesResample(const jsRawProfile *profiles,
+                              uint32_t num_profiles,
+                              const jsResampleConfig *config,
+                              jsProfileData *points)
+{
+  return _profiles_resample(profiles, num_profiles, config, points);
+}
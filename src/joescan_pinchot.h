@@ -92,6 +92,36 @@ enum jsConstants {
    * scan head with one API call.
    */
   JS_SCAN_HEAD_PROFILES_MAX = 1000,
+  /**
+   * @brief The maximum number of sources, cameras of the scan heads in a
+   * scan system, that can be stitched into a `jsStitchedProfile`.
+   */
+  JS_STITCHED_PROFILE_SOURCES_MAX = 16,
+  /** @brief Array length of data reserved for a stitched profile. */
+  JS_STITCHED_PROFILE_DATA_LEN =
+    JS_PROFILE_DATA_LEN * JS_STITCHED_PROFILE_SOURCES_MAX,
+  /**
+   * @brief The maximum number of piece events held for a scan head; older
+   * events are discarded if they are not read out in time.
+   */
+  JS_PIECE_EVENTS_MAX = 256,
+  /**
+   * @brief The maximum number of events held for a scan system; newer events
+   * are counted and discarded if older ones are not read out in time.
+   */
+  JS_SYSTEM_EVENTS_MAX = 1024,
+  /**
+   * @brief The maximum number of bins of the mill coordinate system that a
+   * validity heatmap can count points in.
+   */
+  JS_VALIDITY_HEATMAP_BINS_MAX = 65536,
+  /**
+   * @brief The largest number of successive profiles a temporal median
+   * filter can take the median of.
+   */
+  JS_TEMPORAL_FILTER_WINDOW_MAX = 7,
+  /** @brief Array length of the bitmap of missing columns of a profile. */
+  JS_MISSING_COLUMNS_MASK_LEN = (JS_RAW_PROFILE_DATA_LEN + 7) / 8,
 };
 
 /**
@@ -175,8 +205,42 @@ typedef enum {
 
   // Full camera pixel image.
   JS_DATA_FORMAT_CAMERA_IMAGE_FULL,
+
+  // Geometry computed by the API from the laser line position seen by each
+  // camera column, using the mapping tables of the cameras, with and without
+  // laser line brightness at full resolution. See
+  // `jsScanHeadSetMappingTable`.
+  JS_DATA_FORMAT_SUBPIXEL_FULL_LM_FULL,
+  JS_DATA_FORMAT_SUBPIXEL_FULL,
 } jsDataFormat;
 
+/**
+ * @brief Enumerated value identifying how the cameras of a scan head are
+ * timed against each other.
+ */
+typedef enum {
+  // The cameras take their profiles in turn, each at its own timestamp.
+  JS_CAMERA_EXPOSURE_MODE_INTERLEAVED = 0,
+  // The cameras take their profiles together, at the same timestamp.
+  JS_CAMERA_EXPOSURE_MODE_SIMULTANEOUS,
+} jsCameraExposureMode;
+
+/**
+ * @brief Enumerated value identifying the CPU instruction set used by the API
+ * to decode profile data. The best variant supported by the CPU is selected
+ * automatically at runtime.
+ */
+typedef enum {
+  /** @brief Portable C++ without vector instructions. */
+  JS_SIMD_VARIANT_SCALAR = 0,
+  /** @brief x86 SSE4.2, 128 bit vectors. */
+  JS_SIMD_VARIANT_SSE42,
+  /** @brief x86 AVX2, 256 bit vectors. */
+  JS_SIMD_VARIANT_AVX2,
+  /** @brief x86 AVX-512 (F & BW), 512 bit vectors. */
+  JS_SIMD_VARIANT_AVX512,
+} jsSimdVariant;
+
 /**
  * @brief Structure used to communicate the various capabilities and limits of
  * a given scan head type.
@@ -311,6 +375,64 @@ typedef struct {
   uint32_t firmware_version_patch;
 } jsScanHeadStatus;
 
+/**
+ * @brief The estimated relation between a scan head's clock, which timestamps
+ * its profiles and status messages, and the host's monotonic clock returned by
+ * `jsGetHostTime`. The estimate is refined continuously from the arrival times
+ * of status messages and profiles while the scan head is connected.
+ *
+ * @note Host times include the least transport latency from the scan head to
+ * the client, which can't be observed without a round trip. It is common to
+ * all scan heads on the same network, so host times of different scan heads
+ * remain comparable.
+ */
+typedef struct {
+  /** @brief The scan head time of the most recent time reference. */
+  uint64_t timestamp_ns;
+  /** @brief The host time corresponding to `timestamp_ns`. */
+  uint64_t host_time_ns;
+  /**
+   * @brief The bound of the error of the host time in nanoseconds; it grows
+   * for scan head times away from `timestamp_ns`.
+   */
+  uint64_t error_ns;
+  /**
+   * @brief The rate at which host time advances faster than scan head time,
+   * in parts per million.
+   */
+  double drift_ppm;
+  /** @brief The number of time references received. */
+  uint64_t num_samples;
+  /**
+   * @brief The least delay in nanoseconds between the timestamp of a profile
+   * and its arrival, beyond that of status messages; this is the time taken
+   * by the scan head to process and send a profile.
+   */
+  uint64_t profile_latency_ns;
+  /**
+   * @brief The mean delay in nanoseconds between the host time of a profile's
+   * timestamp and the arrival of the profile.
+   */
+  double arrival_latency_mean_ns;
+  /** @brief The standard deviation of the arrival delay of profiles. */
+  double arrival_latency_stddev_ns;
+  /** @brief The greatest arrival delay of a profile in nanoseconds. */
+  double arrival_latency_max_ns;
+  /** @brief The number of intervals between profiles of the same camera. */
+  uint64_t num_intervals;
+  /**
+   * @brief The mean interval in nanoseconds between the timestamps of
+   * consecutive profiles of the same camera.
+   */
+  double interval_mean_ns;
+  /** @brief The standard deviation of the interval between profiles. */
+  double interval_stddev_ns;
+  /** @brief The shortest interval between profiles in nanoseconds. */
+  double interval_min_ns;
+  /** @brief The longest interval between profiles in nanoseconds. */
+  double interval_max_ns;
+} jsScanHeadClock;
+
 /**
  * @brief A data point within a returned profile's data.
  */
@@ -332,6 +454,604 @@ typedef struct {
   int32_t brightness;
 } jsProfileData;
 
+/**
+ * @brief Summary of the valid X/Y points of a profile, computed as the profile
+ * data is decoded. This allows making decisions about a profile without having
+ * to iterate over its `data` array.
+ *
+ * @note If the profile holds no valid X/Y points, `num_valid` will be zero and
+ * all other fields will be set to `JS_PROFILE_DATA_INVALID_XY`.
+ */
+typedef struct {
+  /** @brief The minimum X coordinate in 1/1000 inches. */
+  int32_t x_min;
+  /** @brief The maximum X coordinate in 1/1000 inches. */
+  int32_t x_max;
+  /** @brief The minimum Y coordinate in 1/1000 inches. */
+  int32_t y_min;
+  /** @brief The maximum Y coordinate in 1/1000 inches. */
+  int32_t y_max;
+  /**
+   * @brief The X coordinate in 1/1000 inches of the highest point; the point
+   * with the greatest Y coordinate. If several points share the greatest Y
+   * coordinate, the first of them in the `data` array is used.
+   */
+  int32_t highest_x;
+  /** @brief The Y coordinate in 1/1000 inches of the highest point. */
+  int32_t highest_y;
+  /**
+   * @brief The measured brightness of the highest point, or
+   * `JS_PROFILE_DATA_INVALID_BRIGHTNESS` if not measured.
+   */
+  int32_t highest_brightness;
+  /** @brief The mean X coordinate of all valid points in 1/1000 inches. */
+  int32_t centroid_x;
+  /** @brief The mean Y coordinate of all valid points in 1/1000 inches. */
+  int32_t centroid_y;
+  /** @brief The number of valid X/Y points in the profile. */
+  uint32_t num_valid;
+} jsProfileSummary;
+
+/**
+ * @brief Rectangular region of the mill coordinate system used to limit which
+ * profile points are considered by the profile reduction functions. Bounds
+ * are inclusive and expressed in 1/1000 inches. To only limit the X range,
+ * set `y_min` to `INT32_MIN` and `y_max` to `INT32_MAX`.
+ */
+typedef struct {
+  /** @brief The minimum X coordinate in 1/1000 inches. */
+  int32_t x_min;
+  /** @brief The maximum X coordinate in 1/1000 inches. */
+  int32_t x_max;
+  /** @brief The minimum Y coordinate in 1/1000 inches. */
+  int32_t y_min;
+  /** @brief The maximum Y coordinate in 1/1000 inches. */
+  int32_t y_max;
+} jsRegion;
+
+/**
+ * @brief Line segment fitted to profile points by the line fitting functions.
+ * Coordinates are expressed in 1/1000 inches. If the segment could not be
+ * fitted, the coordinates and `rms_error` are set to `NAN`.
+ */
+typedef struct {
+  /** @brief The X coordinate of the start of the segment. */
+  double x0;
+  /** @brief The Y coordinate of the start of the segment. */
+  double y0;
+  /** @brief The X coordinate of the end of the segment. */
+  double x1;
+  /** @brief The Y coordinate of the end of the segment. */
+  double y1;
+  /**
+   * @brief The root mean square perpendicular distance of the fitted points
+   * from the segment in 1/1000 inches.
+   */
+  double rms_error;
+  /** @brief The number of points the segment was fitted to. */
+  uint32_t num_points;
+} jsLineSegment;
+
+/**
+ * @brief Enumerated value selecting how points are resolved where the
+ * profiles of different sources overlap when stitching.
+ */
+typedef enum {
+  /** @brief Keep the points of all sources. */
+  JS_STITCH_OVERLAP_KEEP_ALL = 0,
+  /**
+   * @brief Split the overlap at its midpoint in X, each source keeping the
+   * points on its own side.
+   */
+  JS_STITCH_OVERLAP_MIDPOINT,
+  /**
+   * @brief Keep the points of the source with the lowest scan head ID, then
+   * lowest camera, dropping the points of other sources within its extent
+   * in X.
+   */
+  JS_STITCH_OVERLAP_PRIORITY,
+} jsStitchOverlapRule;
+
+/**
+ * @brief Settings of the presence detector that segments the profiles of a
+ * scan head into pieces, see `jsScanHeadEnablePresenceDetection`. A profile
+ * is considered to see a piece if it meets all of the criteria.
+ */
+typedef struct {
+  /** @brief The least number of valid X/Y points in a profile. */
+  uint32_t min_valid_points;
+  /**
+   * @brief The least number of valid X/Y points within `region`. Set to `0`
+   * to not use `region`.
+   */
+  uint32_t min_region_points;
+  /** @brief The region of the mill where points are counted. */
+  jsRegion region;
+  /**
+   * @brief The number of consecutive profiles that must see a piece to start
+   * it, at least `1`.
+   */
+  uint32_t start_count;
+  /**
+   * @brief The number of consecutive profiles that must not see a piece to
+   * end it, at least `1`.
+   */
+  uint32_t end_count;
+  /**
+   * @brief Set to `true` to discard profiles outside of pieces before they
+   * are buffered, `false` to keep them with a `piece_id` of `0`.
+   */
+  bool suppress_empty;
+} jsPresenceConfig;
+
+/**
+ * @brief Type of a `jsPieceEvent`.
+ */
+typedef enum {
+  /** @brief A piece entered the view of the scan head. */
+  JS_PIECE_EVENT_START = 0,
+  /** @brief A piece left the view of the scan head. */
+  JS_PIECE_EVENT_END,
+} jsPieceEventType;
+
+/**
+ * @brief Reports a piece entering or leaving the view of a scan head.
+ */
+typedef struct {
+  /** @brief Whether the piece started or ended. */
+  jsPieceEventType type;
+  /** @brief The Id of the scan head that detected the piece. */
+  uint32_t scan_head_id;
+  /** @brief The `piece_id` given to the profiles of the piece. */
+  uint64_t piece_id;
+  /**
+   * @brief Time of the scan head in nanoseconds of the first profile that saw
+   * the piece for a start event, of the last one for an end event.
+   */
+  uint64_t timestamp_ns;
+  /** @brief The encoder values of the same profile. */
+  int64_t encoder_values[JS_ENCODER_MAX];
+  /** @brief Number of encoder values in this event. */
+  uint32_t num_encoder_values;
+  /**
+   * @brief The number of profiles of the piece for an end event, `0` for a
+   * start event.
+   */
+  uint32_t num_profiles;
+} jsPieceEvent;
+
+/**
+ * @brief Type of a `jsSystemEvent`, along with the meaning of its `value`.
+ */
+typedef enum {
+  /** @brief The scan head connected; `value` is its major version. */
+  JS_SYSTEM_EVENT_CONNECTED = 0,
+  /** @brief The scan head was disconnected; `value` is `0`. */
+  JS_SYSTEM_EVENT_DISCONNECTED,
+  /**
+   * @brief The scan head runs a version the client is not compatible with;
+   * `value` is its major version.
+   */
+  JS_SYSTEM_EVENT_VERSION_MISMATCH,
+  /**
+   * @brief Profiles of the scan head were not read out in time and the
+   * oldest are being discarded; posted once until profiles are read again.
+   * `value` is the total number of profiles discarded for the scan head.
+   */
+  JS_SYSTEM_EVENT_PROFILES_DROPPED,
+  /**
+   * @brief A profile was given up on with datagrams missing, see
+   * `jsScanHeadGetRawProfilesMissingColumns`; `value` is the number of
+   * datagrams missing.
+   */
+  JS_SYSTEM_EVENT_PROFILE_INCOMPLETE,
+  /**
+   * @brief The scan head stopped sending while scanning; `value` is the
+   * time in milliseconds since it last sent anything.
+   */
+  JS_SYSTEM_EVENT_SCAN_HEAD_STALLED,
+  /** @brief A stalled scan head is sending again; `value` is `0`. */
+  JS_SYSTEM_EVENT_SCAN_HEAD_RESUMED,
+  /**
+   * @brief A datagram from the scan head could not be parsed and was
+   * discarded; `value` is its size in bytes.
+   */
+  JS_SYSTEM_EVENT_INVALID_DATAGRAM,
+  /**
+   * @brief A command could not be sent and the client stopped sending
+   * further commands; `value` is the IP address it was sent to.
+   */
+  JS_SYSTEM_EVENT_SEND_FAILED,
+  /**
+   * @brief Events were discarded because the queue was full; `value` is the
+   * number of events discarded.
+   */
+  JS_SYSTEM_EVENT_EVENTS_DROPPED,
+} jsSystemEventType;
+
+/**
+ * @brief Reports a change or problem of a scan system, see
+ * `jsScanSystemGetEvents`.
+ */
+typedef struct {
+  /** @brief What happened, also giving the meaning of `value`. */
+  jsSystemEventType type;
+  /**
+   * @brief The Id of the scan head concerned, `UINT32_MAX` for events of the
+   * scan system as a whole.
+   */
+  uint32_t scan_head_id;
+  /** @brief Host time in nanoseconds of the event, see `jsGetHostTime`. */
+  uint64_t timestamp_ns;
+  /** @brief Value depending on the type of the event. */
+  int64_t value;
+} jsSystemEvent;
+
+/**
+ * @brief Bounds of the profile history retained for a scan head, see
+ * `jsScanHeadEnableHistory`. Each retained profile holds on to about
+ * `JS_PROFILE_DATA_LEN * sizeof(jsProfileData)` bytes of memory.
+ */
+typedef struct {
+  /** @brief The maximum number of profiles retained, at least `1`. */
+  uint32_t max_profiles;
+  /**
+   * @brief The maximum age in nanoseconds of retained profiles relative to the
+   * newest one. Set to `0` to only bound the history by `max_profiles`.
+   */
+  uint64_t max_age_ns;
+} jsHistoryConfig;
+
+/**
+ * @brief Progress of a scan head through a burst started with
+ * `jsScanSystemStartBurst`.
+ */
+typedef struct {
+  /** @brief The Id of the scan head. */
+  uint32_t scan_head_id;
+  /** @brief The number of profiles requested from the scan head. */
+  uint32_t num_profiles_requested;
+  /**
+   * @brief The number of profiles received from the scan head, including
+   * those missing UDP packets.
+   */
+  uint32_t num_profiles_received;
+  /**
+   * @brief The number of profiles the scan head reported sending, `0` until
+   * it reports its status after the burst. Profiles sent but not received
+   * were lost on the network.
+   */
+  uint32_t num_profiles_sent;
+  /**
+   * @brief Set to `true` once all requested profiles were received or the
+   * scan head reported that it stopped scanning.
+   */
+  bool is_complete;
+} jsBurstStatus;
+
+/**
+ * @brief Settings of the validity heatmap of a scan head, see
+ * `jsScanHeadEnableValidityHeatmap`. The region is divided into square bins
+ * starting at its minimum X and Y; the last bin of a row or column may extend
+ * past the region, but only points within the region are counted.
+ */
+typedef struct {
+  /** @brief The region of the mill divided into bins. */
+  jsRegion region;
+  /** @brief The width and height of a bin in 1/1000 inches. */
+  int32_t bin_size;
+} jsValidityHeatmapConfig;
+
+/**
+ * @brief Counts of valid X/Y points of a scan head since the validity heatmap
+ * was enabled or last reset, see `jsScanHeadGetValidityHeatmap`.
+ */
+typedef struct {
+  /** @brief The timestamp of the oldest profile counted. */
+  uint64_t first_timestamp_ns;
+  /** @brief The timestamp of the newest profile counted. */
+  uint64_t last_timestamp_ns;
+  /** @brief The number of profiles counted from each camera. */
+  uint64_t num_profiles[JS_CAMERA_MAX];
+  /**
+   * @brief The number of valid points seen in each column of each camera.
+   * Columns never returned by the data format, such as the odd columns of
+   * `JS_DATA_FORMAT_XY_HALF`, are always `0`.
+   */
+  uint64_t column_valid[JS_CAMERA_MAX][JS_CAMERA_IMAGE_DATA_MAX_WIDTH];
+  /** @brief The number of bins along X. */
+  uint32_t num_x_bins;
+  /** @brief The number of bins along Y. */
+  uint32_t num_y_bins;
+} jsValidityHeatmap;
+
+/**
+ * @brief Settings for proposing a scan window from a validity heatmap, see
+ * `jsScanHeadProposeWindow`.
+ */
+typedef struct {
+  /**
+   * @brief The fraction of the valid points counted that the proposed window
+   * must hold before the margin is added, such as `0.999`.
+   */
+  double coverage;
+  /** @brief The distance in inches added to each side of the window. */
+  double margin_inches;
+  /** @brief The number of columns added to each end of a column range. */
+  uint32_t margin_columns;
+} jsWindowProposalConfig;
+
+/**
+ * @brief A scan window and camera column ranges covering the points counted
+ * by a validity heatmap, with the performance they are estimated to allow.
+ */
+typedef struct {
+  /** @brief The top window dimension in inches. */
+  double window_top;
+  /** @brief The bottom window dimension in inches. */
+  double window_bottom;
+  /** @brief The left window dimension in inches. */
+  double window_left;
+  /** @brief The right window dimension in inches. */
+  double window_right;
+  /** @brief The first camera column that sees product, for each camera. */
+  uint32_t column_start[JS_CAMERA_MAX];
+  /** @brief The last camera column that sees product, for each camera. */
+  uint32_t column_end[JS_CAMERA_MAX];
+  /**
+   * @brief The fraction of the valid points counted that lie within the
+   * window before the margin is added.
+   */
+  double coverage;
+  /**
+   * @brief The estimated maximum scan rate with the window, scaled from the
+   * maximum scan rate the scan head reports for its current window by the
+   * ratio of the window heights. `0` if the scan head has not reported one.
+   */
+  double scan_rate_hz;
+  /**
+   * @brief The estimated profile data sent per second at `scan_rate_hz` if
+   * only the column ranges were sent, in bytes.
+   */
+  double bandwidth_bytes_per_s;
+} jsWindowProposal;
+
+/**
+ * @brief The filters that can smooth the Y values of a camera column over
+ * successive profiles, see `jsScanHeadEnableTemporalFilter`.
+ */
+typedef enum {
+  /** @brief Exponential moving average of the Y values. */
+  JS_TEMPORAL_FILTER_EMA = 0,
+  /** @brief Median of the Y values of the last few profiles. */
+  JS_TEMPORAL_FILTER_MEDIAN,
+} jsTemporalFilterType;
+
+/**
+ * @brief Settings of the temporal filter of a scan head, see
+ * `jsScanHeadEnableTemporalFilter`.
+ */
+typedef struct {
+  /** @brief The filter applied to each camera column. */
+  jsTemporalFilterType type;
+  /**
+   * @brief The weight of the newest Y value for `JS_TEMPORAL_FILTER_EMA`,
+   * greater than `0` and at most `1`; smaller values smooth more.
+   */
+  double alpha;
+  /**
+   * @brief The odd number of profiles to take the median of for
+   * `JS_TEMPORAL_FILTER_MEDIAN`, at most `JS_TEMPORAL_FILTER_WINDOW_MAX`.
+   */
+  uint32_t window;
+  /**
+   * @brief The change of Y in 1/1000 inches from the filtered value beyond
+   * which a column starts over from the new value instead of being smoothed,
+   * such as at the edge of a piece; `0` to never start over.
+   */
+  int32_t reset_distance;
+} jsTemporalFilterConfig;
+
+/**
+ * @brief A grid of evenly spaced X coordinates to resample profiles onto, see
+ * `jsProfilesResample`. A grid point is interpolated linearly between the
+ * two points of the profile on either side of it along X, and is invalid if
+ * it lies beyond the ends of the profile or across a gap between points.
+ */
+typedef struct {
+  /** @brief The X coordinate of the first grid point in 1/1000 inches. */
+  int32_t x_start;
+  /** @brief The distance between grid points in 1/1000 inches. */
+  int32_t x_step;
+  /**
+   * @brief The number of grid points, at most `JS_PROFILE_DATA_LEN`; the last
+   * grid point must lie within the range of `int32_t`.
+   */
+  uint32_t num_points;
+  /**
+   * @brief The greatest distance along X in 1/1000 inches between two
+   * points of a profile that is interpolated across, such as `4 * x_step`;
+   * `0` to interpolate across any distance.
+   */
+  int32_t max_gap;
+} jsResampleConfig;
+
+/**
+ * @brief Describes the mapping table of a camera, which gives the camera
+ * coordinates of the laser line for each camera column at evenly spaced
+ * camera rows. Entry `n * num_columns + column` of the X and Y arrays of a
+ * table holds the camera coordinates in 1/1000 inches of the laser line
+ * seen by column `column` at row `n * row_step`, or NaN if it is outside of
+ * the calibrated area; the laser line position between rows is interpolated
+ * linearly. Rows are stored one after the other like the pixels of an
+ * image, so neighbouring columns seeing the laser line at similar rows look
+ * up neighbouring entries.
+ */
+typedef struct {
+  /**
+   * @brief The number of camera columns, starting with column `0`, at most
+   * `JS_CAMERA_IMAGE_DATA_MAX_WIDTH`.
+   */
+  uint32_t num_columns;
+  /**
+   * @brief The number of rows of each column, at least `2` and at most
+   * `JS_CAMERA_IMAGE_DATA_MAX_HEIGHT`.
+   */
+  uint32_t num_rows;
+  /** @brief The number of camera rows between rows of the table. */
+  uint32_t row_step;
+} jsMappingTable;
+
+/**
+ * @brief A point of a stitched profile, tagged with the source it came from.
+ */
+typedef struct {
+  /** @brief The X coordinate in 1/1000 inches. */
+  int32_t x;
+  /** @brief The Y coordinate in 1/1000 inches. */
+  int32_t y;
+  /** @brief The measured brightness. */
+  int32_t brightness;
+  /** @brief Index of the source in the `sources` array of the profile. */
+  uint32_t source;
+} jsStitchedProfileData;
+
+/**
+ * @brief A source of a stitched profile, one camera of a scan head.
+ */
+typedef struct {
+  /** @brief The Id of the scan head. */
+  uint32_t scan_head_id;
+  /** @brief The camera of the scan head. */
+  jsCamera camera;
+  /**
+   * @brief Time of the scan head in nanoseconds when the source's profile was
+   * taken, `0` if no profile was received from the source for the frame.
+   */
+  uint64_t timestamp_ns;
+  /** @brief The number of points in the `data` array from this source. */
+  uint32_t data_len;
+} jsStitchedSource;
+
+/**
+ * @brief The profiles of every camera of every scan head taken during the
+ * same scan cycle, combined into one contour in the mill coordinate system.
+ */
+typedef struct {
+  /** @brief Time of the earliest profile of the frame in nanoseconds. */
+  uint64_t timestamp_ns;
+  /** @brief Encoder values of the earliest profile of the frame. */
+  int64_t encoder_values[JS_ENCODER_MAX];
+  /** @brief Number of encoder values in this profile. */
+  uint32_t num_encoder_values;
+  /** @brief The number of sources expected in each frame. */
+  uint32_t num_sources;
+  /**
+   * @brief The number of sources that a profile was received from; if less
+   * than `num_sources`, the stitched profile is incomplete.
+   */
+  uint32_t num_sources_received;
+  /** @brief The sources of the frame, ordered by scan head Id and camera. */
+  jsStitchedSource sources[JS_STITCHED_PROFILE_SOURCES_MAX];
+  /** @brief The number of points held in the `data` array. */
+  uint32_t data_len;
+  /** @brief The points of all sources ordered by X. */
+  jsStitchedProfileData data[JS_STITCHED_PROFILE_DATA_LEN];
+} jsStitchedProfile;
+
+/**
+ * @brief Geometry of a cross-section, one frame of profile data from all scan
+ * heads. Lengths are expressed in 1/1000 inches and angles in degrees from
+ * the X axis, within [0, 180). Values that could not be determined, such as
+ * for a cross-section with too few points, are set to `NAN`.
+ */
+typedef struct {
+  /** @brief The number of points in the cross-section. */
+  uint32_t num_points;
+  /** @brief The number of vertices of the convex hull of the points. */
+  uint32_t num_hull_points;
+  /** @brief Area of the convex hull in square 1/1000 inches. */
+  double area;
+  /** @brief Perimeter of the convex hull. */
+  double perimeter;
+  /** @brief The least width of the convex hull between parallel lines. */
+  double min_diameter;
+  /** @brief Direction in which `min_diameter` is measured. */
+  double min_diameter_angle;
+  /** @brief The greatest distance between two points of the convex hull. */
+  double max_diameter;
+  /** @brief Direction in which `max_diameter` is measured. */
+  double max_diameter_angle;
+  /** @brief X coordinate of the center of the best-fit ellipse. */
+  double ellipse_x;
+  /** @brief Y coordinate of the center of the best-fit ellipse. */
+  double ellipse_y;
+  /** @brief Length of the major axis of the best-fit ellipse. */
+  double ellipse_major;
+  /** @brief Length of the minor axis of the best-fit ellipse. */
+  double ellipse_minor;
+  /** @brief Direction of the major axis of the best-fit ellipse. */
+  double ellipse_angle;
+} jsCrossSection;
+
+/**
+ * @brief Settings of the encoder kinematics derived for each profile, see
+ * `jsScanHeadEnableEncoderKinematics`.
+ */
+typedef struct {
+  /**
+   * @brief Time constant in seconds of the low pass filters smoothing the
+   * velocity and acceleration. Set to `0` to disable smoothing.
+   */
+  double time_constant_s;
+  /**
+   * @brief The width in bits of the encoder counters, between `2` and `64`.
+   * Changes in encoder value are taken as the shortest distance around a
+   * counter of this width, in either direction.
+   */
+  uint32_t counter_bits;
+} jsEncoderKinematicsConfig;
+
+/**
+ * @brief The position, velocity and acceleration of each encoder at the time
+ * a profile was taken.
+ */
+typedef struct {
+  /**
+   * @brief The encoder positions, starting from the encoder values of the
+   * first profile of the scan and continuing across counter wraps.
+   */
+  int64_t position[JS_ENCODER_MAX];
+  /**
+   * @brief The encoder velocities in counts per second; negative when the
+   * encoder counts down.
+   */
+  double velocity[JS_ENCODER_MAX];
+  /** @brief The encoder accelerations in counts per second squared. */
+  double acceleration[JS_ENCODER_MAX];
+  /**
+   * @brief Number of encoders in the arrays. Zero if kinematics are not
+   * enabled for the scan head.
+   */
+  uint32_t num_encoder_values;
+} jsEncoderKinematics;
+
+/**
+ * @brief The columns of a raw profile lost with datagrams that were not
+ * received. The values of a profile are dealt out to its datagrams in turn,
+ * so a lost datagram leaves a regular comb of missing columns rather than a
+ * hole.
+ */
+typedef struct {
+  /**
+   * @brief Bitmap of the missing columns; column `n` of the `data` array of
+   * the raw profile is missing if bit `n % 8` of `mask[n / 8]` is set.
+   */
+  uint8_t mask[JS_MISSING_COLUMNS_MASK_LEN];
+  /** @brief The number of missing columns. */
+  uint32_t num_missing;
+} jsMissingColumns;
+
 /**
  * @brief Scan data is returned from the scan head through profiles; each
  * profile returning a single scan line at a given moment in time.
@@ -368,18 +1088,14 @@ typedef struct {
    * profile held in the `data` array.
    */
   uint32_t data_len;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_0;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_1;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_2;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_3;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_4;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_5;
+  /** @brief Summary of the valid X/Y points held in the `data` array. */
+  jsProfileSummary summary;
+  /**
+   * @brief The piece the profile belongs to when presence detection is
+   * enabled, counting from `1` for each scan. `0` if the profile is not part
+   * of a piece or presence detection is disabled.
+   */
+  uint64_t piece_id;
   /** @brief An array of scan line data associated with this profile. */
   jsProfileData data[JS_PROFILE_DATA_LEN];
 } jsProfile;
@@ -444,30 +1160,139 @@ typedef struct {
    * Invalid `x` and `y` will have both set to `JS_PROFILE_DATA_INVALID_XY`.
    */
   uint32_t data_valid_xy;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_0;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_1;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_2;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_3;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_4;
-  /** @brief Reserved for future use. */
-  uint64_t reserved_5;
+  /** @brief Summary of the valid X/Y points held in the `data` array. */
+  jsProfileSummary summary;
+  /**
+   * @brief The piece the profile belongs to when presence detection is
+   * enabled, counting from `1` for each scan. `0` if the profile is not part
+   * of a piece or presence detection is disabled.
+   */
+  uint64_t piece_id;
   /** @brief An array of scan line data associated with this profile. */
   jsProfileData data[JS_RAW_PROFILE_DATA_LEN];
 } jsRawProfile;
 
 /**
- * @brief This structure is used to return a greyscale image capture from the
- * scan head.
+ * @brief A data point of a profile in floating point units, see
+ * `jsScanHeadSetFloatOutput`.
  */
 typedef struct {
-  /** @brief The Id of the scan head that the image originates from. */
-  uint32_t scan_head_id;
-  /** @brief The camera used to capture the image. */
+  /** @brief The X coordinate in the units of the float output. */
+  float x;
+  /** @brief The Y coordinate in the units of the float output. */
+  float y;
+  /**
+   * @brief Measured brightness at given point.
+   * @note If invalid, will be set to `JS_PROFILE_DATA_INVALID_BRIGHTNESS`.
+   */
+  int32_t brightness;
+} jsProfileDataFloat;
+
+/**
+ * @brief A profile holding only its valid points, like `jsProfile`, with the
+ * coordinates in the units of the float output of the scan head.
+ */
+typedef struct {
+  /** @brief The Id of the scan head that the profile originates from. */
+  uint32_t scan_head_id;
+  /** @brief The camera used for the profile. */
+  jsCamera camera;
+  /** @brief The laser used for the profile. */
+  jsLaser laser;
+  /** @brief Time of the scan head in nanoseconds when profile was taken. */
+  uint64_t timestamp_ns;
+  /** @brief Array holding current encoder values. */
+  int64_t encoder_values[JS_ENCODER_MAX];
+  /** @brief Number of encoder values in this profile. */
+  uint32_t num_encoder_values;
+  /** @brief Time in microseconds for the laser emitting. */
+  uint32_t laser_on_time_us;
+  /** @brief The format of the data for the given `jsFloatProfile`. */
+  jsDataFormat format;
+  /** @brief Number of UDP packets received for the profile. */
+  uint32_t udp_packets_received;
+  /** @brief Total number of UDP packets expected to comprise the profile. */
+  uint32_t udp_packets_expected;
+  /**
+   * @brief The total number of valid scan line measurement points for this
+   * profile held in the `data` array.
+   */
+  uint32_t data_len;
+  /**
+   * @brief The piece the profile belongs to when presence detection is
+   * enabled, `0` if none.
+   */
+  uint64_t piece_id;
+  /** @brief An array of scan line data associated with this profile. */
+  jsProfileDataFloat data[JS_PROFILE_DATA_LEN];
+} jsFloatProfile;
+
+/**
+ * @brief A profile with its coordinates in the units of the float output of
+ * the scan head, written to separate arrays of X, Y and brightness values
+ * laid out like the `data` array of `jsRawProfile`. The arrays are provided
+ * by the application, so the profiles of a read can be placed as the rows of
+ * larger matrices.
+ */
+typedef struct {
+  /** @brief The Id of the scan head that the profile originates from. */
+  uint32_t scan_head_id;
+  /** @brief The camera used for the profile. */
+  jsCamera camera;
+  /** @brief The laser used for the profile. */
+  jsLaser laser;
+  /** @brief Time of the scan head in nanoseconds when profile was taken. */
+  uint64_t timestamp_ns;
+  /** @brief Array holding current encoder values. */
+  int64_t encoder_values[JS_ENCODER_MAX];
+  /** @brief Number of encoder values in this profile. */
+  uint32_t num_encoder_values;
+  /** @brief Time in microseconds for the laser emitting. */
+  uint32_t laser_on_time_us;
+  /** @brief The format of the data held in the arrays. */
+  jsDataFormat format;
+  /** @brief Number of UDP packets received for the profile. */
+  uint32_t udp_packets_received;
+  /** @brief Total number of UDP packets expected to comprise the profile. */
+  uint32_t udp_packets_expected;
+  /**
+   * @brief The length of the data held in the arrays, at most
+   * `JS_RAW_PROFILE_DATA_LEN`.
+   */
+  uint32_t data_len;
+  /** @brief Number of `x` and `y` values in the arrays that are valid. */
+  uint32_t data_valid_xy;
+  /**
+   * @brief The piece the profile belongs to when presence detection is
+   * enabled, `0` if none.
+   */
+  uint64_t piece_id;
+  /**
+   * @brief Set by the application to an array of `JS_RAW_PROFILE_DATA_LEN`
+   * entries to be updated with the X coordinates; invalid entries are NaN.
+   */
+  float *x;
+  /**
+   * @brief Set by the application to an array of `JS_RAW_PROFILE_DATA_LEN`
+   * entries to be updated with the Y coordinates; invalid entries are NaN.
+   */
+  float *y;
+  /**
+   * @brief Set by the application to an array of `JS_RAW_PROFILE_DATA_LEN`
+   * entries to be updated with the brightness values, or `NULL` if not
+   * needed; invalid entries are `JS_PROFILE_DATA_INVALID_BRIGHTNESS`.
+   */
+  int32_t *brightness;
+} jsFloatProfileArrays;
+
+/**
+ * @brief This structure is used to return a greyscale image capture from the
+ * scan head.
+ */
+typedef struct {
+  /** @brief The Id of the scan head that the image originates from. */
+  uint32_t scan_head_id;
+  /** @brief The camera used to capture the image. */
   jsCamera camera;
   /** @brief Time of the scan head in nanoseconds when image was taken. */
   uint64_t timestamp_ns;
@@ -515,6 +1340,17 @@ void jsGetAPIVersion(const char **version_str);
 EXPORTED
 void jsGetAPISemanticVersion(uint32_t *major, uint32_t *minor, uint32_t *patch);
 
+/**
+ * @brief Obtains the CPU instruction set selected at runtime for decoding
+ * profile data. This is informational; profile data is identical regardless
+ * of the variant in use.
+ *
+ * @param variant Address to be updated with the selected variant.
+ * @param variant_str Address to be updated with the variant name.
+ */
+EXPORTED
+void jsGetSimdVariant(jsSimdVariant *variant, const char **variant_str);
+
 /**
  * @brief Converts a `jsError` error value returned from an API function call
  * to a string value.
@@ -525,6 +1361,15 @@ void jsGetAPISemanticVersion(uint32_t *major, uint32_t *minor, uint32_t *patch);
 EXPORTED
 void jsGetError(int32_t return_code, const char **error_str);
 
+/**
+ * @brief Obtains the time of the host's monotonic clock, the clock that scan
+ * head timestamps are converted to by `jsScanHeadConvertTimestamp`.
+ *
+ * @return The host time in nanoseconds.
+ */
+EXPORTED
+uint64_t jsGetHostTime(void);
+
 /**
  * @brief Obtains the capabilities for a given scan head type.
  *
@@ -662,7 +1507,8 @@ double jsScanSystemGetMaxScanRate(jsScanSystem scan_system);
  *
  * @param scan_system Reference to system of scan heads.
  * @param rate_hz The scan rate at hertz by which profiles are generated.
- * @param fmt The data format of the returned scan profile data.
+ * @param fmt The data format of the returned scan profile data; the subpixel
+ * formats require a mapping table for every camera of every scan head.
  * @return `0` on success, negative value mapping to `jsError` on error.
  */
 EXPORTED
@@ -678,6 +1524,48 @@ int32_t jsScanSystemStartScanning(jsScanSystem scan_system, double rate_hz,
 EXPORTED
 int32_t jsScanSystemStopScanning(jsScanSystem scan_system);
 
+/**
+ * @brief Commands scan heads in system to take a fixed number of scans and
+ * then stop on their own, without the client keeping the scan alive. The
+ * system is in a scanning state until the burst completes; a new burst may
+ * be started as soon as all scan heads completed the previous one, without
+ * calling `jsScanSystemStopScanning`. Profiles of the previous burst that
+ * have not been read yet remain available when a burst is chained this way;
+ * otherwise any unread profiles are discarded when the burst starts.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param rate_hz The scan rate for the scan heads.
+ * @param fmt The data format of the profiles; the subpixel formats require a
+ * mapping table for every camera of every scan head.
+ * @param num_scans The number of scans each scan head takes; each scan
+ * yields one profile, or one profile per camera for scan heads whose cameras
+ * expose simultaneously, see `jsScanHeadSetCameraExposureMode`.
+ * @return `0` on success, negative value `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemStartBurst(jsScanSystem scan_system, double rate_hz,
+                               jsDataFormat fmt, uint32_t num_scans);
+
+/**
+ * @brief Blocks until all scan heads completed the current burst or the
+ * timeout expires, and reports the progress of each scan head. If all scan
+ * heads completed, the system leaves the scanning state. The profiles of the
+ * burst are read out as usual, such as with `jsScanHeadGetProfiles`.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param timeout_us Maximum amount of time to wait for in microseconds.
+ * @param status Array to be updated with the progress of each scan head, in
+ * order of scan head Id.
+ * @param max_status The maximum number of entries of `status` to update.
+ * @return The number of scan heads that completed the burst on success,
+ * negative value `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemWaitUntilBurstComplete(jsScanSystem scan_system,
+                                           uint32_t timeout_us,
+                                           jsBurstStatus *status,
+                                           uint32_t max_status);
+
 /**
  * @brief Gets scanning state for a scan system.
  *
@@ -687,6 +1575,151 @@ int32_t jsScanSystemStopScanning(jsScanSystem scan_system);
 EXPORTED
 bool jsScanSystemIsScanning(jsScanSystem scan_system);
 
+/**
+ * @brief Enables stitching the profiles of all scan heads into a single
+ * contour. While scanning, the profiles of every camera of every scan head
+ * taken during the same scan cycle are grouped into a frame. Once the last
+ * profile of a frame is received, the frame is stitched on the receiving
+ * thread and made available through `jsScanSystemGetStitchedProfiles`; a
+ * frame missing a profile is stitched once profiles two frames later arrive.
+ * A scan cycle is one scan period if the cameras of the scan heads expose
+ * simultaneously and one scan period per camera otherwise; all scan heads
+ * must use the same mode, see `jsScanHeadSetCameraExposureMode`, or scanning
+ * fails to start with `JS_ERROR_INVALID_ARGUMENT`. Profiles remain available
+ * through `jsScanHeadGetProfiles` as well.
+ *
+ * @note The scan heads must be synchronized so that their timestamps share
+ * the same time base.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param rule The rule used to resolve points where sources overlap.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemEnableStitching(jsScanSystem scan_system,
+                                    jsStitchOverlapRule rule);
+
+/**
+ * @brief Disables stitching the profiles of all scan heads.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemDisableStitching(jsScanSystem scan_system);
+
+/**
+ * @brief Obtains the number of stitched profiles currently available to be
+ * read out.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @return The number of stitched profiles on success, negative value mapping
+ * to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetStitchedProfilesAvailable(jsScanSystem scan_system);
+
+/**
+ * @brief Reads stitched profiles out of the scan system in frame order. The
+ * number of profiles returned is either the max value requested or the total
+ * number of profiles ready to be read out, whichever is less.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param profiles Pointer to memory to store stitched profile data. Note, the
+ * memory pointed to by `profiles` must be at least
+ * `sizeof(jsStitchedProfile) * max` in total number of bytes available.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetStitchedProfiles(jsScanSystem scan_system,
+                                        jsStitchedProfile *profiles,
+                                        uint32_t max_profiles);
+
+/**
+ * @brief Reads profiles out of all scan heads being scanned, merged in
+ * timestamp order. A profile is only read once every scan head has sent a
+ * profile at least as new, so a later call never returns a profile older
+ * than one already read. A scan head whose profiles lag those of the newest
+ * scan head by more than one second, such as one that stopped sending
+ * profiles or never started to, is not waited for; profiles it sends late
+ * may then be older than ones already read. Profiles read are removed from
+ * their scan head, as with `jsScanHeadGetProfiles`.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param profiles Pointer to memory to store profile data. Note, the memory
+ * pointed to by `profiles` must be at least `sizeof(jsProfile) * max` in total
+ * number of bytes available.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetProfiles(jsScanSystem scan_system, jsProfile *profiles,
+                                uint32_t max_profiles);
+
+/**
+ * @brief Reads raw profiles out of all scan heads being scanned, merged in
+ * timestamp order. A profile is only read once every scan head has sent a
+ * profile at least as new, so a later call never returns a profile older
+ * than one already read; if a scan head stops sending profiles, no further
+ * profiles are read until scanning is restarted. Profiles read are removed
+ * from their scan head, as with `jsScanHeadGetRawProfiles`.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param profiles Pointer to memory to store profile data. Note, the memory
+ * pointed to by `profiles` must be at least `sizeof(jsRawProfile) * max` in
+ * total number of bytes available.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetRawProfiles(jsScanSystem scan_system,
+                                   jsRawProfile *profiles,
+                                   uint32_t max_profiles);
+
+/**
+ * @brief Obtains the number of events of a scan system waiting to be read.
+ * Events are posted without blocking by the threads receiving data, so
+ * reading them adds no latency to scanning; they are kept across connecting
+ * and scanning until read.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @return The number of events on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetEventsAvailable(jsScanSystem scan_system);
+
+/**
+ * @brief Blocks until an event of a scan system is waiting to be read or
+ * the timeout expires.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param timeout_us Maximum amount of time to wait for in microseconds.
+ * @return The number of events on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemWaitUntilEventsAvailable(jsScanSystem scan_system,
+                                             uint32_t timeout_us);
+
+/**
+ * @brief Reads the events of a scan system, oldest first.
+ *
+ * @param scan_system Reference to system of scan heads.
+ * @param events Pointer to memory to store the events.
+ * @param max_events The maximum number of events to read. Should not exceed
+ * `JS_SYSTEM_EVENTS_MAX`.
+ * @return The number of events read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanSystemGetEvents(jsScanSystem scan_system, jsSystemEvent *events,
+                              uint32_t max_events);
+
 /**
  * @brief Obtains the ID of the scan head.
  *
@@ -800,6 +1833,35 @@ int32_t jsScanHeadSetWindowRectangular(jsScanHead scan_head, double window_top,
                                        double window_bottom, double window_left,
                                        double window_right);
 
+/**
+ * @brief Sets whether the cameras of a scan head take their profiles in turn
+ * or together. Exposing together takes the profiles of both cameras at the
+ * same time, so each scan yields one profile per camera rather than one
+ * profile from the next camera in turn. The maximum scan rate reported by
+ * `jsScanSystemGetMaxScanRate` is unchanged by the mode. Scan heads default
+ * to interleaved exposure.
+ *
+ * @note The mode is sent to the scan head when scanning starts.
+ *
+ * @param scan_head Reference to scan head.
+ * @param mode The camera exposure mode.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadSetCameraExposureMode(jsScanHead scan_head,
+                                        jsCameraExposureMode mode);
+
+/**
+ * @brief Obtains whether the cameras of a scan head take their profiles in
+ * turn or together, see `jsScanHeadSetCameraExposureMode`.
+ *
+ * @param scan_head Reference to scan head.
+ * @return The `jsCameraExposureMode` on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetCameraExposureMode(jsScanHead scan_head);
+
 /**
  * @brief Obtains the number of profiles currently available to be read out from
  * a given scan head.
@@ -864,32 +1926,988 @@ int32_t jsScanHeadGetRawProfiles(jsScanHead scan_head, jsRawProfile *profiles,
                                  uint32_t max_profiles);
 
 /**
- * @brief Obtains a single camera image from a scan head.
+ * @brief Obtains the number of profiles from a camera and laser pair that are
+ * currently available to be read out from a given scan head. Profiles of each
+ * pair are queued separately, so each pair can be read on its own thread.
  *
- * @note This function should be called after `jsScanSystemConnect()`, but
- * not while the system is set to scan by calling
- * `jsScanSystemStartScanning()`.
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the profiles.
+ * @param laser The laser of the profiles.
+ * @return The number of profiles able to be read on success, negative value
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetSourceProfilesAvailable(jsScanHead scan_head,
+                                             jsCamera camera, jsLaser laser);
+
+/**
+ * @brief Blocks until the number of requested profiles from a camera and
+ * laser pair are available to be read out from a given scan head.
  *
  * @param scan_head Reference to scan head.
- * @param camera Camera to use for image capture.
- * @param enable_lasers Set to `true` to turn on laser for image capture,
- * `false` to keep laser off.
- * @param image Pointer to memory to store camera image data.
+ * @param camera The camera of the profiles.
+ * @param laser The laser of the profiles.
+ * @param count The number of profiles to wait for. Should not exceed
+ * `JS_SCAN_HEAD_PROFILES_MAX`.
+ * @param timeout_us Maximum amount of time to wait for in microseconds.
+ * @return The number of profiles able to be read on success, negative value
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadWaitUntilSourceProfilesAvailable(jsScanHead scan_head,
+                                                   jsCamera camera,
+                                                   jsLaser laser,
+                                                   uint32_t count,
+                                                   uint32_t timeout_us);
+
+/**
+ * @brief Reads `jsProfile` formatted profile data from a camera and laser
+ * pair of a given scan head, leaving the profiles of other pairs to be read.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the profiles.
+ * @param laser The laser of the profiles.
+ * @param profiles Pointer to memory to store profile data. Note, the memory
+ * pointed to by `profiles` must be at least `sizeof(jsProfile) * max` in
+ * total number of bytes available.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetSourceProfiles(jsScanHead scan_head, jsCamera camera,
+                                    jsLaser laser, jsProfile *profiles,
+                                    uint32_t max_profiles);
+
+/**
+ * @brief Reads `jsRawProfile` formatted profile data from a camera and laser
+ * pair of a given scan head, leaving the profiles of other pairs to be read.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the profiles.
+ * @param laser The laser of the profiles.
+ * @param profiles Pointer to memory to store profile data. Note, the memory
+ * pointed to by `profiles` must be at least `sizeof(jsRawProfile) * max` in
+ * total number of bytes available.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetSourceRawProfiles(jsScanHead scan_head, jsCamera camera,
+                                       jsLaser laser, jsRawProfile *profiles,
+                                       uint32_t max_profiles);
+
+/**
+ * @brief Enables deriving the position, velocity and acceleration of each
+ * encoder as profiles are received from a scan head. They are computed from
+ * the encoder values and timestamps of consecutive profiles and are read out
+ * along with the profiles by `jsScanHeadGetProfilesKinematics` and
+ * `jsScanHeadGetRawProfilesKinematics`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The filter settings.
  * @return `0` on success, negative value mapping to `jsError` on error.
  */
 EXPORTED
-int32_t jsScanHeadGetCameraImage(jsScanHead scan_head, jsCamera camera,
-                                 bool enable_lasers, jsCameraImage *image);
+int32_t jsScanHeadEnableEncoderKinematics(
+  jsScanHead scan_head, const jsEncoderKinematicsConfig *config);
 
 /**
- * @brief Reads the last reported status update from a scan head.
+ * @brief Disables deriving encoder kinematics for a scan head.
  *
  * @param scan_head Reference to scan head.
- * @param status Pointer to be updated with status contents.
  * @return `0` on success, negative value mapping to `jsError` on error.
  */
 EXPORTED
-int32_t jsScanHeadGetStatus(jsScanHead scan_head, jsScanHeadStatus *status);
+int32_t jsScanHeadDisableEncoderKinematics(jsScanHead scan_head);
+
+/**
+ * @brief Reads `jsProfile` formatted profile data from a given scan head along
+ * with the encoder kinematics of each profile, like `jsScanHeadGetProfiles`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param profiles Pointer to memory to store profile data.
+ * @param kinematics Array of `max_profiles` entries to be updated with the
+ * encoder kinematics of each profile read.
+ * @param max_profiles The maximum number of profiles to read. Should not
+ * exceed `JS_SCAN_HEAD_PROFILES_MAX`.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetProfilesKinematics(jsScanHead scan_head,
+                                        jsProfile *profiles,
+                                        jsEncoderKinematics *kinematics,
+                                        uint32_t max_profiles);
+
+/**
+ * @brief Reads `jsRawProfile` formatted profile data from a given scan head
+ * along with the encoder kinematics of each profile, like
+ * `jsScanHeadGetRawProfiles`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param profiles Pointer to memory to store profile data.
+ * @param kinematics Array of `max_profiles` entries to be updated with the
+ * encoder kinematics of each profile read.
+ * @param max_profiles The maximum number of profiles to read. Should not
+ * exceed `JS_SCAN_HEAD_PROFILES_MAX`.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetRawProfilesKinematics(jsScanHead scan_head,
+                                           jsRawProfile *profiles,
+                                           jsEncoderKinematics *kinematics,
+                                           uint32_t max_profiles);
+
+/**
+ * @brief Reads `jsRawProfile` formatted profile data from a given scan head
+ * along with the columns of each profile lost with its missing datagrams,
+ * like `jsScanHeadGetRawProfiles`. A profile with `udp_packets_received`
+ * equal to `udp_packets_expected` has no missing columns.
+ *
+ * @param scan_head Reference to scan head.
+ * @param profiles Pointer to memory to store profile data.
+ * @param missing Array of `max_profiles` entries to be updated with the
+ * missing columns of each profile read.
+ * @param max_profiles The maximum number of profiles to read. Should not
+ * exceed `JS_SCAN_HEAD_PROFILES_MAX`.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetRawProfilesMissingColumns(jsScanHead scan_head,
+                                               jsRawProfile *profiles,
+                                               jsMissingColumns *missing,
+                                               uint32_t max_profiles);
+
+/**
+ * @brief Repairs the columns of a raw profile lost with missing datagrams by
+ * linear interpolation between the valid columns on either side of each run
+ * of missing columns. Columns that were received are never changed and runs
+ * next to an invalid column are left invalid. The `summary` of the profile
+ * still describes only the points received.
+ *
+ * @param profile The raw profile to repair.
+ * @param missing The missing columns of the profile, as read with
+ * `jsScanHeadGetRawProfilesMissingColumns`.
+ * @param max_gap The longest run of consecutive missing values to fill; a
+ * single lost datagram leaves runs of `1`.
+ * @return The number of columns filled on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsRawProfileInterpolateMissingColumns(jsRawProfile *profile,
+                                              const jsMissingColumns *missing,
+                                              uint32_t max_gap);
+
+/**
+ * @brief Enables segmenting the profiles of a scan head into pieces as they
+ * are received. Each profile is tested against the criteria of `config`
+ * using statistics gathered while it is decoded; a piece starts and ends
+ * after enough consecutive profiles do and don't meet them. A profile counts
+ * as seeing a piece if it or the latest profile of any other camera and laser
+ * of the scan head does, so a piece seen by only one camera is not broken up
+ * by the profiles of the others. The profiles of a piece are given its
+ * `piece_id`, and profiles outside pieces can be discarded before they are
+ * buffered, so that idle periods cost nothing to read out.
+ *
+ * @note Profiles are held back until `start_count` profiles confirm a piece;
+ * if the scan head stops scanning first, they are released as profiles
+ * outside of a piece.
+ * Profiles discarded by `suppress_empty` aren't stitched, so stitched profiles
+ * may be missing their sources.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The presence detection settings.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnablePresenceDetection(jsScanHead scan_head,
+                                          const jsPresenceConfig *config);
+
+/**
+ * @brief Disables segmenting the profiles of a scan head into pieces.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisablePresenceDetection(jsScanHead scan_head);
+
+/**
+ * @brief Reads the piece start and end events of a scan head, oldest first.
+ * Events are cleared when scanning starts.
+ *
+ * @param scan_head Reference to scan head.
+ * @param events Pointer to memory to store the events.
+ * @param max_events The maximum number of events to read. Should not exceed
+ * `JS_PIECE_EVENTS_MAX`.
+ * @return The number of events read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetPieceEvents(jsScanHead scan_head, jsPieceEvent *events,
+                                 uint32_t max_events);
+
+/**
+ * @brief Enables retaining the most recent profiles of a scan head, so they
+ * can be looked up after they have been read out. Profiles are retained as
+ * they are received, sharing their memory with the profiles waiting to be
+ * read, and the history is cleared when scanning starts.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The bounds of the history.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnableHistory(jsScanHead scan_head,
+                                const jsHistoryConfig *config);
+
+/**
+ * @brief Disables retaining profiles for a scan head, releasing the profiles
+ * retained.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisableHistory(jsScanHead scan_head);
+
+/**
+ * @brief Reads the retained profiles of a scan head taken within a range of
+ * time, leaving them in the history.
+ *
+ * @param scan_head Reference to scan head.
+ * @param min_timestamp_ns The earliest timestamp to read, inclusive.
+ * @param max_timestamp_ns The latest timestamp to read, inclusive.
+ * @param profiles Pointer to memory to store profile data.
+ * @param max_profiles The maximum number of profiles to read; if more
+ * profiles are within the range, the oldest are read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetHistoryByTime(jsScanHead scan_head,
+                                   uint64_t min_timestamp_ns,
+                                   uint64_t max_timestamp_ns,
+                                   jsProfile *profiles, uint32_t max_profiles);
+
+/**
+ * @brief Reads the retained raw profiles of a scan head taken within a range
+ * of time, leaving them in the history.
+ *
+ * @param scan_head Reference to scan head.
+ * @param min_timestamp_ns The earliest timestamp to read, inclusive.
+ * @param max_timestamp_ns The latest timestamp to read, inclusive.
+ * @param profiles Pointer to memory to store profile data.
+ * @param max_profiles The maximum number of profiles to read; if more
+ * profiles are within the range, the oldest are read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetRawHistoryByTime(jsScanHead scan_head,
+                                      uint64_t min_timestamp_ns,
+                                      uint64_t max_timestamp_ns,
+                                      jsRawProfile *profiles,
+                                      uint32_t max_profiles);
+
+/**
+ * @brief Reads the retained profiles of a scan head taken with the value of an
+ * encoder within a range, leaving them in the history. Profiles are read in
+ * timestamp order.
+ *
+ * @param scan_head Reference to scan head.
+ * @param encoder The encoder to compare.
+ * @param min_value The least encoder value to read, inclusive.
+ * @param max_value The greatest encoder value to read, inclusive.
+ * @param profiles Pointer to memory to store profile data.
+ * @param max_profiles The maximum number of profiles to read; if more
+ * profiles are within the range, the oldest are read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetHistoryByEncoder(jsScanHead scan_head, jsEncoder encoder,
+                                      int64_t min_value, int64_t max_value,
+                                      jsProfile *profiles,
+                                      uint32_t max_profiles);
+
+/**
+ * @brief Reads the retained raw profiles of a scan head taken with the value
+ * of an encoder within a range, leaving them in the history. Profiles are
+ * read in timestamp order.
+ *
+ * @param scan_head Reference to scan head.
+ * @param encoder The encoder to compare.
+ * @param min_value The least encoder value to read, inclusive.
+ * @param max_value The greatest encoder value to read, inclusive.
+ * @param profiles Pointer to memory to store profile data.
+ * @param max_profiles The maximum number of profiles to read; if more
+ * profiles are within the range, the oldest are read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetRawHistoryByEncoder(jsScanHead scan_head,
+                                         jsEncoder encoder, int64_t min_value,
+                                         int64_t max_value,
+                                         jsRawProfile *profiles,
+                                         uint32_t max_profiles);
+
+/**
+ * @brief Enables keeping the newest profile from each camera and laser pair
+ * of a scan head, so it can be read without reading out the profiles queued
+ * before it. The queued profiles are still delivered to the functions that
+ * read them, such as `jsScanHeadGetProfiles`.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnableLatestProfile(jsScanHead scan_head);
+
+/**
+ * @brief Disables keeping the newest profiles of a scan head.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisableLatestProfile(jsScanHead scan_head);
+
+/**
+ * @brief Reads the newest profile from a camera and laser pair of a scan
+ * head, leaving it and the queued profiles in place. Never blocks; the same
+ * profile is read again until a newer one is received.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the profile.
+ * @param laser The laser of the profile.
+ * @param profile Pointer to memory to store profile data.
+ * @return `1` if a profile was read, `0` if none was received since scanning
+ * started, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetLatestProfile(jsScanHead scan_head, jsCamera camera,
+                                   jsLaser laser, jsProfile *profile);
+
+/**
+ * @brief Reads the newest raw profile from a camera and laser pair of a scan
+ * head, leaving it and the queued profiles in place. Never blocks; the same
+ * profile is read again until a newer one is received.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the profile.
+ * @param laser The laser of the profile.
+ * @param profile Pointer to memory to store profile data.
+ * @return `1` if a profile was read, `0` if none was received since scanning
+ * started, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetRawLatestProfile(jsScanHead scan_head, jsCamera camera,
+                                      jsLaser laser, jsRawProfile *profile);
+
+/**
+ * @brief Enables counting the valid points of a scan head by camera column
+ * and by bin of the mill coordinate system, to find columns and areas of the
+ * mill that never see anything. Counting is cheap enough to leave enabled
+ * during production and continues across scans until reset.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The bins of the mill coordinate system.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnableValidityHeatmap(jsScanHead scan_head,
+                                        const jsValidityHeatmapConfig *config);
+
+/**
+ * @brief Disables counting the valid points of a scan head, releasing the
+ * counts.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisableValidityHeatmap(jsScanHead scan_head);
+
+/**
+ * @brief Reads the counts of valid points of a scan head, optionally
+ * clearing them at the same time so consecutive reads cover consecutive
+ * intervals without gaps. May be called while scanning.
+ *
+ * @param scan_head Reference to scan head.
+ * @param heatmap Pointer to memory to store the counts by camera column.
+ * @param bins Array to be updated with the counts by bin, by row of Y then
+ * column of X; the bin at X index `i` and Y index `j` is at
+ * `j * num_x_bins + i`. May be null if `max_bins` is `0`.
+ * @param max_bins The maximum number of entries of `bins` to update.
+ * @param reset Set to `true` to clear the counts after reading them.
+ * @return The number of entries of `bins` updated on success, negative value
+ * mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetValidityHeatmap(jsScanHead scan_head,
+                                     jsValidityHeatmap *heatmap,
+                                     uint64_t *bins, uint32_t max_bins,
+                                     bool reset);
+
+/**
+ * @brief Proposes the smallest rectangular scan window and camera column
+ * ranges covering the valid points counted by the validity heatmap of a scan
+ * head, see `jsScanHeadEnableValidityHeatmap`. Each of the four sides of the
+ * window drops at most a quarter of the points allowed to fall outside of it,
+ * so the window holds at least the requested coverage; the resolution of the
+ * window is the bin size of the heatmap.
+ *
+ * @note The proposal is not applied; the window is applied by passing it to
+ * `jsScanHeadSetWindowRectangular` before connecting, such as during a gap
+ * between pieces with scanning stopped. The column ranges are reported to
+ * judge how much of the camera is used and are not configurable.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The coverage and margins of the proposal.
+ * @param proposal Pointer to memory to store the proposal.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadProposeWindow(jsScanHead scan_head,
+                                const jsWindowProposalConfig *config,
+                                jsWindowProposal *proposal);
+
+/**
+ * @brief Enables smoothing the Y values of each camera column over successive
+ * profiles of the same camera and laser, to remove surface noise that varies
+ * from profile to profile. The filter runs as profiles are received and the
+ * profiles read out hold the filtered values. A column starts over when it
+ * has no valid point, when its value jumps by more than the reset distance
+ * and when a new piece starts, see `jsScanHeadEnablePresenceDetection`.
+ *
+ * @note The summary of a profile is computed from the filtered values. The
+ * filter can not be enabled while float output is, see
+ * `jsScanHeadSetFloatOutput`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The filter and its settings.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnableTemporalFilter(jsScanHead scan_head,
+                                       const jsTemporalFilterConfig *config);
+
+/**
+ * @brief Disables smoothing the Y values of a scan head over successive
+ * profiles.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisableTemporalFilter(jsScanHead scan_head);
+
+/**
+ * @brief Enables resampling each profile of a scan head onto a grid of evenly
+ * spaced X coordinates, see `jsProfilesResample`. Profiles are resampled as
+ * they are received, after the temporal filter if it is enabled; entry `i`
+ * of the data of the profiles read out holds the grid point at
+ * `x_start + i * x_step`, up to `num_points` entries.
+ *
+ * @note The summary of a profile is computed from the grid points. The
+ * missing columns of a profile, see `jsScanHeadGetRawProfilesMissingColumns`,
+ * remain camera columns and do not apply to the grid. Resampling can not be
+ * enabled while float output is, see `jsScanHeadSetFloatOutput`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param config The grid to resample onto.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadEnableResampling(jsScanHead scan_head,
+                                   const jsResampleConfig *config);
+
+/**
+ * @brief Disables resampling the profiles of a scan head.
+ *
+ * @param scan_head Reference to scan head.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadDisableResampling(jsScanHead scan_head);
+
+/**
+ * @brief Sets the units of the float output of a scan head. The camera to
+ * mill transform of each point decoded is converted straight to floating
+ * point in these units, without first being truncated to 1/1000 inches, and
+ * can be read out with `jsScanHeadGetFloatProfiles` or
+ * `jsScanHeadGetFloatProfileArrays`.
+ *
+ * @note Float output can not be combined with the temporal filter or with
+ * resampling, which change the integer data after it is decoded.
+ *
+ * @param scan_head Reference to scan head.
+ * @param units_per_inch The number of output units in an inch, such as
+ * `25.4` for millimetres; `0` to disable float output.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadSetFloatOutput(jsScanHead scan_head, double units_per_inch);
+
+/**
+ * @brief Reads `jsFloatProfile` formatted profile data from a given scan
+ * head. Profiles are taken from the same queue as `jsScanHeadGetProfiles`;
+ * profiles received while float output was disabled hold no points.
+ *
+ * @param scan_head Reference to scan head.
+ * @param profiles Pointer to memory to store profile data, at least
+ * `sizeof(jsFloatProfile) * max_profiles` bytes.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetFloatProfiles(jsScanHead scan_head,
+                                   jsFloatProfile *profiles,
+                                   uint32_t max_profiles);
+
+/**
+ * @brief Reads profile data from a given scan head into separate arrays of
+ * X, Y and brightness values, see `jsFloatProfileArrays`. Profiles are taken
+ * from the same queue as `jsScanHeadGetProfiles`; profiles received while
+ * float output was disabled hold no valid points.
+ *
+ * @param scan_head Reference to scan head.
+ * @param profiles Array of `max_profiles` entries, each with its arrays set,
+ * to be updated with the profiles read.
+ * @param max_profiles The maximum number of profiles to read.
+ * @return The number of profiles read on success, negative value mapping to
+ * `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetFloatProfileArrays(jsScanHead scan_head,
+                                        jsFloatProfileArrays *profiles,
+                                        uint32_t max_profiles);
+
+/**
+ * @brief Reads the mapping table of a camera of a scan head, such as to
+ * apply corrections to it before setting it again with
+ * `jsScanHeadSetMappingTable`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the table.
+ * @param table Pointer to memory to store the description of the table; its
+ * dimensions are `0` if the camera has no table.
+ * @param x Array to be updated with the X entries of the table, may be null
+ * if `max_entries` is `0`.
+ * @param y Array to be updated with the Y entries of the table, may be null
+ * if `max_entries` is `0`.
+ * @param max_entries The maximum number of entries to read into each array.
+ * @return The number of entries read into each array on success, negative
+ * value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetMappingTable(jsScanHead scan_head, jsCamera camera,
+                                  jsMappingTable *table, float *x, float *y,
+                                  uint32_t max_entries);
+
+/**
+ * @brief Sets the mapping table of a camera of a scan head, replacing any
+ * table set before. The tables are kept in the API and used to compute the
+ * geometry of profiles scanned with the subpixel data formats, such as
+ * `JS_DATA_FORMAT_SUBPIXEL_FULL`, as they are received; they must not be set
+ * while scanning.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera The camera of the table.
+ * @param table The description of the table.
+ * @param x The `num_columns * num_rows` X entries of the table.
+ * @param y The `num_columns * num_rows` Y entries of the table.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadSetMappingTable(jsScanHead scan_head, jsCamera camera,
+                                  const jsMappingTable *table, const float *x,
+                                  const float *y);
+
+/**
+ * @brief Obtains a single camera image from a scan head.
+ *
+ * @note This function should be called after `jsScanSystemConnect()`, but
+ * not while the system is set to scan by calling
+ * `jsScanSystemStartScanning()`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param camera Camera to use for image capture.
+ * @param enable_lasers Set to `true` to turn on laser for image capture,
+ * `false` to keep laser off.
+ * @param image Pointer to memory to store camera image data.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetCameraImage(jsScanHead scan_head, jsCamera camera,
+                                 bool enable_lasers, jsCameraImage *image);
+
+/**
+ * @brief Reads the last reported status update from a scan head.
+ *
+ * @param scan_head Reference to scan head.
+ * @param status Pointer to be updated with status contents.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetStatus(jsScanHead scan_head, jsScanHeadStatus *status);
+
+/**
+ * @brief Reads the current estimate of the relation between a scan head's
+ * clock and the host's clock, along with the arrival latency and interval
+ * statistics of its profiles for the current connection.
+ *
+ * @param scan_head Reference to scan head.
+ * @param clock Pointer to be updated with the clock estimate.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsScanHeadGetClock(jsScanHead scan_head, jsScanHeadClock *clock);
+
+/**
+ * @brief Converts a timestamp of a scan head, such as the `timestamp_ns` of
+ * a `jsProfile`, to the host time returned by `jsGetHostTime`.
+ *
+ * @param scan_head Reference to scan head.
+ * @param timestamp_ns The scan head timestamp to convert.
+ * @param host_time_ns Address to be updated with the host time.
+ * @param error_ns Address to be updated with the bound of the error of the
+ * host time in nanoseconds.
+ * @return `0` on success, `JS_ERROR_NOT_CONNECTED` if no time reference has
+ * been received from the scan head, other negative value mapping to `jsError`
+ * on error.
+ */
+EXPORTED
+int32_t jsScanHeadConvertTimestamp(jsScanHead scan_head, uint64_t timestamp_ns,
+                                   uint64_t *host_time_ns, uint64_t *error_ns);
+
+/**
+ * @brief Finds the highest point, the point with the greatest Y coordinate,
+ * within a region for each profile of an array. If several points share the
+ * greatest Y coordinate, the first of them in the `data` array is used.
+ *
+ * @param profiles Array of profiles to search.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to search within.
+ * @param points Array of `num_profiles` entries to be updated with the highest
+ * point of each profile. If a profile has no points within the region, its
+ * entry has `x` and `y` set to `JS_PROFILE_DATA_INVALID_XY`.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetHighestPoint(const jsProfile *profiles,
+                                  uint32_t num_profiles,
+                                  const jsRegion *region, jsProfileData *points);
+
+/**
+ * @brief Finds the lowest point, the point with the least Y coordinate,
+ * within a region for each profile of an array. If several points share the
+ * least Y coordinate, the first of them in the `data` array is used.
+ *
+ * @param profiles Array of profiles to search.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to search within.
+ * @param points Array of `num_profiles` entries to be updated with the lowest
+ * point of each profile. If a profile has no points within the region, its
+ * entry has `x` and `y` set to `JS_PROFILE_DATA_INVALID_XY`.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetLowestPoint(const jsProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 jsProfileData *points);
+
+/**
+ * @brief Counts the points within a region for each profile of an array.
+ *
+ * @param profiles Array of profiles to count points of.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to count points within.
+ * @param counts Array of `num_profiles` entries to be updated with the number
+ * of points of each profile within the region.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetPointCount(const jsProfile *profiles,
+                                uint32_t num_profiles, const jsRegion *region,
+                                uint32_t *counts);
+
+/**
+ * @brief Calculates the centroid of the points within a region for each
+ * profile of an array. For data formats including brightness, each point is
+ * weighted by its measured brightness; otherwise all points are weighted
+ * equally.
+ *
+ * @param profiles Array of profiles to calculate the centroid of.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to consider points within.
+ * @param centroid_x Array of `num_profiles` entries to be updated with the X
+ * coordinate of each centroid in 1/1000 inches. Set to `NAN` if a profile has
+ * no points within the region.
+ * @param centroid_y Array of `num_profiles` entries to be updated with the Y
+ * coordinate of each centroid in 1/1000 inches. Set to `NAN` if a profile has
+ * no points within the region.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetCentroid(const jsProfile *profiles, uint32_t num_profiles,
+                              const jsRegion *region, double *centroid_x,
+                              double *centroid_y);
+
+/**
+ * @brief Calculates the area between the profile and a reference line for
+ * each profile of an array. The profile is treated as a polyline joining
+ * consecutive points of the `data` array; only segments with both ends within
+ * the region contribute. Area above the reference line is positive, area
+ * below it is negative.
+ *
+ * @param profiles Array of profiles to calculate the area of.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to consider points within.
+ * @param slope The slope of the reference line.
+ * @param intercept The Y coordinate of the reference line at X of zero,
+ * expressed in 1/1000 inches.
+ * @param areas Array of `num_profiles` entries to be updated with the area of
+ * each profile, expressed in square 1/1000 inches.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetArea(const jsProfile *profiles, uint32_t num_profiles,
+                          const jsRegion *region, double slope,
+                          double intercept, double *areas);
+
+/**
+ * @brief Same as `jsProfilesGetHighestPoint`, operating on `jsRawProfile`
+ * formatted profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesGetHighestPoint(const jsRawProfile *profiles,
+                                     uint32_t num_profiles,
+                                     const jsRegion *region,
+                                     jsProfileData *points);
+
+/**
+ * @brief Same as `jsProfilesGetLowestPoint`, operating on `jsRawProfile`
+ * formatted profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesGetLowestPoint(const jsRawProfile *profiles,
+                                    uint32_t num_profiles,
+                                    const jsRegion *region,
+                                    jsProfileData *points);
+
+/**
+ * @brief Same as `jsProfilesGetPointCount`, operating on `jsRawProfile`
+ * formatted profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesGetPointCount(const jsRawProfile *profiles,
+                                   uint32_t num_profiles,
+                                   const jsRegion *region, uint32_t *counts);
+
+/**
+ * @brief Same as `jsProfilesGetCentroid`, operating on `jsRawProfile`
+ * formatted profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesGetCentroid(const jsRawProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 double *centroid_x, double *centroid_y);
+
+/**
+ * @brief Same as `jsProfilesGetArea`, operating on `jsRawProfile` formatted
+ * profile data; invalid entries of the `data` array are skipped, the segments
+ * joining the valid entries on either side of them are used instead.
+ */
+EXPORTED
+int32_t jsRawProfilesGetArea(const jsRawProfile *profiles,
+                             uint32_t num_profiles, const jsRegion *region,
+                             double slope, double intercept, double *areas);
+
+/**
+ * @brief Fits a line to the points within a region for each profile of an
+ * array by least squares, minimizing the perpendicular distance of the
+ * points to the line so that vertical edges are fitted as well as horizontal
+ * ones. The points are processed in a single pass.
+ *
+ * @param profiles Array of profiles to fit lines to.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to consider points within.
+ * @param lines Array of `num_profiles` entries to be updated with the line of
+ * each profile. The segment spans the projections of the first and last
+ * points within the region onto the line. If a profile has fewer than two
+ * points within the region, the line is set invalid.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesFitLine(const jsProfile *profiles, uint32_t num_profiles,
+                          const jsRegion *region, jsLineSegment *lines);
+
+/**
+ * @brief Simplifies the points within a region to a sequence of line segments
+ * for each profile of an array, using split and merge. Each profile is split
+ * recursively until no point is farther than `tolerance` from the chord of its
+ * piece, then neighboring pieces are merged while a single least squares line
+ * keeps all their points within `tolerance`. The cost per profile is
+ * O(n * k) for `n` points and `k` pieces before merging.
+ *
+ * @param profiles Array of profiles to simplify.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to consider points within.
+ * @param tolerance The greatest distance of a point from its segment, in
+ * 1/1000 inches.
+ * @param segments Array of `num_profiles * max_segments` entries; the
+ * segments of profile `m` are written in profile order starting at entry
+ * `m * max_segments`. Neighboring segments share the point at which they
+ * were split.
+ * @param max_segments The greatest number of segments to write per profile.
+ * @param num_segments Array of `num_profiles` entries to be updated with the
+ * number of segments found for each profile. If greater than `max_segments`,
+ * only the first `max_segments` were written.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesFitSegments(const jsProfile *profiles,
+                              uint32_t num_profiles, const jsRegion *region,
+                              double tolerance, jsLineSegment *segments,
+                              uint32_t max_segments, uint32_t *num_segments);
+
+/**
+ * @brief Finds the dominant line among the points within a region for each
+ * profile of an array using random sample consensus (RANSAC). Each iteration
+ * tries the line through two randomly chosen points, keeping the one with the
+ * most points within `tolerance`; that line is then refit to those points by
+ * least squares. Unlike `jsProfilesFitLine`, points away from the line such
+ * as wane or debris do not affect the result. The cost per profile is
+ * O(n * iterations) for `n` points. The random sampling is seeded the same for
+ * every profile, so results are repeatable.
+ *
+ * @param profiles Array of profiles to search.
+ * @param num_profiles The number of profiles in the array.
+ * @param region The region to consider points within.
+ * @param tolerance The greatest distance of a point from a line for it to be
+ * considered part of the line, in 1/1000 inches.
+ * @param iterations The number of candidate lines to try per profile.
+ * @param lines Array of `num_profiles` entries to be updated with the line of
+ * each profile. The segment spans the projections of the first and last
+ * points that are part of the line. If no line could be found, it is set
+ * invalid.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesFindLine(const jsProfile *profiles, uint32_t num_profiles,
+                           const jsRegion *region, double tolerance,
+                           uint32_t iterations, jsLineSegment *lines);
+
+/**
+ * @brief Same as `jsProfilesFitLine`, operating on `jsRawProfile` formatted
+ * profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesFitLine(const jsRawProfile *profiles,
+                             uint32_t num_profiles, const jsRegion *region,
+                             jsLineSegment *lines);
+
+/**
+ * @brief Same as `jsProfilesFitSegments`, operating on `jsRawProfile`
+ * formatted profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesFitSegments(const jsRawProfile *profiles,
+                                 uint32_t num_profiles, const jsRegion *region,
+                                 double tolerance, jsLineSegment *segments,
+                                 uint32_t max_segments,
+                                 uint32_t *num_segments);
+
+/**
+ * @brief Same as `jsProfilesFindLine`, operating on `jsRawProfile` formatted
+ * profile data; invalid entries of the `data` array are skipped.
+ */
+EXPORTED
+int32_t jsRawProfilesFindLine(const jsRawProfile *profiles,
+                              uint32_t num_profiles, const jsRegion *region,
+                              double tolerance, uint32_t iterations,
+                              jsLineSegment *lines);
+
+/**
+ * @brief Calculates the cross-section geometry of each stitched profile of an
+ * array. The convex hull is built in linear time from the points, which are
+ * already ordered by X; the diameters are measured with rotating calipers
+ * around the hull and the ellipse is fitted to all points by least squares.
+ * The cost per profile is O(n) for `n` points.
+ *
+ * @param profiles Array of stitched profiles.
+ * @param num_profiles The number of profiles in the array.
+ * @param sections Array of `num_profiles` entries to be updated with the
+ * cross-section of each profile.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsStitchedProfilesGetCrossSection(const jsStitchedProfile *profiles,
+                                          uint32_t num_profiles,
+                                          jsCrossSection *sections);
+
+/**
+ * @brief Calculates the cross-section geometry of an array of profiles taken
+ * as a single frame, such as the profiles of all scan heads assembled by the
+ * application. Same as `jsStitchedProfilesGetCrossSection` except that the
+ * points must first be sorted, costing O(n log n) for `n` points.
+ *
+ * @param profiles Array of profiles making up the frame.
+ * @param num_profiles The number of profiles in the array.
+ * @param section Pointer to be updated with the cross-section of the frame.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesGetFrameCrossSection(const jsProfile *profiles,
+                                       uint32_t num_profiles,
+                                       jsCrossSection *section);
+
+/**
+ * @brief Resamples each profile of an array onto a grid of evenly spaced X
+ * coordinates. The points of a profile are taken in order along X, which is
+ * the order of the camera columns; a grid point is interpolated linearly
+ * between the points on either side of it and takes the brightness of the
+ * nearer one. Grid points beyond the ends of a profile or across a gap
+ * larger than `max_gap` are invalid, with `x` and `y` set to
+ * `JS_PROFILE_DATA_INVALID_XY`. Where X doubles back, a grid point is
+ * interpolated from the last point in order at or before it.
+ *
+ * @param profiles Array of profiles.
+ * @param num_profiles The number of profiles in the array.
+ * @param config The grid to resample onto.
+ * @param points Array of `num_profiles * num_points` entries to be updated
+ * with the grid points of each profile in turn.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsProfilesResample(const jsProfile *profiles, uint32_t num_profiles,
+                           const jsResampleConfig *config,
+                           jsProfileData *points);
+
+/**
+ * @brief Resamples each raw profile of an array onto a grid of evenly spaced
+ * X coordinates, see `jsProfilesResample`.
+ *
+ * @param profiles Array of raw profiles.
+ * @param num_profiles The number of profiles in the array.
+ * @param config The grid to resample onto.
+ * @param points Array of `num_profiles * num_points` entries to be updated
+ * with the grid points of each profile in turn.
+ * @return `0` on success, negative value mapping to `jsError` on error.
+ */
+EXPORTED
+int32_t jsRawProfilesResample(const jsRawProfile *profiles,
+                              uint32_t num_profiles,
+                              const jsResampleConfig *config,
+                              jsProfileData *points);
 
 #ifdef __cplusplus
 } // extern "C" {